@@ -33,6 +33,7 @@
 #include <itpp/base/math/misc.h>
 #include <itpp/base/factory.h>
 #include <itpp/base/copy_vector.h>
+#include <utility>
 
 
 namespace itpp
@@ -110,6 +111,10 @@ public:
   Array(int n, const Factory &f = DEFAULT_FACTORY);
   //! Copy constructor. An element factory \c f can be specified.
   Array(const Array<T> &a, const Factory &f = DEFAULT_FACTORY);
+#ifdef ITPP_HAVE_RVALUE_REFS
+  //! Move constructor. Takes over the elements of \c a, which is left empty
+  Array(Array<T> &&a);
+#endif
   //! Create an Array from string. An element factory \c f can be specified.
   Array(const std::string& values, const Factory &f = DEFAULT_FACTORY);
   //! Create an Array from char*. An element factory \c f can be specified.
@@ -138,6 +143,10 @@ public:
   Array<T>& operator=(const T &e);
   //! Assignment operator
   Array<T>& operator=(const Array<T> &a);
+#ifdef ITPP_HAVE_RVALUE_REFS
+  //! Assignment operator taking over the elements of \c a
+  Array<T>& operator=(Array<T> &&a);
+#endif
   //! Assignment operator
   Array<T>& operator=(const char* values);
 
@@ -231,6 +240,25 @@ Array<T>::Array(const Array<T> &a, const Factory &f)
     data[i] = a.data[i];
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+template<class T> inline
+Array<T>::Array(Array<T> &&a) : ndata(0), data(0), factory(DEFAULT_FACTORY)
+{
+  // As the copy constructor, the new Array uses the default factory
+  if (&a.factory == &DEFAULT_FACTORY) {
+    ndata = a.ndata;
+    data = a.data;
+    a.ndata = 0;
+    a.data = 0;
+  }
+  else {
+    alloc(a.ndata);
+    for (int i = 0; i < a.ndata; i++)
+      data[i] = std::move(a.data[i]);
+  }
+}
+#endif
+
 template<class T> inline
 Array<T>::Array(const std::string& values, const Factory &f)
     : ndata(0), data(0), factory(f)
@@ -270,7 +298,11 @@ void Array<T>::set_size(int size, bool copy)
     alloc(size);
     // copy old elements into a new memory region
     for (int i = 0; i < min; ++i) {
+#ifdef ITPP_HAVE_RVALUE_REFS
+      data[i] = std::move(tmp[i]);
+#else
       data[i] = tmp[i];
+#endif
     }
     // initialize the rest of resized array
     for (int i = min; i < size; ++i) {
@@ -334,6 +366,28 @@ Array<T>& Array<T>::operator=(const Array<T> &a)
   return *this;
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+template<class T> inline
+Array<T>& Array<T>::operator=(Array<T> &&a)
+{
+  if (this != &a) {
+    if (&factory == &a.factory) {
+      free();
+      ndata = a.ndata;
+      data = a.data;
+      a.ndata = 0;
+      a.data = 0;
+    }
+    else {
+      set_size(a.ndata);
+      for (int i = 0; i < ndata; i++)
+        data[i] = std::move(a.data[i]);
+    }
+  }
+  return *this;
+}
+#endif
+
 template<class T> inline
 Array<T>& Array<T>::operator=(const T &e)
 {
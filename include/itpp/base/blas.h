@@ -54,6 +54,7 @@
 #  define dger_  DGER
 #  define zgeru_ ZGERU
 #  define zgerc_ ZGERC
+#  define sgemm_ SGEMM
 #  define dgemm_ DGEMM
 #  define zgemm_ ZGEMM
 #endif // #if defined(_MSC_VER) && (defined(HAVE_ACML) || defined(HAVE_MKL))
@@ -149,6 +150,14 @@ extern "C"
   // BLAS 3 functions
   // ----------------------------------------------------------------------
 
+  void sgemm_(const char *transA, const char *transB,
+              const int *m, const int *n, const int *k,
+              const float *alpha,
+              const float *A, const int *ldA,
+              const float *B, const int *ldB,
+              const float *beta,
+              float *C, const int *ldC);
+
   void dgemm_(const char *transA, const char *transB,
               const int *m, const int *n, const int *k,
               const double *alpha,
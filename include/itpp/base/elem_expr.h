@@ -0,0 +1,578 @@
+/*!
+ * \file
+ * \brief Lazy evaluation of elementwise vector and matrix expressions
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef ELEM_EXPR_H
+#define ELEM_EXPR_H
+
+#include <itpp/base/vec.h>
+#include <itpp/base/mat.h>
+// The functions on vectors come first, so that their unqualified calls to
+// the scalar versions are not hidden by the overloads below
+#include <itpp/base/math/elem_math.h>
+#include <itpp/base/math/log_exp.h>
+#include <itpp/base/math/trig_hyp.h>
+#include <itpp/base/math/vmath.h>
+#include <cmath>
+#include <complex>
+
+
+namespace itpp
+{
+
+/*!
+  \ingroup arr_vec_mat
+  \brief Base class of the lazily evaluated elementwise expressions
+
+  The usual Vec and Mat operators evaluate every operation into a new
+  temporary, so that e.g. \c exp(-a2 * sqr(y) / 2) goes three times through
+  memory. Wrapping the operands with lazy() instead builds an expression
+  object, which is evaluated in a single loop when it is assigned to a Vec
+  or a Mat, passed to their (explicit) constructors, or reduced with sum():
+
+  \code
+  vec y, g;
+  g = exp(-a2 * sqr(lazy(y)) / 2);
+  mat M(elem_mult(lazy(A), lazy(B)) + 1.0);
+  w = (lazy(gw) - beta * lazy(w)) / n;    // the target may be an operand
+  double s = sum(elem_mult(lazy(c), cos(lazy(f) * t + lazy(th))));
+  \endcode
+
+  The expressions support the elementwise operators +, - (also unary), *
+  and / between expressions of the same shape or with a scalar,
+  elem_mult(), elem_div(), abs(), sqr(), sqrt(), exp(), log(), pow() with a
+  scalar exponent, sin(), cos() and tanh(). Matrix products are not
+  elementwise and are not available. An expression keeps pointers to the
+  data of the wrapped vectors and matrices, which must not be resized before
+  it is evaluated.
+
+  An expression with exp(), log(), sin(), cos() or tanh() is evaluated in
+  blocks of elem_expr_block elements instead, so that these functions use
+  the same vectorized kernels (see vmath_exp()) as on vectors and matrices
+  of doubles, and exp() also on complex doubles. The other operations loop
+  over the blocks, which stay in the cache.
+*/
+template<class E>
+class Elem_Expr
+{
+public:
+  //! The expression as its actual type
+  const E &self() const { return static_cast<const E &>(*this); }
+  //! Non-zero if the expression is evaluated in blocks
+  enum { vectorized = 0 };
+  //! Evaluate the \c n elements from \c i into \c out, or return where they are stored
+  template<class T> const T *eval(int i, int n, T *out) const {
+    for (int k = 0; k < n; k++)
+      out[k] = self()[i + k];
+    return out;
+  }
+};
+
+//! Number of elements of the blocks in which the expressions are evaluated
+const int elem_expr_block = 256;
+
+//! \cond
+
+// Result type of an elementwise operation on type T
+template<class T> struct Elem_Same_Type { typedef T type; };
+template<class T> struct Elem_Real_Type { typedef T type; };
+template<class T> struct Elem_Real_Type<std::complex<T> > { typedef T type; };
+
+// Leaf referring to the elements of a Vec or a Mat
+template<class Num_T>
+class Elem_Ref : public Elem_Expr<Elem_Ref<Num_T> >
+{
+public:
+  typedef Num_T value_type;
+  Elem_Ref(const Num_T *d, int r, int c) : data(d), no_rows(r), no_cols(c) {}
+  Num_T operator[](int i) const { return data[i]; }
+  int rows() const { return no_rows; }
+  int cols() const { return no_cols; }
+  const Num_T *eval(int i, int, Num_T *) const { return data + i; }
+private:
+  const Num_T *data;
+  int no_rows, no_cols;
+};
+
+// Op(lhs, rhs) element by element. Nodes are small and are held by value.
+template<class L, class R, class Op>
+class Elem_Binary : public Elem_Expr<Elem_Binary<L, R, Op> >
+{
+public:
+  typedef typename L::value_type value_type;
+  Elem_Binary(const L &l, const R &r) : lhs(l), rhs(r) {
+    it_assert_debug((l.rows() == r.rows()) && (l.cols() == r.cols()),
+                    "Elem_Binary: Wrong sizes");
+  }
+  value_type operator[](int i) const { return Op::apply(lhs[i], rhs[i]); }
+  int rows() const { return lhs.rows(); }
+  int cols() const { return lhs.cols(); }
+  enum { vectorized = L::vectorized || R::vectorized };
+  const value_type *eval(int i, int n, value_type *out) const {
+    if (!vectorized) {
+      for (int k = 0; k < n; k++)
+        out[k] = Op::apply(lhs[i + k], rhs[i + k]);
+      return out;
+    }
+    value_type a[elem_expr_block];
+    typename R::value_type b[elem_expr_block];
+    const value_type *pa = lhs.eval(i, n, a);
+    const typename R::value_type *pb = rhs.eval(i, n, b);
+    for (int k = 0; k < n; k++)
+      out[k] = Op::apply(pa[k], pb[k]);
+    return out;
+  }
+private:
+  L lhs;
+  R rhs;
+};
+
+// Op(expr, t) element by element
+template<class E, class Op>
+class Elem_Scalar_Right : public Elem_Expr<Elem_Scalar_Right<E, Op> >
+{
+public:
+  typedef typename E::value_type value_type;
+  Elem_Scalar_Right(const E &e, value_type s) : expr(e), t(s) {}
+  value_type operator[](int i) const { return Op::apply(expr[i], t); }
+  int rows() const { return expr.rows(); }
+  int cols() const { return expr.cols(); }
+  enum { vectorized = E::vectorized };
+  const value_type *eval(int i, int n, value_type *out) const {
+    const value_type *p = expr.eval(i, n, out);
+    for (int k = 0; k < n; k++)
+      out[k] = Op::apply(p[k], t);
+    return out;
+  }
+private:
+  E expr;
+  value_type t;
+};
+
+// Op(t, expr) element by element
+template<class E, class Op>
+class Elem_Scalar_Left : public Elem_Expr<Elem_Scalar_Left<E, Op> >
+{
+public:
+  typedef typename E::value_type value_type;
+  Elem_Scalar_Left(value_type s, const E &e) : t(s), expr(e) {}
+  value_type operator[](int i) const { return Op::apply(t, expr[i]); }
+  int rows() const { return expr.rows(); }
+  int cols() const { return expr.cols(); }
+  enum { vectorized = E::vectorized };
+  const value_type *eval(int i, int n, value_type *out) const {
+    const value_type *p = expr.eval(i, n, out);
+    for (int k = 0; k < n; k++)
+      out[k] = Op::apply(t, p[k]);
+    return out;
+  }
+private:
+  value_type t;
+  E expr;
+};
+
+// Op applied to a block, by the vectorized kernel of Op if it has one
+template<bool Kernel> struct Elem_Apply_Block
+{
+  template<class Op, class T, class U> static void apply(const T *a, U *y, int n) {
+    for (int k = 0; k < n; k++)
+      y[k] = Op::apply(a[k]);
+  }
+};
+template<> struct Elem_Apply_Block<true>
+{
+  template<class Op, class T, class U> static void apply(const T *a, U *y, int n) {
+    Op::apply_block(a, y, n);
+  }
+};
+
+// Op(expr) element by element
+template<class E, class Op>
+class Elem_Unary : public Elem_Expr<Elem_Unary<E, Op> >
+{
+public:
+  typedef typename Op::template result<typename E::value_type>::type value_type;
+  Elem_Unary(const E &e) : expr(e) {}
+  value_type operator[](int i) const { return Op::apply(expr[i]); }
+  int rows() const { return expr.rows(); }
+  int cols() const { return expr.cols(); }
+  enum { vectorized = E::vectorized || Op::vectorized };
+  const value_type *eval(int i, int n, value_type *out) const {
+    typename E::value_type a[elem_expr_block];
+    const typename E::value_type *p = expr.eval(i, n, a);
+    Elem_Apply_Block<Op::vectorized != 0>::template apply<Op>(p, out, n);
+    return out;
+  }
+private:
+  E expr;
+};
+
+// Elementwise operations, with the same expressions as the operators on
+// Vec and Mat so that the results are the same
+struct Elem_Add { template<class T> static T apply(const T &a, const T &b) { return a + b; } };
+struct Elem_Sub { template<class T> static T apply(const T &a, const T &b) { return a - b; } };
+struct Elem_Mul { template<class T> static T apply(const T &a, const T &b) { return a * b; } };
+struct Elem_Div { template<class T> static T apply(const T &a, const T &b) { return a / b; } };
+struct Elem_Pow { template<class T> static T apply(const T &a, const T &b) { return std::pow(a, b); } };
+
+// Vectorized operation, whose apply_block() overloads for real and
+// complex doubles call the kernels of the functions on Vec and Mat
+template<class Op>
+struct Elem_Kernel_Op
+{
+  enum { vectorized = 1 };
+  template<class T> static void apply_block(const T *a, T *y, int n) {
+    for (int k = 0; k < n; k++)
+      y[k] = Op::apply(a[k]);
+  }
+};
+
+struct Elem_Neg
+{
+  enum { vectorized = 0 };
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return -a; }
+};
+struct Elem_Exp : Elem_Kernel_Op<Elem_Exp>
+{
+  using Elem_Kernel_Op<Elem_Exp>::apply_block;
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::exp(a); }
+  static void apply_block(const double *a, double *y, int n) { vmath_exp(a, y, n); }
+  static void apply_block(const std::complex<double> *a, std::complex<double> *y, int n) { vmath_exp(a, y, n); }
+};
+struct Elem_Log : Elem_Kernel_Op<Elem_Log>
+{
+  using Elem_Kernel_Op<Elem_Log>::apply_block;
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::log(a); }
+  static void apply_block(const double *a, double *y, int n) { vmath_log(a, y, n); }
+};
+struct Elem_Sqrt
+{
+  enum { vectorized = 0 };
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::sqrt(a); }
+};
+struct Elem_Sin : Elem_Kernel_Op<Elem_Sin>
+{
+  using Elem_Kernel_Op<Elem_Sin>::apply_block;
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::sin(a); }
+  static void apply_block(const double *a, double *y, int n) { vmath_sin(a, y, n); }
+};
+struct Elem_Cos : Elem_Kernel_Op<Elem_Cos>
+{
+  using Elem_Kernel_Op<Elem_Cos>::apply_block;
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::cos(a); }
+  static void apply_block(const double *a, double *y, int n) { vmath_cos(a, y, n); }
+};
+struct Elem_Tanh : Elem_Kernel_Op<Elem_Tanh>
+{
+  using Elem_Kernel_Op<Elem_Tanh>::apply_block;
+  template<class T> struct result : Elem_Same_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::tanh(a); }
+  static void apply_block(const double *a, double *y, int n) { vmath_tanh(a, y, n); }
+};
+// As sqr() and abs() on vectors, real valued for complex elements
+struct Elem_Sqr
+{
+  enum { vectorized = 0 };
+  template<class T> struct result : Elem_Real_Type<T> {};
+  template<class T> static T apply(const T &a) { return a * a; }
+  template<class T> static T apply(const std::complex<T> &a) { return std::norm(a); }
+};
+struct Elem_Abs
+{
+  enum { vectorized = 0 };
+  template<class T> struct result : Elem_Real_Type<T> {};
+  template<class T> static T apply(const T &a) { return std::abs(a); }
+  template<class T> static T apply(const std::complex<T> &a) { return std::abs(a); }
+};
+
+//! \endcond
+
+//! Wrap the vector \c v into an elementwise expression
+template<class Num_T> inline
+Elem_Ref<Num_T> lazy(const Vec<Num_T> &v)
+{
+  return Elem_Ref<Num_T>(v._data(), v.size(), 1);
+}
+
+//! Wrap the matrix \c m into an elementwise expression
+template<class Num_T> inline
+Elem_Ref<Num_T> lazy(const Mat<Num_T> &m)
+{
+  return Elem_Ref<Num_T>(m._data(), m.rows(), m.cols());
+}
+
+//! Addition of two expressions
+template<class L, class R> inline
+Elem_Binary<L, R, Elem_Add> operator+(const Elem_Expr<L> &l, const Elem_Expr<R> &r)
+{
+  return Elem_Binary<L, R, Elem_Add>(l.self(), r.self());
+}
+
+//! Addition of an expression and a scalar
+template<class E> inline
+Elem_Scalar_Right<E, Elem_Add> operator+(const Elem_Expr<E> &e, typename E::value_type t)
+{
+  return Elem_Scalar_Right<E, Elem_Add>(e.self(), t);
+}
+
+//! Addition of a scalar and an expression
+template<class E> inline
+Elem_Scalar_Left<E, Elem_Add> operator+(typename E::value_type t, const Elem_Expr<E> &e)
+{
+  return Elem_Scalar_Left<E, Elem_Add>(t, e.self());
+}
+
+//! Subtraction of two expressions
+template<class L, class R> inline
+Elem_Binary<L, R, Elem_Sub> operator-(const Elem_Expr<L> &l, const Elem_Expr<R> &r)
+{
+  return Elem_Binary<L, R, Elem_Sub>(l.self(), r.self());
+}
+
+//! Subtraction of a scalar from an expression
+template<class E> inline
+Elem_Scalar_Right<E, Elem_Sub> operator-(const Elem_Expr<E> &e, typename E::value_type t)
+{
+  return Elem_Scalar_Right<E, Elem_Sub>(e.self(), t);
+}
+
+//! Subtraction of an expression from a scalar
+template<class E> inline
+Elem_Scalar_Left<E, Elem_Sub> operator-(typename E::value_type t, const Elem_Expr<E> &e)
+{
+  return Elem_Scalar_Left<E, Elem_Sub>(t, e.self());
+}
+
+//! Negation of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Neg> operator-(const Elem_Expr<E> &e)
+{
+  return Elem_Unary<E, Elem_Neg>(e.self());
+}
+
+//! Multiplication of an expression and a scalar
+template<class E> inline
+Elem_Scalar_Right<E, Elem_Mul> operator*(const Elem_Expr<E> &e, typename E::value_type t)
+{
+  return Elem_Scalar_Right<E, Elem_Mul>(e.self(), t);
+}
+
+//! Multiplication of a scalar and an expression
+template<class E> inline
+Elem_Scalar_Left<E, Elem_Mul> operator*(typename E::value_type t, const Elem_Expr<E> &e)
+{
+  return Elem_Scalar_Left<E, Elem_Mul>(t, e.self());
+}
+
+//! Division of an expression by a scalar
+template<class E> inline
+Elem_Scalar_Right<E, Elem_Div> operator/(const Elem_Expr<E> &e, typename E::value_type t)
+{
+  return Elem_Scalar_Right<E, Elem_Div>(e.self(), t);
+}
+
+//! Division of a scalar by an expression
+template<class E> inline
+Elem_Scalar_Left<E, Elem_Div> operator/(typename E::value_type t, const Elem_Expr<E> &e)
+{
+  return Elem_Scalar_Left<E, Elem_Div>(t, e.self());
+}
+
+//! Element wise multiplication of two expressions
+template<class L, class R> inline
+Elem_Binary<L, R, Elem_Mul> elem_mult(const Elem_Expr<L> &l, const Elem_Expr<R> &r)
+{
+  return Elem_Binary<L, R, Elem_Mul>(l.self(), r.self());
+}
+
+//! Element wise division of two expressions
+template<class L, class R> inline
+Elem_Binary<L, R, Elem_Div> elem_div(const Elem_Expr<L> &l, const Elem_Expr<R> &r)
+{
+  return Elem_Binary<L, R, Elem_Div>(l.self(), r.self());
+}
+
+//! Elements of an expression raised to the power \c t
+template<class E> inline
+Elem_Scalar_Right<E, Elem_Pow> pow(const Elem_Expr<E> &e, typename E::value_type t)
+{
+  return Elem_Scalar_Right<E, Elem_Pow>(e.self(), t);
+}
+
+//! Absolute values of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Abs> abs(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Abs>(e.self()); }
+
+//! Squares of the elements of an expression, squared magnitudes if complex
+template<class E> inline
+Elem_Unary<E, Elem_Sqr> sqr(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Sqr>(e.self()); }
+
+//! Square roots of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Sqrt> sqrt(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Sqrt>(e.self()); }
+
+//! Exponentials of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Exp> exp(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Exp>(e.self()); }
+
+//! Natural logarithms of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Log> log(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Log>(e.self()); }
+
+//! Sines of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Sin> sin(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Sin>(e.self()); }
+
+//! Cosines of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Cos> cos(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Cos>(e.self()); }
+
+//! Hyperbolic tangents of the elements of an expression
+template<class E> inline
+Elem_Unary<E, Elem_Tanh> tanh(const Elem_Expr<E> &e) { return Elem_Unary<E, Elem_Tanh>(e.self()); }
+
+//! Sum of the elements of an expression, without evaluating it into a vector
+template<class E> inline
+typename E::value_type sum(const Elem_Expr<E> &e)
+{
+  const E &x = e.self();
+  int n = x.rows() * x.cols();
+  typename E::value_type s = typename E::value_type(0);
+  if (!E::vectorized) {
+    for (int i = 0; i < n; i++)
+      s += x[i];
+    return s;
+  }
+  typename E::value_type b[elem_expr_block];
+  for (int i = 0; i < n; i += elem_expr_block) {
+    int m = (n - i < elem_expr_block) ? n - i : elem_expr_block;
+    const typename E::value_type *p = x.eval(i, m, b);
+    for (int k = 0; k < m; k++)
+      s += p[k];
+  }
+  return s;
+}
+
+// ----------------------------------------------------------------------
+// Evaluation into Vec and Mat
+// ----------------------------------------------------------------------
+
+//! \cond
+
+// Evaluate the block of m elements from i of a vectorized expression into
+// data, directly if the expression has the type of the elements of data
+template<class Num_T, class E, class T> inline
+void elem_expr_eval_block(const E &x, int i, int m, Num_T *data, const T *)
+{
+  T b[elem_expr_block];
+  const T *p = x.eval(i, m, b);
+  for (int k = 0; k < m; k++)
+    data[i + k] = p[k];
+}
+template<class T, class E> inline
+void elem_expr_eval_block(const E &x, int i, int m, T *data, const T *)
+{
+  const T *p = x.eval(i, m, data + i);
+  if (p != data + i) {
+    for (int k = 0; k < m; k++)
+      data[i + k] = p[k];
+  }
+}
+
+// Evaluate x into data. The destination may be one of the operands, as
+// every element is read before it is written. The nodes of a vectorized
+// expression only write the block of the destination in an elementwise
+// last step, or after reading their operands into buffers.
+template<class Num_T, class E> inline
+void elem_expr_eval(const E &x, Num_T *data, int n)
+{
+  if (!E::vectorized) {
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+  #pragma omp simd
+#endif
+    for (int i = 0; i < n; i++)
+      data[i] = x[i];
+    return;
+  }
+  const typename E::value_type *type = 0;
+  for (int i = 0; i < n; i += elem_expr_block) {
+    int m = (n - i < elem_expr_block) ? n - i : elem_expr_block;
+    elem_expr_eval_block(x, i, m, data, type);
+  }
+}
+
+//! \endcond
+
+template<class Num_T>
+template<class E>
+Vec<Num_T>::Vec(const Elem_Expr<E> &e, const Factory &f) : datasize(0), data(0), factory(f)
+{
+  const E &x = e.self();
+  it_assert((x.rows() == 1) || (x.cols() == 1), "Vec<>::Vec(): Expression is not a vector");
+  alloc(x.rows() * x.cols());
+  elem_expr_eval(x, data, datasize);
+}
+
+template<class Num_T>
+template<class E>
+Vec<Num_T>& Vec<Num_T>::operator=(const Elem_Expr<E> &e)
+{
+  const E &x = e.self();
+  it_assert((x.rows() == 1) || (x.cols() == 1), "Vec<>::operator=(): Expression is not a vector");
+  set_size(x.rows() * x.cols(), false);
+  elem_expr_eval(x, data, datasize);
+  return *this;
+}
+
+template<class Num_T>
+template<class E>
+Mat<Num_T>::Mat(const Elem_Expr<E> &e, const Factory &f) :
+    datasize(0), no_rows(0), no_cols(0), data(0), factory(f)
+{
+  const E &x = e.self();
+  alloc(x.rows(), x.cols());
+  elem_expr_eval(x, data, datasize);
+}
+
+template<class Num_T>
+template<class E>
+Mat<Num_T>& Mat<Num_T>::operator=(const Elem_Expr<E> &e)
+{
+  const E &x = e.self();
+  set_size(x.rows(), x.cols(), false);
+  elem_expr_eval(x, data, datasize);
+  return *this;
+}
+
+} // namespace itpp
+
+#endif // #ifndef ELEM_EXPR_H
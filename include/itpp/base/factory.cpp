@@ -0,0 +1,399 @@
+/*!
+ * \file
+ * \brief Allocators of the element storage of Array, Vec and Mat
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/base/factory.h>
+#include <new>
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+// Thread-local storage of plain pointers
+#if defined(__GNUC__)
+#  define FACTORY_TLS __thread
+#elif defined(_MSC_VER)
+#  define FACTORY_TLS __declspec(thread)
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+// ----------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------
+
+static std::size_t align_up(std::size_t n)
+{
+  return (n + (ITPP_ALIGNMENT - 1)) & ~std::size_t(ITPP_ALIGNMENT - 1);
+}
+
+// Storage aligned on ITPP_ALIGNMENT bytes. raw is the pointer to delete.
+static char *heap_aligned(std::size_t bytes, void* &raw)
+{
+  raw = operator new(bytes + ITPP_ALIGNMENT - 1);
+  return reinterpret_cast<char *>(align_up(reinterpret_cast<std::size_t>(raw)));
+}
+
+// Counters shared with the threads destroying arena blocks
+static long atomic_add(volatile long &v, long d)
+{
+#if defined(__GNUC__)
+  return __sync_add_and_fetch(&v, d);
+#elif defined(_MSC_VER)
+  return _InterlockedExchangeAdd(&v, d) + d;
+#else
+  return v += d;
+#endif
+}
+
+// ----------------------------------------------------------------------
+// Heap allocator
+// ----------------------------------------------------------------------
+
+class Heap_Allocator : public Allocator
+{
+public:
+  virtual void *allocate(std::size_t bytes, void* &cookie) {
+    return heap_aligned(bytes, cookie);
+  }
+  virtual void deallocate(void *, std::size_t, void *cookie) {
+    operator delete(cookie);
+  }
+};
+
+// ----------------------------------------------------------------------
+// Pool allocator
+// ----------------------------------------------------------------------
+
+// Size classes of 128 bytes to 1 MiB. A thread keeps at most about 1 MiB
+// of free blocks of each class, and no more than 32 blocks.
+static const int pool_classes = 14;
+static const int pool_min_shift = 7;
+
+static int pool_class(std::size_t bytes)
+{
+  int c = 0;
+  while ((c < pool_classes) && ((std::size_t(1) << (pool_min_shift + c)) < bytes))
+    c++;
+  return c;
+}
+
+static int pool_limit(int c)
+{
+  int n = 1 << (20 - pool_min_shift - c);
+  return (n > 32) ? 32 : ((n < 2) ? 2 : n);
+}
+
+// Free blocks of a thread. A free block holds the next free block of its
+// class and the pointer to delete.
+struct Pool_Cache
+{
+  void *head[pool_classes];
+  int count[pool_classes];
+};
+
+static void pool_flush(Pool_Cache *cache)
+{
+  for (int c = 0; c < pool_classes; c++) {
+    while (cache->head[c]) {
+      void **b = reinterpret_cast<void **>(cache->head[c]);
+      cache->head[c] = b[0];
+      operator delete(b[1]);
+    }
+    cache->count[c] = 0;
+  }
+}
+
+#if defined(FACTORY_TLS)
+static FACTORY_TLS Pool_Cache *pool_cache_ptr = 0;
+
+#if (__cplusplus >= 201103L)
+// Gives the free blocks of a thread back to the heap when it exits
+struct Pool_Cache_Guard
+{
+  ~Pool_Cache_Guard() {
+    if (pool_cache_ptr) {
+      pool_flush(pool_cache_ptr);
+      delete pool_cache_ptr;
+      pool_cache_ptr = 0;
+    }
+  }
+};
+static thread_local Pool_Cache_Guard pool_cache_guard;
+#endif
+
+static Pool_Cache *pool_cache()
+{
+  if (!pool_cache_ptr) {
+#if (__cplusplus >= 201103L)
+    (void) &pool_cache_guard;
+#endif
+    pool_cache_ptr = new Pool_Cache;
+    for (int c = 0; c < pool_classes; c++) {
+      pool_cache_ptr->head[c] = 0;
+      pool_cache_ptr->count[c] = 0;
+    }
+  }
+  return pool_cache_ptr;
+}
+#else
+// Without thread-local storage the blocks are not cached
+static Pool_Cache *pool_cache() { return 0; }
+#endif
+
+class Pool_Allocator : public Allocator
+{
+public:
+  virtual void *allocate(std::size_t bytes, void* &cookie) {
+    int c = pool_class(bytes);
+    if (c == pool_classes)
+      return heap_aligned(bytes, cookie);
+    Pool_Cache *cache = pool_cache();
+    if (cache && cache->head[c]) {
+      void **b = reinterpret_cast<void **>(cache->head[c]);
+      cache->head[c] = b[0];
+      cache->count[c]--;
+      cookie = b[1];
+      return b;
+    }
+    return heap_aligned(std::size_t(1) << (pool_min_shift + c), cookie);
+  }
+  virtual void deallocate(void *p, std::size_t bytes, void *cookie) {
+    int c = pool_class(bytes);
+    Pool_Cache *cache = (c < pool_classes) ? pool_cache() : 0;
+    if (cache && (cache->count[c] < pool_limit(c))) {
+      void **b = reinterpret_cast<void **>(p);
+      b[0] = cache->head[c];
+      b[1] = cookie;
+      cache->head[c] = p;
+      cache->count[c]++;
+    }
+    else {
+      operator delete(cookie);
+    }
+  }
+};
+
+// ----------------------------------------------------------------------
+// Allocator selection
+// ----------------------------------------------------------------------
+
+// The allocators are never destroyed, as Vec and Mat objects with static
+// storage duration may give their blocks back after the end of main()
+Allocator &heap_allocator()
+{
+  static Allocator *a = new Heap_Allocator;
+  return *a;
+}
+
+Allocator &pool_allocator()
+{
+  static Allocator *a = new Pool_Allocator;
+  return *a;
+}
+
+static Allocator *default_alloc = 0;
+
+Allocator &default_allocator()
+{
+  return default_alloc ? *default_alloc : heap_allocator();
+}
+
+void set_default_allocator(Allocator &a)
+{
+  default_alloc = &a;
+}
+
+#if defined(FACTORY_TLS)
+static FACTORY_TLS Allocator *scoped_alloc = 0;
+#else
+static Allocator *scoped_alloc = 0;
+#endif
+
+// A block is preceded by ITPP_ALIGNMENT bytes ending with its header
+struct Block_Header
+{
+  Allocator *source;
+  void *cookie;
+  std::size_t bytes;
+};
+
+void *allocate_elements(std::size_t n, const Factory &f)
+{
+  Allocator *a = f.allocator();
+  if (!a) a = scoped_alloc;
+  if (!a) a = &default_allocator();
+  std::size_t bytes = n + ITPP_ALIGNMENT;
+  void *cookie = 0;
+  char *p = reinterpret_cast<char *>(a->allocate(bytes, cookie)) + ITPP_ALIGNMENT;
+  Block_Header *h = reinterpret_cast<Block_Header *>(p) - 1;
+  h->source = a;
+  h->cookie = cookie;
+  h->bytes = bytes;
+  return p;
+}
+
+void deallocate_elements(void *p)
+{
+  Block_Header *h = reinterpret_cast<Block_Header *>(p) - 1;
+  h->source->deallocate(reinterpret_cast<char *>(p) - ITPP_ALIGNMENT, h->bytes, h->cookie);
+}
+
+// ----------------------------------------------------------------------
+// Arena
+// ----------------------------------------------------------------------
+
+// Chunk header, followed by the blocks. live counts the blocks in use,
+// plus one while the chunk belongs to the arena.
+struct Arena::Chunk
+{
+  Chunk *next;
+  void *raw;
+  std::size_t size;
+  std::size_t used;
+  volatile long live;
+};
+
+void Arena::release_chunk(Chunk *c)
+{
+  if (atomic_add(c->live, -1) == 0)
+    operator delete(c->raw);
+}
+
+Arena::Arena(std::size_t chunk_bytes) :
+    chunks(0), current(0), chunk_size(align_up(chunk_bytes))
+{
+}
+
+Arena::~Arena()
+{
+  while (chunks) {
+    Chunk *c = chunks;
+    chunks = c->next;
+    release_chunk(c);
+  }
+}
+
+Arena::Chunk *Arena::new_chunk(std::size_t bytes)
+{
+  void *raw;
+  Chunk *c = reinterpret_cast<Chunk *>(heap_aligned(align_up(sizeof(Chunk)) + bytes, raw));
+  c->next = 0;
+  c->raw = raw;
+  c->size = bytes;
+  c->used = 0;
+  c->live = 1;
+  return c;
+}
+
+void *Arena::allocate(std::size_t bytes, void* &cookie)
+{
+  bytes = align_up(bytes);
+  Chunk *c;
+  if (bytes > chunk_size) {
+    // Large blocks get a chunk of their own, after the current one
+    c = new_chunk(bytes);
+    if (current) {
+      c->next = current->next;
+      current->next = c;
+    }
+    else {
+      c->next = chunks;
+      chunks = c;
+    }
+  }
+  else {
+    // The chunks after the current one are empty since the last reset
+    while (current && (current->used + bytes > current->size))
+      current = current->next;
+    if (!current) {
+      current = new_chunk(chunk_size);
+      Chunk **link = &chunks;
+      while (*link) link = &(*link)->next;
+      *link = current;
+    }
+    c = current;
+  }
+  char *p = reinterpret_cast<char *>(c) + align_up(sizeof(Chunk)) + c->used;
+  c->used += bytes;
+  atomic_add(c->live, 1);
+  cookie = c;
+  return p;
+}
+
+void Arena::deallocate(void *, std::size_t, void *cookie)
+{
+  release_chunk(reinterpret_cast<Chunk *>(cookie));
+}
+
+void Arena::reset()
+{
+  // Chunks with blocks still in use are left to them, and the chunks of
+  // large blocks are freed since they would not be reused
+  Chunk **link = &chunks;
+  while (*link) {
+    Chunk *c = *link;
+    if ((c->live == 1) && (c->size <= chunk_size)) {
+      c->used = 0;
+      link = &c->next;
+    }
+    else {
+      *link = c->next;
+      release_chunk(c);
+    }
+  }
+  current = chunks;
+}
+
+std::size_t Arena::capacity() const
+{
+  std::size_t n = 0;
+  for (Chunk *c = chunks; c; c = c->next)
+    n += align_up(sizeof(Chunk)) + c->size;
+  return n;
+}
+
+// ----------------------------------------------------------------------
+// Arena_Scope
+// ----------------------------------------------------------------------
+
+Arena_Scope::Arena_Scope(Arena &a) : arena(a), previous(scoped_alloc)
+{
+  scoped_alloc = &arena;
+}
+
+Arena_Scope::~Arena_Scope()
+{
+  scoped_alloc = previous;
+  arena.reset();
+}
+
+} // namespace itpp
+
+//! \endcond
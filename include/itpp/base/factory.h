@@ -30,13 +30,30 @@
 #define FACTORY_H
 
 #include <complex>
+#include <cstddef>
 #include <itpp/base/binary.h>
 #include <itpp/itexports.h>
 
+//! \cond
+// Move constructors and assignments, and operators reusing the storage of
+// temporaries, need rvalue references
+#if !defined(ITPP_HAVE_RVALUE_REFS) && ((__cplusplus >= 201103L) || (defined(_MSC_VER) && (_MSC_VER >= 1600)))
+#  define ITPP_HAVE_RVALUE_REFS
+#endif
+//! \endcond
+
+/*!
+  \brief Alignment in bytes of the elements of numeric Array, Vec and Mat
+
+  A cache line, which is also enough for AVX-512 aligned loads and stores.
+*/
+#define ITPP_ALIGNMENT 64
+
 namespace itpp
 {
 
 // Forward declarations
+class Allocator;
 template<class T> class Array;
 template<class Num_T> class Mat;
 template<class Num_T> class Vec;
@@ -125,6 +142,11 @@ template<class Num_T> class Vec;
   \endcode
 
   For a more interesting example, see Fix_Factory.
+
+  A factory also selects the Allocator providing the storage of numeric
+  elements (see Allocator_Factory). By default the storage comes from the
+  allocator of the current Arena_Scope, if any, and otherwise from
+  default_allocator().
 */
 class ITPP_EXPORT Factory
 {
@@ -133,12 +155,171 @@ public:
   Factory() {}
   //! Destructor
   virtual ~Factory() {}
+  //! Allocator of the element storage, or 0 to use the current one
+  virtual Allocator *allocator() const { return 0; }
 };
 
 //! Default (dummy) factory
 const Factory DEFAULT_FACTORY;
 
 
+/*!
+  \brief Base class for the allocators of element storage
+
+  The storage of numeric Array, Vec and Mat elements (bin, unsigned char,
+  short, int, double and complex<double>) is obtained from an Allocator and
+  is aligned on ITPP_ALIGNMENT bytes. Every block remembers the allocator
+  it came from, so that it is given back to it whichever thread destroys
+  it, even if another allocator is current by then.
+
+  The allocator used for a new block is the one of the factory, if any (see
+  Allocator_Factory), then the one installed for the calling thread by an
+  Arena_Scope, and otherwise default_allocator(), which is
+  heap_allocator() unless changed with set_default_allocator().
+
+  Derived classes implement allocate() and deallocate(). Both may be called
+  from several threads at the same time, except for an Arena.
+*/
+class ITPP_EXPORT Allocator
+{
+public:
+  //! Destructor
+  virtual ~Allocator() {}
+  /*!
+    \brief Allocate \c bytes bytes aligned on ITPP_ALIGNMENT bytes
+
+    \c cookie may be set to any value, which is given back to deallocate().
+  */
+  virtual void *allocate(std::size_t bytes, void* &cookie) = 0;
+  //! Give back a block returned by allocate(\c bytes, \c cookie)
+  virtual void deallocate(void *p, std::size_t bytes, void *cookie) = 0;
+};
+
+/*!
+  \brief Aligned blocks from the global heap. This is the default allocator
+*/
+ITPP_EXPORT Allocator &heap_allocator();
+
+/*!
+  \brief Aligned blocks from thread-local pools of size classes
+
+  Blocks up to 1 MiB are rounded up to a power of two and kept in a small
+  free list of the releasing thread when they are given back, so that
+  temporaries of the same size are reused without going to the heap.
+  Larger blocks are taken from the heap.
+*/
+ITPP_EXPORT Allocator &pool_allocator();
+
+//! Allocator used when neither the factory nor an Arena_Scope choose one
+ITPP_EXPORT Allocator &default_allocator();
+
+//! Make \c a the default allocator of all threads
+ITPP_EXPORT void set_default_allocator(Allocator &a);
+
+/*!
+  \brief Arena of aligned blocks, all given up at once
+
+  Blocks are carved out of large chunks and reset() makes all of them
+  available again in one step. It is meant for the temporaries of a hot
+  loop, through an Arena_Scope:
+
+  \code
+  Arena arena;
+  for (int round = 0; round < max_rounds; round++) {
+    Arena_Scope scope(arena);   // temporaries of this round come from arena
+    ...
+  }                             // all given up here
+  \endcode
+
+  A block still in use when the arena is reset or destroyed, e.g. a result
+  moved out of the loop, stays valid: its chunk is freed when the last
+  such block is destroyed, and is not reused before. An arena allocates
+  from a single thread at a time, while its blocks may be destroyed from
+  any thread.
+*/
+class ITPP_EXPORT Arena : public Allocator
+{
+public:
+  //! Arena taking chunks of \c chunk_bytes bytes from the heap
+  explicit Arena(std::size_t chunk_bytes = std::size_t(1) << 20);
+  //! Destructor. Frees the chunks which have no block in use
+  virtual ~Arena();
+  //! Allocate \c bytes bytes in the current chunk
+  virtual void *allocate(std::size_t bytes, void* &cookie);
+  //! Release a block. Its memory is only reused after reset()
+  virtual void deallocate(void *p, std::size_t bytes, void *cookie);
+  //! Give up all the blocks allocated since the previous reset. The chunks of blocks larger than a chunk go back to the heap
+  void reset();
+  //! Number of bytes currently taken from the heap by the arena
+  std::size_t capacity() const;
+private:
+  struct Chunk;
+  Chunk *new_chunk(std::size_t bytes);
+  static void release_chunk(Chunk *c);
+  Chunk *chunks;
+  Chunk *current;
+  std::size_t chunk_size;
+  // Not copyable
+  Arena(const Arena &);
+  Arena &operator=(const Arena &);
+};
+
+/*!
+  \brief Make an Arena the allocator of the calling thread for a scope
+
+  While the scope is alive, the elements of Array, Vec and Mat created by
+  the calling thread with a factory that does not select an allocator come
+  from \c arena. When the scope ends, the previous allocator of the thread
+  is restored and the arena is reset. Scopes may be nested.
+*/
+class ITPP_EXPORT Arena_Scope
+{
+public:
+  //! Install \c a as the allocator of the calling thread
+  explicit Arena_Scope(Arena &a);
+  //! Restore the previous allocator and reset the arena
+  ~Arena_Scope();
+private:
+  Arena &arena;
+  Allocator *previous;
+  // Not copyable
+  Arena_Scope(const Arena_Scope &);
+  Arena_Scope &operator=(const Arena_Scope &);
+};
+
+/*!
+  \brief Factory selecting the allocator of the element storage
+
+  \code
+  Arena workspace;
+  Allocator_Factory ws(workspace);
+  vec buffer(1024, ws);       // storage taken from workspace
+  \endcode
+
+  As for any factory, the Allocator_Factory must outlive the Array, Vec and
+  Mat objects using it, and so must the allocator.
+*/
+class ITPP_EXPORT Allocator_Factory : public Factory
+{
+public:
+  //! Factory using the allocator \c a
+  explicit Allocator_Factory(Allocator &a) : alloc(a) {}
+  //! Destructor
+  virtual ~Allocator_Factory() {}
+  //! The allocator given to the constructor
+  virtual Allocator *allocator() const { return &alloc; }
+private:
+  Allocator &alloc;
+};
+
+//! \cond
+// Aligned storage of n bytes for the elements of numeric Array, Vec and
+// Mat, and its release
+ITPP_EXPORT void *allocate_elements(std::size_t n, const Factory &f);
+ITPP_EXPORT void deallocate_elements(void *p);
+//! \endcond
+
+
 //! Create an n-length array of T to be used as Array, Vec or Mat elements
 template<class T> inline
 void create_elements(T* &ptr, int n, const Factory &)
@@ -154,57 +335,51 @@ void create_elements(T* &ptr, int n, const Factory &)
 //! Specialization for unsigned char data arrays (used in GF2Mat)
 template<> inline
 void create_elements<unsigned char>(unsigned char* &ptr, int n,
-                                    const Factory &)
+                                    const Factory &f)
 {
-  void *p = operator new(sizeof(unsigned char) * n);
+  void *p = allocate_elements(sizeof(unsigned char) * n, f);
   ptr = reinterpret_cast<unsigned char*>(p);
 }
 
 //! Specialization for binary data arrays
 template<> inline
-void create_elements<bin>(bin* &ptr, int n, const Factory &)
+void create_elements<bin>(bin* &ptr, int n, const Factory &f)
 {
-  void *p = operator new(sizeof(bin) * n);
+  void *p = allocate_elements(sizeof(bin) * n, f);
   ptr = reinterpret_cast<bin*>(p);
 }
 
 //! Specialization for short integer data arrays
 template<> inline
-void create_elements<short int>(short int* &ptr, int n, const Factory &)
+void create_elements<short int>(short int* &ptr, int n, const Factory &f)
 {
-  void *p = operator new(sizeof(short int) * n);
+  void *p = allocate_elements(sizeof(short int) * n, f);
   ptr = reinterpret_cast<short int*>(p);
 }
 
 //! Specialization for integer data arrays
 template<> inline
-void create_elements<int>(int* &ptr, int n, const Factory &)
+void create_elements<int>(int* &ptr, int n, const Factory &f)
 {
-  void *p = operator new(sizeof(int) * n);
+  void *p = allocate_elements(sizeof(int) * n, f);
   ptr = reinterpret_cast<int*>(p);
 }
 
-//! Specialization for 16-byte aligned double data arrays
+//! Specialization for aligned double data arrays
 template<> inline
-void create_elements<double>(double* &ptr, int n, const Factory &)
+void create_elements<double>(double* &ptr, int n, const Factory &f)
 {
-  void *p0 = operator new(sizeof(double) * n + 16);
-  void *p1 = reinterpret_cast<void*>((reinterpret_cast<std::size_t>(p0) + 16)
-                                     & (~(std::size_t(15))));
-  *(reinterpret_cast<void**>(p1) - 1) = p0;
-  ptr = reinterpret_cast<double*>(p1);
+  void *p = allocate_elements(sizeof(double) * n, f);
+  ptr = reinterpret_cast<double*>(p);
 }
 
-//! Specialization for 16-byte aligned complex double data arrays
+//! Specialization for aligned complex double data arrays
 template<> inline
 void create_elements<std::complex<double> >(std::complex<double>* &ptr,
-    int n, const Factory &)
+    int n, const Factory &f)
 {
-  void *p0 = operator new(sizeof(std::complex<double>) * n + 16);
-  void *p1 = reinterpret_cast<void*>((reinterpret_cast<std::size_t>(p0) + 16)
-                                     & (~(std::size_t(15))));
-  *(reinterpret_cast<void**>(p1) - 1) = p0;
-  ptr = reinterpret_cast<std::complex<double>*>(p1);
+  void *p = allocate_elements(sizeof(std::complex<double>) * n, f);
+  ptr = reinterpret_cast<std::complex<double>*>(p);
 }
 
 
@@ -228,9 +403,8 @@ template<> inline
 void destroy_elements<unsigned char>(unsigned char* &ptr, int)
 {
   if (ptr) {
-    void *p = reinterpret_cast<void*>(ptr);
-    operator delete(p);
-	ptr = 0;
+    deallocate_elements(reinterpret_cast<void*>(ptr));
+    ptr = 0;
   }
 }
 
@@ -239,8 +413,7 @@ template<> inline
 void destroy_elements<bin>(bin* &ptr, int)
 {
   if (ptr) {
-    void *p = reinterpret_cast<void*>(ptr);
-    operator delete(p);
+    deallocate_elements(reinterpret_cast<void*>(ptr));
     ptr = 0;
   }
 }
@@ -249,8 +422,7 @@ template<> inline
 void destroy_elements<short int>(short int* &ptr, int)
 {
   if (ptr) {
-    void *p = reinterpret_cast<void*>(ptr);
-    operator delete(p);
+    deallocate_elements(reinterpret_cast<void*>(ptr));
     ptr = 0;
   }
 }
@@ -260,30 +432,27 @@ template<> inline
 void destroy_elements<int>(int* &ptr, int)
 {
   if (ptr) {
-    void *p = reinterpret_cast<void*>(ptr);
-    operator delete(p);
+    deallocate_elements(reinterpret_cast<void*>(ptr));
     ptr = 0;
   }
 }
 
-//! Specialisation for 16-byte aligned double data arrays
+//! Specialisation for aligned double data arrays
 template<> inline
 void destroy_elements<double>(double* &ptr, int)
 {
   if (ptr) {
-    void *p = *(reinterpret_cast<void**>(ptr) - 1);
-    operator delete(p);
+    deallocate_elements(reinterpret_cast<void*>(ptr));
     ptr = 0;
   }
 }
 
-//! Specialisation for 16-byte aligned complex double data arrays
+//! Specialisation for aligned complex double data arrays
 template<> inline
 void destroy_elements<std::complex<double> >(std::complex<double>* &ptr, int)
 {
   if (ptr) {
-    void *p = *(reinterpret_cast<void**>(ptr) - 1);
-    operator delete(p);
+    deallocate_elements(reinterpret_cast<void*>(ptr));
     ptr = 0;
   }
 }
@@ -36,6 +36,8 @@
 
 #if defined (HAVE_BLAS)
 #  include <itpp/base/blas.h>
+#else
+#  include <itpp/base/native_blas.h>
 #endif
 
 //! \cond
@@ -90,23 +92,10 @@ cmat& cmat::operator*=(const cmat &m)
 template<>
 mat& mat::operator*=(const mat &m)
 {
-  it_assert_debug(no_cols == m.no_rows, "Mat<>::operator*=(): Wrong sizes");
+  it_assert_debug(no_cols == m.no_rows, "mat::operator*=(): Wrong sizes");
   mat r(no_rows, m.no_cols);
-  int r_pos = 0, pos = 0, m_pos = 0;
-
-  for (int i = 0; i < r.no_cols; i++) {
-    for (int j = 0; j < r.no_rows; j++) {
-      double tmp = 0.0;
-      pos = 0;
-      for (int k = 0; k < no_cols; k++) {
-        tmp += data[pos+j] * m.data[m_pos+k];
-        pos += no_rows;
-      }
-      r.data[r_pos+j] = tmp;
-    }
-    r_pos += r.no_rows;
-    m_pos += m.no_rows;
-  }
+  native_blas::dgemm('n', 'n', no_rows, m.no_cols, no_cols, 1.0, data,
+                     no_rows, m.data, m.no_rows, 0.0, r.data, r.no_rows);
   operator=(r); // time consuming
   return *this;
 }
@@ -114,23 +103,11 @@ mat& mat::operator*=(const mat &m)
 template<>
 cmat& cmat::operator*=(const cmat &m)
 {
-  it_assert_debug(no_cols == m.no_rows, "Mat<>::operator*=(): Wrong sizes");
+  it_assert_debug(no_cols == m.no_rows, "cmat::operator*=(): Wrong sizes");
   cmat r(no_rows, m.no_cols);
-  int r_pos = 0, pos = 0, m_pos = 0;
-
-  for (int i = 0; i < r.no_cols; i++) {
-    for (int j = 0; j < r.no_rows; j++) {
-      std::complex<double> tmp(0.0);
-      pos = 0;
-      for (int k = 0; k < no_cols; k++) {
-        tmp += data[pos+j] * m.data[m_pos+k];
-        pos += no_rows;
-      }
-      r.data[r_pos+j] = tmp;
-    }
-    r_pos += r.no_rows;
-    m_pos += m.no_rows;
-  }
+  native_blas::zgemm('n', 'n', no_rows, m.no_cols, no_cols,
+                     std::complex<double>(1.0), data, no_rows, m.data,
+                     m.no_rows, std::complex<double>(0.0), r.data, r.no_rows);
   operator=(r); // time consuming
   return *this;
 }
@@ -173,50 +150,25 @@ cmat operator*(const cmat &m1, const cmat &m2)
 template<>
 mat operator*(const mat &m1, const mat &m2)
 {
-  it_assert_debug(m1.rows() == m2.cols(),
-                  "Mat<>::operator*(): Wrong sizes");
-  mat r(m1.rows(), m2.cols());
-  double *tr = r._data();
-  const double *t1;
-  const double *t2 = m2._data();
-  for (int i = 0; i < r.cols(); i++) {
-    for (int j = 0; j < r.rows(); j++) {
-      double tmp = 0.0;
-      t1 = m1._data() + j;
-      for (int k = m1.cols(); k > 0; k--) {
-        tmp += *(t1) * *(t2++);
-        t1 += m1.rows();
-      }
-      *(tr++) = tmp;
-      t2 -= m2.rows();
-    }
-    t2 += m2.rows();
-  }
+  it_assert_debug(m1.cols() == m2.rows(), "mat::operator*(): Wrong sizes");
+  int m1_r = m1.rows(); int m1_c = m1.cols();
+  int m2_r = m2.rows(); int m2_c = m2.cols();
+  mat r(m1_r, m2_c);
+  native_blas::dgemm('n', 'n', m1_r, m2_c, m1_c, 1.0, m1._data(), m1_r,
+                     m2._data(), m2_r, 0.0, r._data(), m1_r);
   return r;
 }
 
 template<>
 cmat operator*(const cmat &m1, const cmat &m2)
 {
-  it_assert_debug(m1.cols() == m2.rows(),
-                  "Mat<>::operator*(): Wrong sizes");
-  cmat r(m1.rows(), m2.cols());
-  std::complex<double> *tr = r._data();
-  const std::complex<double> *t1;
-  const std::complex<double> *t2 = m2._data();
-  for (int i = 0; i < r.cols(); i++) {
-    for (int j = 0; j < r.rows(); j++) {
-      std::complex<double> tmp(0.0);
-      t1 = m1._data() + j;
-      for (int k = m1.cols(); k > 0; k--) {
-        tmp += *(t1) * *(t2++);
-        t1 += m1.rows();
-      }
-      *(tr++) = tmp;
-      t2 -= m2.rows();
-    }
-    t2 += m2.rows();
-  }
+  it_assert_debug(m1.cols() == m2.rows(), "cmat::operator*(): Wrong sizes");
+  int m1_r = m1.rows(); int m1_c = m1.cols();
+  int m2_r = m2.rows(); int m2_c = m2.cols();
+  cmat r(m1_r, m2_c);
+  native_blas::zgemm('n', 'n', m1_r, m2_c, m1_c, std::complex<double>(1.0),
+                     m1._data(), m1_r, m2._data(), m2_r,
+                     std::complex<double>(0.0), r._data(), m1_r);
   return r;
 }
 #endif // HAVE_BLAS
@@ -256,34 +208,22 @@ cvec operator*(const cmat &m, const cvec &v)
 template<>
 vec operator*(const mat &m, const vec &v)
 {
-  it_assert_debug(m.cols() == v.size(),
-                  "Mat<>::operator*(): Wrong sizes");
-  vec r(m.rows());
-  for (int i = 0; i < m.rows(); i++) {
-    r(i) = 0.0;
-    int m_pos = 0;
-    for (int k = 0; k < m.cols(); k++) {
-      r(i) += m._data()[m_pos+i] * v(k);
-      m_pos += m.rows();
-    }
-  }
+  it_assert_debug(m.cols() == v.size(), "mat::operator*(): Wrong sizes");
+  int m_r = m.rows(); int m_c = m.cols();
+  vec r(m_r);
+  native_blas::dgemv('n', m_r, m_c, 1.0, m._data(), m_r, v._data(), 1, 0.0,
+                     r._data(), 1);
   return r;
 }
 
 template<>
 cvec operator*(const cmat &m, const cvec &v)
 {
-  it_assert_debug(m.cols() == v.size(),
-                  "Mat<>::operator*(): Wrong sizes");
-  cvec r(m.rows());
-  for (int i = 0; i < m.rows(); i++) {
-    r(i) = std::complex<double>(0.0);
-    int m_pos = 0;
-    for (int k = 0; k < m.cols(); k++) {
-      r(i) += m._data()[m_pos+i] * v(k);
-      m_pos += m.rows();
-    }
-  }
+  it_assert_debug(m.cols() == v.size(), "cmat::operator*(): Wrong sizes");
+  int m_r = m.rows(); int m_c = m.cols();
+  cvec r(m_r);
+  native_blas::zgemv('n', m_r, m_c, std::complex<double>(1.0), m._data(), m_r,
+                     v._data(), 1, std::complex<double>(0.0), r._data(), 1);
   return r;
 }
 #endif // HAVE_BLAS
@@ -33,6 +33,7 @@
 #include <itpp/base/math/misc.h>
 #include <itpp/base/factory.h>
 #include <itpp/itexports.h>
+#include <utility>
 
 namespace itpp
 {
@@ -41,6 +42,8 @@ namespace itpp
 template<class Num_T> class Vec;
 // Declaration of Mat
 template<class Num_T> class Mat;
+// Declaration of Elem_Expr
+template<class E> class Elem_Expr;
 // Declaration of bin
 class bin;
 
@@ -210,6 +213,10 @@ public:
   Mat(int rows, int cols, const Factory &f = DEFAULT_FACTORY);
   //! Copy constructor
   Mat(const Mat<Num_T> &m);
+#ifdef ITPP_HAVE_RVALUE_REFS
+  //! Move constructor. Takes over the storage of \c m, which is left empty
+  Mat(Mat<Num_T> &&m);
+#endif
   //! Constructor, similar to the copy constructor, but also takes an element factory \c f as argument
   Mat(const Mat<Num_T> &m, const Factory &f);
   //! Construct a matrix from a column vector \c v. An element factory \c f can be specified.
@@ -227,6 +234,9 @@ public:
    */
   Mat(const Num_T *c_array, int rows, int cols, bool row_major = true,
       const Factory &f = DEFAULT_FACTORY);
+  //! Constructor evaluating the elementwise expression \c e (see elem_expr.h). An element factory \c f can be specified.
+  template<class E>
+  explicit Mat(const Elem_Expr<E> &e, const Factory &f = DEFAULT_FACTORY);
 
   //! Destructor
   ~Mat();
@@ -351,12 +361,19 @@ public:
   Mat<Num_T>& operator=(Num_T t);
   //! Set matrix equal to \c m
   Mat<Num_T>& operator=(const Mat<Num_T> &m);
+#ifdef ITPP_HAVE_RVALUE_REFS
+  //! Take over the storage of \c m, or copy it if the element factories differ
+  Mat<Num_T>& operator=(Mat<Num_T> &&m);
+#endif
   //! Set matrix equal to the vector \c v, assuming column vector
   Mat<Num_T>& operator=(const Vec<Num_T> &v);
   //! Set matrix equal to values in the string \c str
   Mat<Num_T>& operator=(const std::string &str);
   //! Set matrix equal to values in the string \c str
   Mat<Num_T>& operator=(const char *str);
+  //! Set matrix equal to the elementwise expression \c e (see elem_expr.h)
+  template<class E>
+  Mat<Num_T>& operator=(const Elem_Expr<E> &e);
 
   //! Addition of matrices
   Mat<Num_T>& operator+=(const Mat<Num_T> &m);
@@ -591,6 +608,19 @@ Mat<Num_T>::Mat(const Mat<Num_T> &m) :
   copy_vector(m.datasize, m.data, data);
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+template<class Num_T> inline
+Mat<Num_T>::Mat(Mat<Num_T> &&m) :
+    datasize(m.datasize), no_rows(m.no_rows), no_cols(m.no_cols),
+    data(m.data), factory(m.factory)
+{
+  m.datasize = 0;
+  m.no_rows = 0;
+  m.no_cols = 0;
+  m.data = 0;
+}
+#endif
+
 template<class Num_T> inline
 Mat<Num_T>::Mat(const Mat<Num_T> &m, const Factory &f) :
     datasize(0), no_rows(0), no_cols(0), data(0), factory(f)
@@ -1252,6 +1282,32 @@ Mat<Num_T>& Mat<Num_T>::operator=(const Mat<Num_T> &m)
   return *this;
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+template<class Num_T> inline
+Mat<Num_T>& Mat<Num_T>::operator=(Mat<Num_T> &&m)
+{
+  if (this != &m) {
+    if (&factory == &m.factory) {
+      free();
+      datasize = m.datasize;
+      no_rows = m.no_rows;
+      no_cols = m.no_cols;
+      data = m.data;
+      m.datasize = 0;
+      m.no_rows = 0;
+      m.no_cols = 0;
+      m.data = 0;
+    }
+    else {
+      set_size(m.no_rows, m.no_cols, false);
+      if (m.datasize != 0)
+        copy_vector(m.datasize, m.data, data);
+    }
+  }
+  return *this;
+}
+#endif
+
 template<class Num_T> inline
 Mat<Num_T>& Mat<Num_T>::operator=(const Vec<Num_T> &v)
 {
@@ -1684,6 +1740,182 @@ Mat<Num_T> operator/(Num_T t, const Mat<Num_T> &m)
   return r;
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+
+//-----------------------------------------------------------------------------------
+// Operators reusing the storage of a temporary operand
+//-----------------------------------------------------------------------------------
+
+//! Addition of two matrices, reusing the storage of \c m1
+template<class Num_T> inline
+Mat<Num_T> operator+(Mat<Num_T> &&m1, const Mat<Num_T> &m2)
+{
+  it_assert_debug((m1.rows() == m2.rows()) && (m1.cols() == m2.cols()), "Mat<>::operator+(): Wrong sizes");
+  const Num_T *p1 = m1._data();
+  const Num_T *p2 = m2._data();
+  Num_T *r = m1._data();
+  for (int i = 0; i < m1.size(); i++)
+    r[i] = p1[i] + p2[i];
+  return std::move(m1);
+}
+
+//! Addition of two matrices, reusing the storage of \c m2
+template<class Num_T> inline
+Mat<Num_T> operator+(const Mat<Num_T> &m1, Mat<Num_T> &&m2)
+{
+  it_assert_debug((m1.rows() == m2.rows()) && (m1.cols() == m2.cols()), "Mat<>::operator+(): Wrong sizes");
+  const Num_T *p1 = m1._data();
+  const Num_T *p2 = m2._data();
+  Num_T *r = m2._data();
+  for (int i = 0; i < m2.size(); i++)
+    r[i] = p1[i] + p2[i];
+  return std::move(m2);
+}
+
+//! Addition of two matrices, reusing the storage of \c m1
+template<class Num_T> inline
+Mat<Num_T> operator+(Mat<Num_T> &&m1, Mat<Num_T> &&m2)
+{
+  it_assert_debug((m1.rows() == m2.rows()) && (m1.cols() == m2.cols()), "Mat<>::operator+(): Wrong sizes");
+  const Num_T *p1 = m1._data();
+  const Num_T *p2 = m2._data();
+  Num_T *r = m1._data();
+  for (int i = 0; i < m1.size(); i++)
+    r[i] = p1[i] + p2[i];
+  return std::move(m1);
+}
+
+//! Addition of a matrix and a scalar, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator+(Mat<Num_T> &&m, Num_T t)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = p[i] + t;
+  return std::move(m);
+}
+
+//! Addition of a scalar and a matrix, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator+(Num_T t, Mat<Num_T> &&m)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = t + p[i];
+  return std::move(m);
+}
+
+//! Subtraction of \c m2 from \c m1, reusing the storage of \c m1
+template<class Num_T> inline
+Mat<Num_T> operator-(Mat<Num_T> &&m1, const Mat<Num_T> &m2)
+{
+  it_assert_debug((m1.rows() == m2.rows()) && (m1.cols() == m2.cols()), "Mat<>::operator-(): Wrong sizes");
+  const Num_T *p1 = m1._data();
+  const Num_T *p2 = m2._data();
+  Num_T *r = m1._data();
+  for (int i = 0; i < m1.size(); i++)
+    r[i] = p1[i] - p2[i];
+  return std::move(m1);
+}
+
+//! Subtraction of \c m2 from \c m1, reusing the storage of \c m2
+template<class Num_T> inline
+Mat<Num_T> operator-(const Mat<Num_T> &m1, Mat<Num_T> &&m2)
+{
+  it_assert_debug((m1.rows() == m2.rows()) && (m1.cols() == m2.cols()), "Mat<>::operator-(): Wrong sizes");
+  const Num_T *p1 = m1._data();
+  const Num_T *p2 = m2._data();
+  Num_T *r = m2._data();
+  for (int i = 0; i < m2.size(); i++)
+    r[i] = p1[i] - p2[i];
+  return std::move(m2);
+}
+
+//! Subtraction of \c m2 from \c m1, reusing the storage of \c m1
+template<class Num_T> inline
+Mat<Num_T> operator-(Mat<Num_T> &&m1, Mat<Num_T> &&m2)
+{
+  it_assert_debug((m1.rows() == m2.rows()) && (m1.cols() == m2.cols()), "Mat<>::operator-(): Wrong sizes");
+  const Num_T *p1 = m1._data();
+  const Num_T *p2 = m2._data();
+  Num_T *r = m1._data();
+  for (int i = 0; i < m1.size(); i++)
+    r[i] = p1[i] - p2[i];
+  return std::move(m1);
+}
+
+//! Subtraction of a scalar from a matrix, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator-(Mat<Num_T> &&m, Num_T t)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = p[i] - t;
+  return std::move(m);
+}
+
+//! Subtraction of a matrix from a scalar, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator-(Num_T t, Mat<Num_T> &&m)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = t - p[i];
+  return std::move(m);
+}
+
+//! Negation of a matrix, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator-(Mat<Num_T> &&m)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = -p[i];
+  return std::move(m);
+}
+
+//! Multiplication of a matrix and a scalar, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator*(Mat<Num_T> &&m, Num_T t)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = p[i] * t;
+  return std::move(m);
+}
+
+//! Multiplication of a scalar and a matrix, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator*(Num_T t, Mat<Num_T> &&m)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = p[i] * t;
+  return std::move(m);
+}
+
+//! Division of all elements in \c m by \c t, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator/(Mat<Num_T> &&m, Num_T t)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = p[i] / t;
+  return std::move(m);
+}
+
+//! Division of \c t by all elements in \c m, reusing the storage of \c m
+template<class Num_T> inline
+Mat<Num_T> operator/(Num_T t, Mat<Num_T> &&m)
+{
+  Num_T *p = m._data();
+  for (int i = 0; i < m.size(); i++)
+    p[i] = t / p[i];
+  return std::move(m);
+}
+
+#endif // #ifdef ITPP_HAVE_RVALUE_REFS
+
 template<class Num_T> inline
 Mat<Num_T> elem_div(const Mat<Num_T> &m1, const Mat<Num_T> &m2)
 {
@@ -31,6 +31,7 @@
 #define MATFUNC_H
 #include <algorithm>
 #include <itpp/base/mat.h>
+#include <itpp/base/view.h>
 #include <itpp/base/math/log_exp.h>
 #include <itpp/base/math/elem_math.h>
 #include <itpp/base/algebra/inv.h>
@@ -79,17 +80,19 @@ Vec<T> sum(const Mat<T> &m, int dim = 1)
   it_assert((dim == 1) || (dim == 2), "sum: dimension need to be 1 or 2");
   Vec<T> out;
 
+  // The rows and columns are summed in place through views
+  Mat_View<T> mv(m);
   if (dim == 1) {
     out.set_size(m.cols(), false);
 
     for (int i = 0; i < m.cols(); i++)
-      out(i) = sum(m.get_col(i));
+      out(i) = sum(mv.get_col(i));
   }
   else {
     out.set_size(m.rows(), false);
 
     for (int i = 0; i < m.rows(); i++)
-      out(i) = sum(m.get_row(i));
+      out(i) = sum(mv.get_row(i));
   }
 
   return out;
@@ -55,23 +55,14 @@ mat sqr(const cmat &data)
 vec abs(const cvec &data)
 {
   vec temp(data.length());
-
-  for (int i = 0;i < data.length();i++)
-    temp[i] = std::abs(data[i]);
-
+  vmath_abs(data._data(), temp._data(), data.length());
   return temp;
 }
 
 mat abs(const cmat &data)
 {
   mat temp(data.rows(), data.cols());
-
-  for (int i = 0;i < temp.rows();i++) {
-    for (int j = 0;j < temp.cols();j++) {
-      temp(i, j) = std::abs(data(i, j));
-    }
-  }
-
+  vmath_abs(data._data(), temp._data(), data.size());
   return temp;
 }
 
@@ -31,6 +31,7 @@
 
 #include <itpp/base/help_functions.h>
 #include <itpp/base/converters.h>
+#include <itpp/base/math/vmath.h>
 #include <cstdlib> // required by std::abs()
 #include <itpp/itexports.h>
 
@@ -62,9 +63,19 @@ ITPP_EXPORT mat sqr(const cmat &x);
 // -------------------- abs function --------------------
 
 //! Absolute value
-inline vec abs(const vec &x) { return apply_function<double>(std::fabs, x); }
+inline vec abs(const vec &x)
+{
+  vec out(x.size());
+  vmath_abs(x._data(), out._data(), x.size());
+  return out;
+}
 //! Absolute value
-inline mat abs(const mat &x) { return apply_function<double>(std::fabs, x); }
+inline mat abs(const mat &x)
+{
+  mat out(x.rows(), x.cols());
+  vmath_abs(x._data(), out._data(), x.size());
+  return out;
+}
 //! Absolute value
 inline ivec abs(const ivec &x) { return apply_function<int>(std::abs, x); }
 //! Absolute value
@@ -120,9 +131,19 @@ inline int sign_i(double x)
 // -------------------- sqrt function --------------------
 
 //! Square root of the elements
-inline vec sqrt(const vec &x) { return apply_function<double>(std::sqrt, x); }
+inline vec sqrt(const vec &x)
+{
+  vec out(x.size());
+  vmath_sqrt(x._data(), out._data(), x.size());
+  return out;
+}
 //! Square root of the elements
-inline mat sqrt(const mat &x) { return apply_function<double>(std::sqrt, x); }
+inline mat sqrt(const mat &x)
+{
+  mat out(x.rows(), x.cols());
+  vmath_sqrt(x._data(), out._data(), x.size());
+  return out;
+}
 
 
 // -------------------- gamma function --------------------
@@ -31,6 +31,7 @@
 
 #include <cmath>
 #include <itpp/base/help_functions.h>
+#include <itpp/base/math/vmath.h>
 #include <itpp/itexports.h>
 
 namespace itpp
@@ -154,22 +155,22 @@ ITPP_EXPORT double log_add(double log_a, double log_b);
 //! Exp of the elements of a vector \c x
 inline vec exp(const vec &x)
 {
-  return apply_function<double>(std::exp, x);
+  return details::vmath_apply(vmath_exp, x);
 }
 //! Exp of the elements of a complex vector \c x
 inline cvec exp(const cvec &x)
 {
-  return apply_function<std::complex<double> >(std::exp, x);
+  return details::vmath_apply(vmath_exp, x);
 }
 //! Exp of the elements of a matrix \c m
 inline mat exp(const mat &m)
 {
-  return apply_function<double>(std::exp, m);
+  return details::vmath_apply(vmath_exp, m);
 }
 //! Exp of the elements of a complex matrix \c m
 inline cmat exp(const cmat &m)
 {
-  return apply_function<std::complex<double> >(std::exp, m);
+  return details::vmath_apply(vmath_exp, m);
 }
 
 //! Calculates x to the power of y (x^y)
@@ -185,12 +186,16 @@ inline mat pow(const double x, const mat &y)
 //! Calculates x to the power of y (x^y)
 inline vec pow(const vec &x, const double y)
 {
-  return apply_function<double>(std::pow, x, y);
+  vec out(x.size());
+  vmath_pow(x._data(), y, out._data(), x.size());
+  return out;
 }
 //! Calculates x to the power of y (x^y)
 inline mat pow(const mat &x, const double y)
 {
-  return apply_function<double>(std::pow, x, y);
+  mat out(x.rows(), x.cols());
+  vmath_pow(x._data(), y, out._data(), x.size());
+  return out;
 }
 
 //! Calculates two to the power of x (2^x)
@@ -240,12 +245,12 @@ inline mat pow10(const mat &x)
 //! The natural logarithm of the elements
 inline vec log(const vec &x)
 {
-  return apply_function<double>(std::log, x);
+  return details::vmath_apply(vmath_log, x);
 }
 //! The natural logarithm of the elements
 inline mat log(const mat &x)
 {
-  return apply_function<double>(std::log, x);
+  return details::vmath_apply(vmath_log, x);
 }
 //! The natural logarithm of the elements
 inline cvec log(const cvec &x)
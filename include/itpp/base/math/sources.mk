@@ -1,3 +1,6 @@
+noinst_h_base_math_sources = \
+	$(top_srcdir)/itpp/base/math/vmath_kernels.h
+
 h_base_math_sources = \
 	$(top_srcdir)/itpp/base/math/elem_math.h \
 	$(top_srcdir)/itpp/base/math/error.h \
@@ -5,7 +8,8 @@ h_base_math_sources = \
 	$(top_srcdir)/itpp/base/math/log_exp.h \
 	$(top_srcdir)/itpp/base/math/min_max.h \
 	$(top_srcdir)/itpp/base/math/misc.h \
-	$(top_srcdir)/itpp/base/math/trig_hyp.h
+	$(top_srcdir)/itpp/base/math/trig_hyp.h \
+	$(top_srcdir)/itpp/base/math/vmath.h
 
 cpp_base_math_sources = \
 	$(top_srcdir)/itpp/base/math/elem_math.cpp \
@@ -13,4 +17,5 @@ cpp_base_math_sources = \
 	$(top_srcdir)/itpp/base/math/integration.cpp \
 	$(top_srcdir)/itpp/base/math/log_exp.cpp \
 	$(top_srcdir)/itpp/base/math/misc.cpp \
-	$(top_srcdir)/itpp/base/math/trig_hyp.cpp
+	$(top_srcdir)/itpp/base/math/trig_hyp.cpp \
+	$(top_srcdir)/itpp/base/math/vmath.cpp
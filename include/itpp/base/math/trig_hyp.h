@@ -30,6 +30,7 @@
 #define TRIG_HYP_H
 
 #include <itpp/base/help_functions.h>
+#include <itpp/base/math/vmath.h>
 #include <itpp/itexports.h>
 
 namespace itpp
@@ -51,13 +52,13 @@ inline double sinc(double x)
 }
 
 //! Sine function
-inline vec sin(const vec &x) { return apply_function<double>(std::sin, x); }
+inline vec sin(const vec &x) { return details::vmath_apply(vmath_sin, x); }
 //! Sine function
-inline mat sin(const mat &x) { return apply_function<double>(std::sin, x); }
+inline mat sin(const mat &x) { return details::vmath_apply(vmath_sin, x); }
 //! Cosine function
-inline vec cos(const vec &x) { return apply_function<double>(std::cos, x); }
+inline vec cos(const vec &x) { return details::vmath_apply(vmath_cos, x); }
 //! Cosine function
-inline mat cos(const mat &x) { return apply_function<double>(std::cos, x); }
+inline mat cos(const mat &x) { return details::vmath_apply(vmath_cos, x); }
 //! Tan function
 inline vec tan(const vec &x) { return apply_function<double>(std::tan, x); }
 //! Tan function
@@ -94,9 +95,9 @@ inline vec cosh(const vec &x) { return apply_function<double>(std::cosh, x); }
 //! Cosine hyperbolic function
 inline mat cosh(const mat &x) { return apply_function<double>(std::cosh, x); }
 //! Tan hyperbolic function
-inline vec tanh(const vec &x) { return apply_function<double>(std::tanh, x); }
+inline vec tanh(const vec &x) { return details::vmath_apply(vmath_tanh, x); }
 //! Tan hyperbolic function
-inline mat tanh(const mat &x) { return apply_function<double>(std::tanh, x); }
+inline mat tanh(const mat &x) { return details::vmath_apply(vmath_tanh, x); }
 //! Inverse sine hyperbolic function
 ITPP_EXPORT vec asinh(const vec &x);
 //! Inverse sine hyperbolic function
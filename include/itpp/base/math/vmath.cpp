@@ -0,0 +1,383 @@
+/*!
+ * \file
+ * \brief Vectorized elementwise exponential, logarithmic, trigonometric
+ * and hyperbolic functions
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/base/math/vmath.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// The kernels of vmath_kernels.h are written once with the generic vectors
+// of GCC and Clang, and compiled for each instruction set in a namespace of
+// its own, the choice being made at run time. Other compilers use them on
+// plain doubles.
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define VMATH_X86
+#  include <immintrin.h>
+// The packs are inlined, never passed between functions
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__GNUC__)
+#  define VMATH_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#  define VMATH_INLINE __forceinline
+#else
+#  define VMATH_INLINE inline
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+// ----------------------------------------------------------------------
+// Packs of doubles
+// ----------------------------------------------------------------------
+
+// Pack traits: U holds the bits of a pack, M the result of a comparison
+template<class V> struct Vm_Pack;
+
+template<> struct Vm_Pack<double>
+{
+  typedef unsigned long long U;
+  typedef bool M;
+  static const int width = 1;
+};
+
+#if defined(VMATH_X86)
+typedef double vm_v2 __attribute__((vector_size(16)));
+typedef double vm_v4 __attribute__((vector_size(32)));
+typedef double vm_v8 __attribute__((vector_size(64)));
+typedef unsigned long long vm_u2 __attribute__((vector_size(16)));
+typedef unsigned long long vm_u4 __attribute__((vector_size(32)));
+typedef unsigned long long vm_u8 __attribute__((vector_size(64)));
+typedef long long vm_m2 __attribute__((vector_size(16)));
+typedef long long vm_m4 __attribute__((vector_size(32)));
+typedef long long vm_m8 __attribute__((vector_size(64)));
+
+template<> struct Vm_Pack<vm_v2>
+{
+  typedef vm_u2 U;
+  typedef vm_m2 M;
+  static const int width = 2;
+};
+
+template<> struct Vm_Pack<vm_v4>
+{
+  typedef vm_u4 U;
+  typedef vm_m4 M;
+  static const int width = 4;
+};
+
+template<> struct Vm_Pack<vm_v8>
+{
+  typedef vm_u8 U;
+  typedef vm_m8 M;
+  static const int width = 8;
+};
+#endif
+
+// ----------------------------------------------------------------------
+// Constants
+// ----------------------------------------------------------------------
+
+// Adding 1.5 * 2^52 rounds |x| < 2^51 to an integer, found in the low bits
+static const double vm_round = 6755399441055744.0;
+static const unsigned long long vm_round_bits = 0x4338000000000000ULL;
+// 2^52, and the bits of 2^52 + i for 0 <= i < 2^52
+static const double vm_two52 = 4503599627370496.0;
+static const unsigned long long vm_two52_bits = 0x4330000000000000ULL;
+
+static const unsigned long long vm_sign_bit = 0x8000000000000000ULL;
+static const unsigned long long vm_mantissa_bits = 0x000FFFFFFFFFFFFFULL;
+static const unsigned long long vm_one_bits = 0x3FF0000000000000ULL;
+
+static const double vm_log2e = 1.4426950408889634;
+static const double vm_sqrt2 = 1.4142135623730951;
+// ln(2) = vm_ln2_hi + vm_ln2_lo, vm_ln2_hi having 32 significant bits
+static const double vm_ln2_hi = 6.93147180369123816490e-01;
+static const double vm_ln2_lo = 1.90821492927058770002e-10;
+// pi/2 = vm_pio2_1 + vm_pio2_2 + vm_pio2_3, the first two having 33
+// significant bits
+static const double vm_two_over_pi = 6.36619772367581382433e-01;
+static const double vm_pio2_1 = 1.57079632673412561417e+00;
+static const double vm_pio2_2 = 6.07710050630396597660e-11;
+static const double vm_pio2_3 = 2.02226624879595063154e-21;
+
+// Ranges of the vectorized algorithms
+static const double vm_exp_min = -708.0;
+static const double vm_exp_max = 709.0;
+static const double vm_trig_max = 1e6;
+static const double vm_tanh_max = 22.0;
+
+// ----------------------------------------------------------------------
+// Kernels of each instruction set
+// ----------------------------------------------------------------------
+
+enum Vm_Op { VM_EXP, VM_LOG, VM_SIN, VM_COS, VM_TANH, VM_POW, VM_SQRT, VM_ABS };
+
+namespace vm_generic
+{
+typedef double Pack;
+VMATH_INLINE double vm_sqrt(double x) { return std::sqrt(x); }
+VMATH_INLINE bool vm_all(bool m) { return m; }
+VMATH_INLINE bool vm_any(bool m) { return m; }
+#include <itpp/base/math/vmath_kernels.h>
+}
+
+#if defined(VMATH_X86)
+namespace vm_sse2
+{
+typedef vm_v2 Pack;
+VMATH_INLINE vm_v2 vm_sqrt(vm_v2 x) { return _mm_sqrt_pd(x); }
+VMATH_INLINE bool vm_all(vm_m2 m) { return _mm_movemask_pd((__m128d) m) == 0x3; }
+VMATH_INLINE bool vm_any(vm_m2 m) { return _mm_movemask_pd((__m128d) m) != 0; }
+#include <itpp/base/math/vmath_kernels.h>
+}
+
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx2,fma")
+#endif
+namespace vm_avx2
+{
+typedef vm_v4 Pack;
+VMATH_INLINE vm_v4 vm_sqrt(vm_v4 x) { return _mm256_sqrt_pd(x); }
+VMATH_INLINE bool vm_all(vm_m4 m) { return _mm256_movemask_pd((__m256d) m) == 0xF; }
+VMATH_INLINE bool vm_any(vm_m4 m) { return _mm256_movemask_pd((__m256d) m) != 0; }
+#include <itpp/base/math/vmath_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+
+// AVX512DQ turns the comparisons of 8 doubles into vectors of integers
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx512f,avx512dq"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx512f,avx512dq")
+#endif
+namespace vm_avx512
+{
+typedef vm_v8 Pack;
+VMATH_INLINE vm_v8 vm_sqrt(vm_v8 x) { return _mm512_maskz_sqrt_pd(0xFF, x); }
+VMATH_INLINE bool vm_all(vm_m8 m) { return _mm512_movepi64_mask((__m512i) m) == 0xFF; }
+VMATH_INLINE bool vm_any(vm_m8 m) { return _mm512_movepi64_mask((__m512i) m) != 0; }
+#include <itpp/base/math/vmath_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+#endif // VMATH_X86
+
+typedef void (*Vm_Run)(int, bool, const double *, double *, int, double);
+
+// ----------------------------------------------------------------------
+// Dispatch
+// ----------------------------------------------------------------------
+
+static Vmath_Isa vm_cpu_isa()
+{
+#if defined(VMATH_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq"))
+    return VMATH_AVX512;
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return VMATH_AVX2;
+  return VMATH_SSE2;
+#else
+  return VMATH_GENERIC;
+#endif
+}
+
+// Set once by the first call, or by set_vmath_isa()
+static int vm_isa = -1;
+
+static Vm_Run vm_kernels()
+{
+  if (vm_isa < 0)
+    vm_isa = vm_cpu_isa();
+  switch (vm_isa) {
+#if defined(VMATH_X86)
+  case VMATH_AVX512:
+    return vm_avx512::vm_run;
+  case VMATH_AVX2:
+    return vm_avx2::vm_run;
+  case VMATH_SSE2:
+    return vm_sse2::vm_run;
+#endif
+  default:
+    return vm_generic::vm_run;
+  }
+}
+
+Vmath_Isa vmath_isa()
+{
+  vm_kernels();
+  return Vmath_Isa(vm_isa);
+}
+
+Vmath_Isa set_vmath_isa(Vmath_Isa max_isa)
+{
+  Vmath_Isa isa = vm_cpu_isa();
+  vm_isa = (max_isa < isa) ? max_isa : isa;
+  return Vmath_Isa(vm_isa);
+}
+
+void vmath_exp(const double *x, double *y, int n, Vmath_Accuracy acc)
+{
+  vm_kernels()(VM_EXP, acc == VMATH_FAST, x, y, n, 0.0);
+}
+
+void vmath_log(const double *x, double *y, int n, Vmath_Accuracy acc)
+{
+  vm_kernels()(VM_LOG, acc == VMATH_FAST, x, y, n, 0.0);
+}
+
+void vmath_sin(const double *x, double *y, int n, Vmath_Accuracy acc)
+{
+  vm_kernels()(VM_SIN, acc == VMATH_FAST, x, y, n, 0.0);
+}
+
+void vmath_cos(const double *x, double *y, int n, Vmath_Accuracy acc)
+{
+  vm_kernels()(VM_COS, acc == VMATH_FAST, x, y, n, 0.0);
+}
+
+void vmath_tanh(const double *x, double *y, int n, Vmath_Accuracy acc)
+{
+  vm_kernels()(VM_TANH, acc == VMATH_FAST, x, y, n, 0.0);
+}
+
+void vmath_pow(const double *x, double e, double *y, int n, Vmath_Accuracy acc)
+{
+  vm_kernels()(VM_POW, acc == VMATH_FAST, x, y, n, e);
+}
+
+void vmath_sqrt(const double *x, double *y, int n)
+{
+  vm_kernels()(VM_SQRT, false, x, y, n, 0.0);
+}
+
+void vmath_abs(const double *x, double *y, int n)
+{
+  vm_kernels()(VM_ABS, false, x, y, n, 0.0);
+}
+
+// The complex functions work on blocks of real and imaginary parts
+static const int vm_block_size = 256;
+
+void vmath_exp(const std::complex<double> *x, std::complex<double> *y, int n,
+               Vmath_Accuracy acc)
+{
+  double re[vm_block_size], im[vm_block_size];
+  double c[vm_block_size], s[vm_block_size];
+  for (int i = 0; i < n; i += vm_block_size) {
+    int m = (n - i < vm_block_size) ? n - i : vm_block_size;
+    for (int k = 0; k < m; k++) {
+      re[k] = x[i + k].real();
+      im[k] = x[i + k].imag();
+    }
+    vmath_cos(im, c, m, acc);
+    vmath_sin(im, s, m, acc);
+    vmath_exp(re, re, m, acc);
+    for (int k = 0; k < m; k++) {
+      // Overflows and non-finite parts follow std::exp()
+      if ((x[i + k].real() >= vm_exp_min) && (x[i + k].real() <= vm_exp_max)
+          && (std::fabs(im[k]) <= std::numeric_limits<double>::max()))
+        y[i + k] = std::complex<double>(re[k] * c[k], re[k] * s[k]);
+      else
+        y[i + k] = std::exp(x[i + k]);
+    }
+  }
+}
+
+void vmath_abs(const std::complex<double> *x, double *y, int n)
+{
+  // re^2 + im^2 neither overflows nor loses accuracy to underflow for
+  // max(|re|, |im|) in [2^-500, 2^500]
+  const double lo = std::ldexp(1.0, -500);
+  const double hi = std::ldexp(1.0, 500);
+  double s[vm_block_size];
+  for (int i = 0; i < n; i += vm_block_size) {
+    int m = (n - i < vm_block_size) ? n - i : vm_block_size;
+    for (int k = 0; k < m; k++) {
+      double re = x[i + k].real();
+      double im = x[i + k].imag();
+      s[k] = re * re + im * im;
+    }
+    vmath_sqrt(s, y + i, m);
+    for (int k = 0; k < m; k++) {
+      double a = std::fabs(x[i + k].real());
+      double b = std::fabs(x[i + k].imag());
+      double big = (a > b) ? a : b;
+      if (!((big >= lo) && (big <= hi)) && (big != 0.0))
+        y[i + k] = std::abs(x[i + k]);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// Fast tier
+// ----------------------------------------------------------------------
+
+vec fast_exp(const vec &x) { return details::vmath_apply(vmath_exp, x, VMATH_FAST); }
+mat fast_exp(const mat &x) { return details::vmath_apply(vmath_exp, x, VMATH_FAST); }
+vec fast_log(const vec &x) { return details::vmath_apply(vmath_log, x, VMATH_FAST); }
+mat fast_log(const mat &x) { return details::vmath_apply(vmath_log, x, VMATH_FAST); }
+vec fast_sin(const vec &x) { return details::vmath_apply(vmath_sin, x, VMATH_FAST); }
+mat fast_sin(const mat &x) { return details::vmath_apply(vmath_sin, x, VMATH_FAST); }
+vec fast_cos(const vec &x) { return details::vmath_apply(vmath_cos, x, VMATH_FAST); }
+mat fast_cos(const mat &x) { return details::vmath_apply(vmath_cos, x, VMATH_FAST); }
+vec fast_tanh(const vec &x) { return details::vmath_apply(vmath_tanh, x, VMATH_FAST); }
+mat fast_tanh(const mat &x) { return details::vmath_apply(vmath_tanh, x, VMATH_FAST); }
+
+vec fast_pow(const vec &x, double y)
+{
+  vec out(x.size());
+  vmath_pow(x._data(), y, out._data(), x.size(), VMATH_FAST);
+  return out;
+}
+
+mat fast_pow(const mat &x, double y)
+{
+  mat out(x.rows(), x.cols());
+  vmath_pow(x._data(), y, out._data(), x.size(), VMATH_FAST);
+  return out;
+}
+
+} // namespace itpp
+
+//! \endcond
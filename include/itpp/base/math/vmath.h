@@ -0,0 +1,186 @@
+/*!
+ * \file
+ * \brief Vectorized elementwise exponential, logarithmic, trigonometric
+ * and hyperbolic functions
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef VMATH_H
+#define VMATH_H
+
+#include <itpp/base/vec.h>
+#include <itpp/base/mat.h>
+#include <itpp/itexports.h>
+#include <complex>
+
+
+namespace itpp
+{
+
+/*!
+  \addtogroup miscfunc
+
+  \section vmath Vectorized elementwise functions
+
+  exp(), log(), sin(), cos(), tanh(), sqrt(), abs() and pow() with a scalar
+  exponent on vec and mat, as well as exp() and abs() on cvec and cmat, are
+  computed several elements at a time with SSE2, AVX2 or AVX-512
+  instructions. The instruction set is chosen at run time according to the
+  processor (see vmath_isa()); other processors and compilers use the same
+  algorithms one element at a time.
+
+  Two accuracy tiers are available. The default one is accurate to a few
+  units in the last place (ULPs), the following maxima being measured with
+  every instruction set over 3 10^6 random arguments against long double
+  references:
+
+  <table>
+  <tr><th>Function</th><th>Accurate tier</th><th>Fast tier</th></tr>
+  <tr><td>exp</td><td>1 ULP</td><td>relative error 3e-10</td></tr>
+  <tr><td>log</td><td>1 ULP</td><td>absolute error 1e-9</td></tr>
+  <tr><td>sin, cos</td><td>1 ULP</td><td>relative error 3e-9</td></tr>
+  <tr><td>tanh</td><td>2.5 ULP</td><td>relative error 5e-9</td></tr>
+  <tr><td>pow</td><td>as std::pow()</td><td>relative error 1e-9 (1 + |y|)</td></tr>
+  <tr><td>sqrt, abs</td><td>exact</td><td>exact</td></tr>
+  <tr><td>abs (complex)</td><td>1.5 ULP</td><td>1.5 ULP</td></tr>
+  <tr><td>exp (complex)</td><td>2.5 ULP per part</td><td>as exp, sin and cos</td></tr>
+  </table>
+
+  Arguments out of the ranges of the vectorized algorithms (NaN, infinite
+  and denormal ones, x out of [-708, 709] for exp(), |x| > 1e6 for sin()
+  and cos()) are computed with the standard library, so that the special
+  cases behave as in \<cmath\>. In the accurate tier pow() is vectorized
+  for the exponents 2, 1, 0.5 and -1 only. Results may differ in the last
+  bit between instruction sets, as the compiler may use fused multiply-add
+  operations with AVX2 and AVX-512.
+
+  The fast tier trades accuracy for speed and is selected explicitly with
+  the fast_exp(), fast_log(), fast_sin(), fast_cos(), fast_tanh() and
+  fast_pow() functions, or the \c VMATH_FAST argument of the raw kernels.
+*/
+//!@{
+
+//! Accuracy tiers of the vectorized elementwise functions
+enum Vmath_Accuracy {
+  VMATH_ACCURATE = 0, //!< A few ULPs, see the table above
+  VMATH_FAST = 1      //!< Lower degree approximations
+};
+
+//! Instruction sets of the vectorized elementwise functions
+enum Vmath_Isa {
+  VMATH_GENERIC = 0, //!< Portable code, one element at a time
+  VMATH_SSE2 = 1,    //!< Two elements at a time
+  VMATH_AVX2 = 2,    //!< Four elements at a time, with FMA
+  VMATH_AVX512 = 3   //!< Eight elements at a time
+};
+
+//! Instruction set used by the vectorized elementwise functions
+ITPP_EXPORT Vmath_Isa vmath_isa();
+
+/*!
+  \brief Limit the instruction set of the vectorized elementwise functions
+
+  The best instruction set supported by the processor, up to \c max_isa,
+  is used from now on by all threads. This is mainly useful for testing and
+  for reproducing results between machines.
+
+  \return The instruction set now in use
+*/
+ITPP_EXPORT Vmath_Isa set_vmath_isa(Vmath_Isa max_isa);
+
+//! y[i] = exp(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_exp(const double *x, double *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = log(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_log(const double *x, double *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = sin(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_sin(const double *x, double *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = cos(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_cos(const double *x, double *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = tanh(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_tanh(const double *x, double *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = pow(x[i], e) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_pow(const double *x, double e, double *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = sqrt(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_sqrt(const double *x, double *y, int n);
+//! y[i] = fabs(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_abs(const double *x, double *y, int n);
+//! y[i] = exp(x[i]) for 0 <= i < n. \c x and \c y may be the same array
+ITPP_EXPORT void vmath_exp(const std::complex<double> *x, std::complex<double> *y, int n, Vmath_Accuracy acc = VMATH_ACCURATE);
+//! y[i] = abs(x[i]) for 0 <= i < n
+ITPP_EXPORT void vmath_abs(const std::complex<double> *x, double *y, int n);
+
+//! Exp of the elements of \c x, fast tier
+ITPP_EXPORT vec fast_exp(const vec &x);
+//! Exp of the elements of \c x, fast tier
+ITPP_EXPORT mat fast_exp(const mat &x);
+//! Natural logarithm of the elements of \c x, fast tier
+ITPP_EXPORT vec fast_log(const vec &x);
+//! Natural logarithm of the elements of \c x, fast tier
+ITPP_EXPORT mat fast_log(const mat &x);
+//! Sine of the elements of \c x, fast tier
+ITPP_EXPORT vec fast_sin(const vec &x);
+//! Sine of the elements of \c x, fast tier
+ITPP_EXPORT mat fast_sin(const mat &x);
+//! Cosine of the elements of \c x, fast tier
+ITPP_EXPORT vec fast_cos(const vec &x);
+//! Cosine of the elements of \c x, fast tier
+ITPP_EXPORT mat fast_cos(const mat &x);
+//! Hyperbolic tangent of the elements of \c x, fast tier
+ITPP_EXPORT vec fast_tanh(const vec &x);
+//! Hyperbolic tangent of the elements of \c x, fast tier
+ITPP_EXPORT mat fast_tanh(const mat &x);
+//! The elements of \c x to the power \c y, fast tier
+ITPP_EXPORT vec fast_pow(const vec &x, double y);
+//! The elements of \c x to the power \c y, fast tier
+ITPP_EXPORT mat fast_pow(const mat &x, double y);
+
+//!@}
+
+//! \cond
+namespace details
+{
+// out = f(x) elementwise with one of the vmath kernels
+template<class T>
+inline Vec<T> vmath_apply(void (*f)(const T *, T *, int, Vmath_Accuracy), const Vec<T> &x,
+                          Vmath_Accuracy acc = VMATH_ACCURATE)
+{
+  Vec<T> out(x.size());
+  f(x._data(), out._data(), x.size(), acc);
+  return out;
+}
+
+template<class T>
+inline Mat<T> vmath_apply(void (*f)(const T *, T *, int, Vmath_Accuracy), const Mat<T> &x,
+                          Vmath_Accuracy acc = VMATH_ACCURATE)
+{
+  Mat<T> out(x.rows(), x.cols());
+  f(x._data(), out._data(), x.size(), acc);
+  return out;
+}
+}
+//! \endcond
+
+} // namespace itpp
+
+#endif // #ifndef VMATH_H
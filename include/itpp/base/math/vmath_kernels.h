@@ -0,0 +1,453 @@
+/*!
+ * \file
+ * \brief Kernels of the vectorized elementwise functions
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+// No include guard: this file is included by vmath.cpp once for each
+// instruction set, in a namespace defining the type Pack of the packs of
+// doubles, vm_sqrt(Pack), and vm_all() and vm_any() of the comparison
+// results. The constants, the Vm_Pack traits and the operation codes Vm_Op
+// are defined in vmath.cpp.
+
+// ----------------------------------------------------------------------
+// Pack operations
+// ----------------------------------------------------------------------
+
+template<class V>
+VMATH_INLINE V vm_load(const double *p)
+{
+  V v;
+  std::memcpy(&v, p, sizeof(V));
+  return v;
+}
+
+template<class V>
+VMATH_INLINE void vm_store(double *p, V v)
+{
+  std::memcpy(p, &v, sizeof(V));
+}
+
+template<class V>
+VMATH_INLINE V vm_set(double c)
+{
+  return V() + c;
+}
+
+template<class V>
+VMATH_INLINE typename Vm_Pack<V>::U vm_bits(V v)
+{
+  typename Vm_Pack<V>::U u;
+  std::memcpy(&u, &v, sizeof(V));
+  return u;
+}
+
+template<class V>
+VMATH_INLINE V vm_from_bits(typename Vm_Pack<V>::U u)
+{
+  V v;
+  std::memcpy(&v, &u, sizeof(V));
+  return v;
+}
+
+template<class V, class M>
+VMATH_INLINE V vm_select(M m, V a, V b)
+{
+  return m ? a : b;
+}
+
+VMATH_INLINE bool vm_lane(bool m, int) { return m; }
+template<class M>
+VMATH_INLINE bool vm_lane(M m, int l) { return m[l] != 0; }
+
+// ----------------------------------------------------------------------
+// Kernels
+// ----------------------------------------------------------------------
+
+// Each kernel computes a pack of results, with ok false in the lanes to be
+// computed by scalar() instead
+
+// exp(x) for vm_exp_min <= x <= vm_exp_max: x = k ln(2) + r with |r| <=
+// ln(2)/2, and exp(r) by its Taylor series
+template<bool Fast, class V>
+VMATH_INLINE V vm_exp_core(V x)
+{
+  typedef typename Vm_Pack<V>::U U;
+  V t = x * vm_log2e + vm_round;
+  V k = t - vm_round;
+  U ki = vm_bits(t) - vm_round_bits;
+  V r = (x - k * vm_ln2_hi) - k * vm_ln2_lo;
+  V p;
+  if (Fast) {
+    p = r * (1.0 / 40320) + (1.0 / 5040);
+    p = p * r + (1.0 / 720);
+    p = p * r + (1.0 / 120);
+    p = p * r + (1.0 / 24);
+  }
+  else {
+    p = r * (1.0 / 6227020800.0) + (1.0 / 479001600.0);
+    p = p * r + (1.0 / 39916800.0);
+    p = p * r + (1.0 / 3628800.0);
+    p = p * r + (1.0 / 362880.0);
+    p = p * r + (1.0 / 40320);
+    p = p * r + (1.0 / 5040);
+    p = p * r + (1.0 / 720);
+    p = p * r + (1.0 / 120);
+    p = p * r + (1.0 / 24);
+  }
+  p = p * r + (1.0 / 6);
+  p = p * r + 0.5;
+  p = (p * r) * r + r + 1.0;
+  return p * vm_from_bits<V>((ki + 1023ULL) << 52);
+}
+
+// log(x) for normal positive x: x = 2^e (1 + f) with sqrt(2)/2 <= 1 + f <
+// sqrt(2), and log(1 + f) = 2 atanh(s) with s = f / (2 + f), as in fdlibm
+template<bool Fast, class V>
+VMATH_INLINE V vm_log_core(V x)
+{
+  typedef typename Vm_Pack<V>::U U;
+  typedef typename Vm_Pack<V>::M M;
+  U b = vm_bits(x);
+  V e = vm_from_bits<V>((b >> 52) | vm_two52_bits) - (vm_two52 + 1023.0);
+  V m = vm_from_bits<V>((b & vm_mantissa_bits) | vm_one_bits);
+  M big = (m > vm_sqrt2);
+  m = vm_select(big, m * 0.5, m);
+  e = vm_select(big, e + 1.0, e);
+  V f = m - 1.0;
+  V hfsq = (0.5 * f) * f;
+  V s = f / (f + 2.0);
+  V z = s * s;
+  V R;
+  if (Fast) {
+    R = z * (2.0 / 9) + (2.0 / 7);
+  }
+  else {
+    R = z * (2.0 / 21) + (2.0 / 19);
+    R = R * z + (2.0 / 17);
+    R = R * z + (2.0 / 15);
+    R = R * z + (2.0 / 13);
+    R = R * z + (2.0 / 11);
+    R = R * z + (2.0 / 9);
+    R = R * z + (2.0 / 7);
+  }
+  R = R * z + (2.0 / 5);
+  R = R * z + (2.0 / 3);
+  R = R * z;
+  return e * vm_ln2_hi - ((hfsq - (s * (hfsq + R) + e * vm_ln2_lo)) - f);
+}
+
+// sin(x) or cos(x) for |x| <= vm_trig_max: x = j pi/2 + r with |r| <=
+// pi/4, and sin(r), cos(r) by their Taylor series
+template<bool Fast, bool Cos, class V>
+VMATH_INLINE V vm_sincos_core(V x)
+{
+  typedef typename Vm_Pack<V>::M M;
+  V j = (x * vm_two_over_pi + vm_round) - vm_round;
+  // x - j pi/2 = r + rl, rl holding the rounding errors of the reduction
+  V a = x - j * vm_pio2_1;
+  V b = j * vm_pio2_2;
+  V r1 = a - b;
+  V bb = a - r1;
+  V rl = (a - (r1 + bb)) + (bb - b);
+  V c = j * vm_pio2_3;
+  V r = r1 - c;
+  rl = rl + ((r1 - r) - c);
+  V s = r * r;
+  V hs = 0.5 * s;
+  V ps, pc;
+  if (Fast) {
+    ps = s * (1.0 / 362880.0) - (1.0 / 5040);
+    pc = s * (-1.0 / 3628800.0) + (1.0 / 40320);
+  }
+  else {
+    ps = s * (1.0 / 355687428096000.0) - (1.0 / 1307674368000.0);
+    ps = ps * s + (1.0 / 6227020800.0);
+    ps = ps * s - (1.0 / 39916800.0);
+    ps = ps * s + (1.0 / 362880.0);
+    ps = ps * s - (1.0 / 5040);
+    pc = s * (1.0 / 20922789888000.0) - (1.0 / 87178291200.0);
+    pc = pc * s + (1.0 / 479001600.0);
+    pc = pc * s - (1.0 / 3628800.0);
+    pc = pc * s + (1.0 / 40320);
+  }
+  ps = ps * s + (1.0 / 120);
+  ps = ps * s - (1.0 / 6);
+  V sin_r = r + ((r * s) * ps + rl * (1.0 - hs));
+  pc = pc * s - (1.0 / 720);
+  pc = pc * s + (1.0 / 24);
+  // 1 - s/2 with its rounding error, as in fdlibm
+  V w = 1.0 - hs;
+  V cos_r = w + (((1.0 - w) - hs) + ((s * s) * pc - r * rl));
+  // Quadrant j mod 4 = odd + 2 half, without integer conversions
+  V h = (j * 0.5 - 0.25 + vm_round) - vm_round;
+  V odd = j - 2.0 * h;
+  V half = h - 2.0 * ((h * 0.5 - 0.25 + vm_round) - vm_round);
+  M odd_m = (odd > 0.5);
+  if (Cos) {
+    V neg = odd + half - 2.0 * odd * half;
+    return vm_select(odd_m, sin_r, cos_r) * (1.0 - 2.0 * neg);
+  }
+  return vm_select(odd_m, cos_r, sin_r) * (1.0 - 2.0 * half);
+}
+
+template<bool Fast>
+struct Vm_Exp
+{
+  double scalar(double x) const { return std::exp(x); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x >= vm_exp_min) & (x <= vm_exp_max);
+    return vm_exp_core<Fast>(vm_select(ok, x, V()));
+  }
+};
+
+template<bool Fast>
+struct Vm_Log
+{
+  double scalar(double x) const { return std::log(x); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x >= std::numeric_limits<double>::min()) & (x <= std::numeric_limits<double>::max());
+    return vm_log_core<Fast>(vm_select(ok, x, vm_set<V>(1.0)));
+  }
+};
+
+template<bool Fast, bool Cos>
+struct Vm_Sincos
+{
+  double scalar(double x) const { return Cos ? std::cos(x) : std::sin(x); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x >= -vm_trig_max) & (x <= vm_trig_max);
+    V r = vm_sincos_core<Fast, Cos>(vm_select(ok, x, V()));
+    // sin(-0) = -0
+    return Cos ? r : vm_select(x == 0.0, x, r);
+  }
+};
+
+// tanh(x) = sign(x) e / (e + 2) with e = expm1(2 |x|), from its Taylor
+// series below ln(2) and from exp() above
+template<bool Fast>
+struct Vm_Tanh
+{
+  double scalar(double x) const { return std::tanh(x); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    typedef typename Vm_Pack<V>::U U;
+    typedef typename Vm_Pack<V>::M M;
+    ok = (x == x);
+    U sign = vm_bits(x) & vm_sign_bit;
+    V a = vm_from_bits<V>(vm_bits(x) & ~vm_sign_bit);
+    M sat = (a > vm_tanh_max);
+    V y = 2.0 * vm_select(a <= vm_tanh_max, a, V());
+    M small = (y < vm_ln2_hi);
+    V em = V();
+    if (vm_any(small)) {
+      V p;
+      if (Fast) {
+        p = y * (1.0 / 362880.0) + (1.0 / 40320);
+      }
+      else {
+        p = y * (1.0 / 355687428096000.0) + (1.0 / 20922789888000.0);
+        p = p * y + (1.0 / 1307674368000.0);
+        p = p * y + (1.0 / 87178291200.0);
+        p = p * y + (1.0 / 6227020800.0);
+        p = p * y + (1.0 / 479001600.0);
+        p = p * y + (1.0 / 39916800.0);
+        p = p * y + (1.0 / 3628800.0);
+        p = p * y + (1.0 / 362880.0);
+        p = p * y + (1.0 / 40320);
+      }
+      p = p * y + (1.0 / 5040);
+      p = p * y + (1.0 / 720);
+      p = p * y + (1.0 / 120);
+      p = p * y + (1.0 / 24);
+      p = p * y + (1.0 / 6);
+      p = p * y + 0.5;
+      em = (y * y) * p + y;
+    }
+    if (!vm_all(small))
+      em = vm_select(small, em, vm_exp_core<Fast>(y) - 1.0);
+    V t = vm_select(sat, vm_set<V>(1.0), em / (em + 2.0));
+    return vm_from_bits<V>(vm_bits(t) | sign);
+  }
+};
+
+struct Vm_Sqrt
+{
+  double scalar(double x) const { return std::sqrt(x); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x >= 0.0);
+    return vm_sqrt(vm_select(ok, x, V()));
+  }
+};
+
+struct Vm_Abs
+{
+  double scalar(double x) const { return std::fabs(x); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x == x) | (x != x);
+    return vm_from_bits<V>(vm_bits(x) & ~vm_sign_bit);
+  }
+};
+
+// pow(x, e) for the exponents with exact shortcuts, and exp(e log(x)) for
+// positive x in the fast tier
+struct Vm_Square
+{
+  double scalar(double x) const { return x * x; }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x == x) | (x != x);
+    return x * x;
+  }
+};
+
+struct Vm_Inverse
+{
+  double scalar(double x) const { return 1.0 / x; }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x == x) | (x != x);
+    return 1.0 / x;
+  }
+};
+
+struct Vm_Pow_Half
+{
+  double scalar(double x) const { return std::pow(x, 0.5); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x > 0.0);
+    return vm_sqrt(vm_select(ok, x, V()));
+  }
+};
+
+struct Vm_Pow_Fast
+{
+  Vm_Pow_Fast(double y) : e(y) {}
+  double e;
+  double scalar(double x) const { return std::pow(x, e); }
+  template<class V>
+  VMATH_INLINE V apply(const V &x, typename Vm_Pack<V>::M &ok) const {
+    ok = (x >= std::numeric_limits<double>::min()) & (x <= std::numeric_limits<double>::max());
+    V t = e * vm_log_core<true>(vm_select(ok, x, vm_set<V>(1.0)));
+    ok = ok & (t >= vm_exp_min) & (t <= vm_exp_max);
+    return vm_exp_core<true>(vm_select(ok, t, V()));
+  }
+};
+
+// ----------------------------------------------------------------------
+// Drivers
+// ----------------------------------------------------------------------
+
+template<class V, class K>
+VMATH_INLINE void vm_block(const K &k, const double *x, double *y)
+{
+  const int w = Vm_Pack<V>::width;
+  typename Vm_Pack<V>::M ok;
+  V xv = vm_load<V>(x);
+  V r = k.apply(xv, ok);
+  if (vm_all(ok)) {
+    vm_store(y, r);
+  }
+  else {
+    // x and y may be the same array
+    double xs[w];
+    vm_store(xs, xv);
+    vm_store(y, r);
+    for (int l = 0; l < w; l++)
+      if (!vm_lane(ok, l))
+        y[l] = k.scalar(xs[l]);
+  }
+}
+
+template<class V, class K>
+VMATH_INLINE void vm_map(const K &k, const double *x, double *y, int n)
+{
+  const int w = Vm_Pack<V>::width;
+  int i = 0;
+  for (; i + w <= n; i += w)
+    vm_block<V>(k, x + i, y + i);
+  if (i < n) {
+    // The tail is padded with ones, in the range of all the kernels
+    double xb[w], yb[w];
+    for (int l = 0; l < w; l++)
+      xb[l] = (i + l < n) ? x[i + l] : 1.0;
+    vm_block<V>(k, xb, yb);
+    for (int l = 0; i + l < n; l++)
+      y[i + l] = yb[l];
+  }
+}
+
+// y = op(x) with the packs of this instruction set
+static void vm_run(int op, bool fast, const double *x, double *y, int n, double e)
+{
+  switch (op) {
+  case VM_EXP:
+    if (fast) vm_map<Pack>(Vm_Exp<true>(), x, y, n);
+    else vm_map<Pack>(Vm_Exp<false>(), x, y, n);
+    break;
+  case VM_LOG:
+    if (fast) vm_map<Pack>(Vm_Log<true>(), x, y, n);
+    else vm_map<Pack>(Vm_Log<false>(), x, y, n);
+    break;
+  case VM_SIN:
+    if (fast) vm_map<Pack>(Vm_Sincos<true, false>(), x, y, n);
+    else vm_map<Pack>(Vm_Sincos<false, false>(), x, y, n);
+    break;
+  case VM_COS:
+    if (fast) vm_map<Pack>(Vm_Sincos<true, true>(), x, y, n);
+    else vm_map<Pack>(Vm_Sincos<false, true>(), x, y, n);
+    break;
+  case VM_TANH:
+    if (fast) vm_map<Pack>(Vm_Tanh<true>(), x, y, n);
+    else vm_map<Pack>(Vm_Tanh<false>(), x, y, n);
+    break;
+  case VM_POW:
+    if (e == 2.0)
+      vm_map<Pack>(Vm_Square(), x, y, n);
+    else if (e == -1.0)
+      vm_map<Pack>(Vm_Inverse(), x, y, n);
+    else if (e == 0.5)
+      vm_map<Pack>(Vm_Pow_Half(), x, y, n);
+    else if (e == 1.0) {
+      if (x != y) std::memmove(y, x, n * sizeof(double));
+    }
+    else if (fast)
+      vm_map<Pack>(Vm_Pow_Fast(e), x, y, n);
+    else
+      for (int i = 0; i < n; i++) y[i] = std::pow(x[i], e);
+    break;
+  case VM_SQRT:
+    vm_map<Pack>(Vm_Sqrt(), x, y, n);
+    break;
+  case VM_ABS:
+    vm_map<Pack>(Vm_Abs(), x, y, n);
+    break;
+  }
+}
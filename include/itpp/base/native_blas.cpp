@@ -0,0 +1,689 @@
+/*!
+ * \file
+ * \brief Built-in BLAS routines used when no BLAS library is available
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/base/native_blas.h>
+#include <itpp/base/math/vmath.h>
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+// The kernels of native_blas_kernels.h are compiled for each instruction
+// set as those of vmath.cpp, and chosen with vmath_isa()
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define NB_X86
+#  include <immintrin.h>
+// The packs are inlined, never passed between functions
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__GNUC__)
+#  define NB_INLINE inline __attribute__((always_inline))
+#  define NB_UNROLL _Pragma("GCC unroll 16")
+#elif defined(_MSC_VER)
+#  define NB_INLINE __forceinline
+#  define NB_UNROLL
+#else
+#  define NB_INLINE inline
+#  define NB_UNROLL
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+namespace native_blas
+{
+
+// ----------------------------------------------------------------------
+// Kernels of each instruction set
+// ----------------------------------------------------------------------
+
+// Tile sizes and kernels. dmr x dnr is the size of the real tiles, zmr x
+// znr that of the complex ones.
+struct Nb_Kernels
+{
+  int dmr, dnr, zmr, znr;
+  void (*dgemm_block)(int, int, int, double, const double *, const double *,
+                      double *, int);
+  void (*zgemm_block)(int, int, int, std::complex<double>, const double *,
+                      const double *, std::complex<double> *, int);
+  void (*dgemv_n)(int, int, const double *, int, const double *, double *);
+  void (*dgemv_t)(int, int, double, const double *, int, const double *,
+                  double *);
+  void (*daxpy)(int, double, const double *, double *);
+};
+
+namespace nb_generic
+{
+typedef double Pack;
+static const int nb_drows = 4;
+static const int nb_dcols = 4;
+static const int nb_zrows = 2;
+static const int nb_zcols = 2;
+NB_INLINE double nb_fma(double a, double b, double c) { return c + a * b; }
+NB_INLINE double nb_fnma(double a, double b, double c) { return c - a * b; }
+#include <itpp/base/native_blas_kernels.h>
+}
+
+#if defined(NB_X86)
+typedef double nb_v2 __attribute__((vector_size(16)));
+typedef double nb_v4 __attribute__((vector_size(32)));
+typedef double nb_v8 __attribute__((vector_size(64)));
+
+namespace nb_sse2
+{
+typedef nb_v2 Pack;
+static const int nb_drows = 2;
+static const int nb_dcols = 6;
+static const int nb_zrows = 1;
+static const int nb_zcols = 4;
+NB_INLINE nb_v2 nb_fma(nb_v2 a, nb_v2 b, nb_v2 c) { return c + a * b; }
+NB_INLINE nb_v2 nb_fnma(nb_v2 a, nb_v2 b, nb_v2 c) { return c - a * b; }
+#include <itpp/base/native_blas_kernels.h>
+}
+
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx2,fma")
+#endif
+namespace nb_avx2
+{
+typedef nb_v4 Pack;
+static const int nb_drows = 2;
+static const int nb_dcols = 6;
+static const int nb_zrows = 1;
+static const int nb_zcols = 4;
+NB_INLINE nb_v4 nb_fma(nb_v4 a, nb_v4 b, nb_v4 c) { return _mm256_fmadd_pd(a, b, c); }
+NB_INLINE nb_v4 nb_fnma(nb_v4 a, nb_v4 b, nb_v4 c) { return _mm256_fnmadd_pd(a, b, c); }
+#include <itpp/base/native_blas_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+
+// With 32 registers the tiles of AVX-512 are larger
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx512f")
+#endif
+namespace nb_avx512
+{
+typedef nb_v8 Pack;
+static const int nb_drows = 3;
+static const int nb_dcols = 6;
+static const int nb_zrows = 2;
+static const int nb_zcols = 4;
+NB_INLINE nb_v8 nb_fma(nb_v8 a, nb_v8 b, nb_v8 c) { return _mm512_fmadd_pd(a, b, c); }
+NB_INLINE nb_v8 nb_fnma(nb_v8 a, nb_v8 b, nb_v8 c) { return _mm512_fnmadd_pd(a, b, c); }
+#include <itpp/base/native_blas_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+#endif // NB_X86
+
+static const Nb_Kernels &nb_kernels()
+{
+  switch (vmath_isa()) {
+#if defined(NB_X86)
+  case VMATH_AVX512:
+    return nb_avx512::nb_kernels;
+  case VMATH_AVX2:
+    return nb_avx2::nb_kernels;
+  case VMATH_SSE2:
+    return nb_sse2::nb_kernels;
+#endif
+  default:
+    return nb_generic::nb_kernels;
+  }
+}
+
+// ----------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------
+
+// Blocking of GEMM, in doubles: a block of op(A) has nb_mc rows and nb_kc
+// doubles per row so as to stay in the L2 cache, a block of op(B) nb_kc
+// doubles per column and nb_nc columns
+static const int nb_mc = 96;
+static const int nb_kc = 256;
+static const int nb_nc = 2048;
+
+// Products smaller than this number of multiplications are not packed
+static const double nb_small = 4096.0;
+
+// Least number of multiplications given to a thread
+static const double nb_gemm_work = 2097152.0;
+static const double nb_level2_work = 65536.0;
+
+// Rows of y updated at a time by GEMV
+static const int nb_gemv_rows = 2048;
+
+// Storage of the packed panels, aligned on 64 bytes
+class Nb_Buffer
+{
+public:
+  explicit Nb_Buffer(std::size_t n) : raw(operator new(n * sizeof(double) + 63)) {}
+  ~Nb_Buffer() { operator delete(raw); }
+  double *data() {
+    return reinterpret_cast<double *>((reinterpret_cast<std::size_t>(raw) + 63)
+                                      & ~std::size_t(63));
+  }
+private:
+  Nb_Buffer(const Nb_Buffer &);
+  Nb_Buffer &operator=(const Nb_Buffer &);
+  void *raw;
+};
+
+// Threads for the given number of multiplications
+static int nb_threads(double work, double per_thread)
+{
+  int max_t = 1;
+#ifdef _OPENMP
+  if (!omp_in_parallel())
+    max_t = omp_get_max_threads();
+#endif
+  double t = work / per_thread;
+  return (t < 1.0) ? 1 : ((t > max_t) ? max_t : int(t));
+}
+
+inline double nb_conj(double x) { return x; }
+inline std::complex<double> nb_conj(const std::complex<double> &x) { return std::conj(x); }
+
+// op(A)(i, l)
+template<class T>
+inline T nb_op(char trans, const T *A, int ldA, int i, int l)
+{
+  if (trans == 'n')
+    return A[i + l * ldA];
+  else if (trans == 't')
+    return A[l + i * ldA];
+  else
+    return nb_conj(A[l + i * ldA]);
+}
+
+// Stores v in a packed panel, the imaginary part im doubles after the real
+// one and conjugated if conj
+inline void nb_put(double *p, int, double v, bool)
+{
+  *p = v;
+}
+
+inline void nb_put(double *p, int im, const std::complex<double> &v, bool conj)
+{
+  p[0] = v.real();
+  p[im] = conj ? -v.imag() : v.imag();
+}
+
+// Contiguous copy of the vector x of increment inc, or x itself
+template<class T>
+static const T *nb_gather(int n, const T *x, int inc, T *buf)
+{
+  if (inc == 1)
+    return x;
+  const T *p = (inc < 0) ? x - (n - 1) * inc : x;
+  for (int i = 0; i < n; i++)
+    buf[i] = p[i * inc];
+  return buf;
+}
+
+template<class T>
+static void nb_scatter(int n, const T *buf, T *x, int inc)
+{
+  T *p = (inc < 0) ? x - (n - 1) * inc : x;
+  for (int i = 0; i < n; i++)
+    p[i * inc] = buf[i];
+}
+
+// x = beta * x for n elements
+template<class T>
+static void nb_scale(int n, T beta, T *x)
+{
+  if (beta == T(1))
+    return;
+  if (beta == T(0)) {
+    for (int i = 0; i < n; i++)
+      x[i] = T(0);
+  }
+  else {
+    for (int i = 0; i < n; i++)
+      x[i] *= beta;
+  }
+}
+
+// ----------------------------------------------------------------------
+// GEMM
+// ----------------------------------------------------------------------
+
+// Packs the m x k block of op(A) starting at A in panels of mr rows, the
+// rows beyond m being zero
+template<class T>
+static void nb_pack_a(char trans, int m, int k, const T *A, int ldA, int mr,
+                      double *pa)
+{
+  const int s = sizeof(T) / sizeof(double);
+  for (int i0 = 0; i0 < m; i0 += mr) {
+    int m1 = std::min(mr, m - i0);
+    double *p = pa + i0 * k * s;
+    if (trans == 'n') {
+      for (int l = 0; l < k; l++) {
+        const T *a = A + i0 + l * ldA;
+        double *q = p + l * mr * s;
+        for (int i = 0; i < m1; i++)
+          nb_put(q + i, mr, a[i], false);
+      }
+    }
+    else {
+      for (int i = 0; i < m1; i++) {
+        const T *a = A + (i0 + i) * ldA;
+        for (int l = 0; l < k; l++)
+          nb_put(p + l * mr * s + i, mr, a[l], trans == 'c');
+      }
+    }
+    for (int l = 0; l < k; l++)
+      for (int i = m1; i < mr; i++)
+        nb_put(p + l * mr * s + i, mr, T(0), false);
+  }
+}
+
+// Packs the columns j0 to j0 + n - 1 of the k x nc block of op(B) starting
+// at B in a panel of nr columns, the columns beyond n being zero
+template<class T>
+static void nb_pack_b(char trans, int k, int j0, int n, const T *B, int ldB,
+                      int nr, double *p)
+{
+  const int s = sizeof(T) / sizeof(double);
+  if (trans == 'n') {
+    for (int j = 0; j < n; j++) {
+      const T *b = B + (j0 + j) * ldB;
+      for (int l = 0; l < k; l++)
+        nb_put(p + l * nr * s + j, nr, b[l], false);
+    }
+  }
+  else {
+    for (int l = 0; l < k; l++) {
+      const T *b = B + l * ldB + j0;
+      for (int j = 0; j < n; j++)
+        nb_put(p + l * nr * s + j, nr, b[j], trans == 'c');
+    }
+  }
+  for (int l = 0; l < k; l++)
+    for (int j = n; j < nr; j++)
+      nb_put(p + l * nr * s + j, nr, T(0), false);
+}
+
+static void nb_block(const Nb_Kernels &kr, int m, int n, int k, double alpha,
+                     const double *pa, const double *pb, double *C, int ldC)
+{
+  kr.dgemm_block(m, n, k, alpha, pa, pb, C, ldC);
+}
+
+static void nb_block(const Nb_Kernels &kr, int m, int n, int k,
+                     std::complex<double> alpha, const double *pa,
+                     const double *pb, std::complex<double> *C, int ldC)
+{
+  kr.zgemm_block(m, n, k, alpha, pa, pb, C, ldC);
+}
+
+// C += alpha * op(A) * op(B) without packing, for small products
+template<class T>
+static void nb_gemm_small(char transA, char transB, int m, int n, int k,
+                          T alpha, const T *A, int ldA, const T *B, int ldB,
+                          T *C, int ldC)
+{
+  for (int j = 0; j < n; j++) {
+    T *c = C + j * ldC;
+    for (int l = 0; l < k; l++) {
+      T b = alpha * nb_op(transB, B, ldB, l, j);
+      for (int i = 0; i < m; i++)
+        c[i] += nb_op(transA, A, ldA, i, l) * b;
+    }
+  }
+}
+
+template<class T>
+static void nb_gemm(char transA, char transB, int m, int n, int k, T alpha,
+                    const T *A, int ldA, const T *B, int ldB, T beta, T *C,
+                    int ldC)
+{
+  if ((m <= 0) || (n <= 0))
+    return;
+  for (int j = 0; j < n; j++)
+    nb_scale(m, beta, C + j * ldC);
+  if ((k <= 0) || (alpha == T(0)))
+    return;
+  double work = double(m) * n * k;
+  if (work < nb_small) {
+    nb_gemm_small(transA, transB, m, n, k, alpha, A, ldA, B, ldB, C, ldC);
+    return;
+  }
+
+  const Nb_Kernels &kr = nb_kernels();
+  const int s = sizeof(T) / sizeof(double);
+  const int mr = (s == 1) ? kr.dmr : kr.zmr;
+  const int nr = (s == 1) ? kr.dnr : kr.znr;
+  const int kc_max = nb_kc / s;
+  const int nc_max = (nb_nc / s / nr) * nr;
+  const int mc_max = (nb_mc / mr) * mr;
+  const int kc0 = std::min(k, kc_max);
+  const int nc0 = std::min((n + nr - 1) / nr * nr, nc_max);
+
+  // The threads share the packed block of op(B), and take blocks of rows
+  // of op(A) and groups of columns of op(B) in turn
+  int nt = nb_threads(work, nb_gemm_work);
+  int chunk = (nt > 1) ? std::max(nr, (nb_mc / s) / nr * nr) : nc0;
+  Nb_Buffer pb_buf(std::size_t(kc0) * nc0 * s);
+  double *pb = pb_buf.data();
+
+#ifdef _OPENMP
+  #pragma omp parallel num_threads(nt) if (nt > 1)
+#endif
+  {
+    Nb_Buffer pa_buf(std::size_t(mc_max) * kc0 * s);
+    double *pa = pa_buf.data();
+    for (int jc = 0; jc < n; jc += nc_max) {
+      int nc = std::min(nc_max, n - jc);
+      for (int pc = 0; pc < k; pc += kc_max) {
+        int kc = std::min(kc_max, k - pc);
+        const T *b = (transB == 'n') ? B + pc + jc * ldB : B + jc + pc * ldB;
+        int panels = (nc + nr - 1) / nr;
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (int p = 0; p < panels; p++)
+          nb_pack_b(transB, kc, p * nr, std::min(nr, nc - p * nr), b, ldB, nr,
+                    pb + p * nr * kc * s);
+
+        int row_blocks = (m + mc_max - 1) / mc_max;
+        int col_blocks = (nc + chunk - 1) / chunk;
+        int packed = -1;
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (int w = 0; w < row_blocks * col_blocks; w++) {
+          int ic = (w / col_blocks) * mc_max;
+          int jr = (w % col_blocks) * chunk;
+          int mc = std::min(mc_max, m - ic);
+          if (ic != packed) {
+            const T *a = (transA == 'n') ? A + ic + pc * ldA : A + pc + ic * ldA;
+            nb_pack_a(transA, mc, kc, a, ldA, mr, pa);
+            packed = ic;
+          }
+          nb_block(kr, mc, std::min(chunk, nc - jr), kc, alpha, pa,
+                   pb + jr * kc * s, C + ic + (jc + jr) * ldC, ldC);
+        }
+      }
+    }
+  }
+}
+
+void dgemm(char transA, char transB, int m, int n, int k,
+           double alpha, const double *A, int ldA,
+           const double *B, int ldB,
+           double beta, double *C, int ldC)
+{
+  nb_gemm(transA, transB, m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+
+void zgemm(char transA, char transB, int m, int n, int k,
+           std::complex<double> alpha, const std::complex<double> *A, int ldA,
+           const std::complex<double> *B, int ldB,
+           std::complex<double> beta, std::complex<double> *C, int ldC)
+{
+  nb_gemm(transA, transB, m, n, k, alpha, A, ldA, B, ldB, beta, C, ldC);
+}
+
+// ----------------------------------------------------------------------
+// GEMV
+// ----------------------------------------------------------------------
+
+// Complex kernels, written with real arithmetic as they are limited by the
+// memory bandwidth rather than by the multiplications
+
+// y += A * x
+static void nb_zgemv_n(int m, int n, const std::complex<double> *A, int ldA,
+                       const std::complex<double> *x, std::complex<double> *y)
+{
+  double *yd = reinterpret_cast<double *>(y);
+  for (int j = 0; j < n; j++) {
+    const double *a = reinterpret_cast<const double *>(A + j * ldA);
+    double xr = x[j].real();
+    double xi = x[j].imag();
+    for (int i = 0; i < 2 * m; i += 2) {
+      yd[i] += a[i] * xr - a[i + 1] * xi;
+      yd[i + 1] += a[i] * xi + a[i + 1] * xr;
+    }
+  }
+}
+
+// y += alpha * op(A) * x, op() being the transposition or, if conj, the
+// hermitian transposition
+static void nb_zgemv_t(int m, int n, std::complex<double> alpha,
+                       const std::complex<double> *A, int ldA,
+                       const std::complex<double> *x, std::complex<double> *y,
+                       bool conj)
+{
+  const double *xd = reinterpret_cast<const double *>(x);
+  double c = conj ? -1.0 : 1.0;
+  for (int j = 0; j < n; j++) {
+    const double *a = reinterpret_cast<const double *>(A + j * ldA);
+    double sr = 0.0;
+    double si = 0.0;
+    for (int i = 0; i < 2 * m; i += 2) {
+      double ai = c * a[i + 1];
+      sr += a[i] * xd[i] - ai * xd[i + 1];
+      si += a[i] * xd[i + 1] + ai * xd[i];
+    }
+    y[j] += std::complex<double>(alpha.real() * sr - alpha.imag() * si,
+                                 alpha.real() * si + alpha.imag() * sr);
+  }
+}
+
+static void nb_gemv_n(const Nb_Kernels &kr, int m, int n, const double *A,
+                      int ldA, const double *x, double *y)
+{
+  kr.dgemv_n(m, n, A, ldA, x, y);
+}
+
+static void nb_gemv_n(const Nb_Kernels &, int m, int n,
+                      const std::complex<double> *A, int ldA,
+                      const std::complex<double> *x, std::complex<double> *y)
+{
+  nb_zgemv_n(m, n, A, ldA, x, y);
+}
+
+static void nb_gemv_t(const Nb_Kernels &kr, char, int m, int n, double alpha,
+                      const double *A, int ldA, const double *x, double *y)
+{
+  kr.dgemv_t(m, n, alpha, A, ldA, x, y);
+}
+
+static void nb_gemv_t(const Nb_Kernels &, char trans, int m, int n,
+                      std::complex<double> alpha, const std::complex<double> *A,
+                      int ldA, const std::complex<double> *x,
+                      std::complex<double> *y)
+{
+  nb_zgemv_t(m, n, alpha, A, ldA, x, y, trans == 'c');
+}
+
+template<class T>
+static void nb_gemv(char trans, int m, int n, T alpha, const T *A, int ldA,
+                    const T *x, int incx, T beta, T *y, int incy)
+{
+  if ((m <= 0) || (n <= 0))
+    return;
+  const Nb_Kernels &kr = nb_kernels();
+  int lx = (trans == 'n') ? n : m;
+  int ly = (trans == 'n') ? m : n;
+
+  Nb_Buffer buf(std::size_t(lx + ly) * sizeof(T) / sizeof(double));
+  T *xbuf = reinterpret_cast<T *>(buf.data());
+  T *ybuf = xbuf + lx;
+  T *ys = const_cast<T *>(nb_gather(ly, y, incy, ybuf));
+  nb_scale(ly, beta, ys);
+
+  if (alpha != T(0)) {
+    int nt = nb_threads(double(m) * n, nb_level2_work);
+    if (trans == 'n') {
+      // alpha * x, and blocks of rows of y staying in the L1 cache
+      const T *xs = nb_gather(lx, x, incx, xbuf);
+      if (alpha != T(1)) {
+        for (int j = 0; j < lx; j++)
+          xbuf[j] = alpha * xs[j];
+        xs = xbuf;
+      }
+      int rows = nb_gemv_rows * sizeof(double) / sizeof(T);
+      int blocks = (m + rows - 1) / rows;
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nt) if (nt > 1) schedule(static)
+#endif
+      for (int b = 0; b < blocks; b++) {
+        int i0 = b * rows;
+        nb_gemv_n(kr, std::min(rows, m - i0), n, A + i0, ldA, xs, ys + i0);
+      }
+    }
+    else {
+      const T *xs = nb_gather(lx, x, incx, xbuf);
+      int cols = (n + nt - 1) / nt;
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(nt) if (nt > 1) schedule(static)
+#endif
+      for (int b = 0; b < nt; b++) {
+        int j0 = b * cols;
+        if (j0 < n)
+          nb_gemv_t(kr, trans, m, std::min(cols, n - j0), alpha, A + j0 * ldA,
+                    ldA, xs, ys + j0);
+      }
+    }
+  }
+
+  if (incy != 1)
+    nb_scatter(ly, ys, y, incy);
+}
+
+void dgemv(char transA, int m, int n,
+           double alpha, const double *A, int ldA,
+           const double *x, int incx,
+           double beta, double *y, int incy)
+{
+  nb_gemv(transA, m, n, alpha, A, ldA, x, incx, beta, y, incy);
+}
+
+void zgemv(char transA, int m, int n,
+           std::complex<double> alpha, const std::complex<double> *A, int ldA,
+           const std::complex<double> *x, int incx,
+           std::complex<double> beta, std::complex<double> *y, int incy)
+{
+  nb_gemv(transA, m, n, alpha, A, ldA, x, incx, beta, y, incy);
+}
+
+// ----------------------------------------------------------------------
+// GER
+// ----------------------------------------------------------------------
+
+// y += a * x
+static void nb_axpy(const Nb_Kernels &kr, int n, double a, const double *x,
+                    double *y)
+{
+  kr.daxpy(n, a, x, y);
+}
+
+static void nb_axpy(const Nb_Kernels &, int n, std::complex<double> a,
+                    const std::complex<double> *x, std::complex<double> *y)
+{
+  const double *xd = reinterpret_cast<const double *>(x);
+  double *yd = reinterpret_cast<double *>(y);
+  double ar = a.real();
+  double ai = a.imag();
+  for (int i = 0; i < 2 * n; i += 2) {
+    yd[i] += ar * xd[i] - ai * xd[i + 1];
+    yd[i + 1] += ar * xd[i + 1] + ai * xd[i];
+  }
+}
+
+// A += alpha * x * y^T, or alpha * x * y^H if conj
+template<class T>
+static void nb_ger(int m, int n, T alpha, const T *x, int incx, const T *y,
+                   int incy, T *A, int ldA, bool conj)
+{
+  if ((m <= 0) || (n <= 0) || (alpha == T(0)))
+    return;
+  const Nb_Kernels &kr = nb_kernels();
+  Nb_Buffer buf(std::size_t(m + n) * sizeof(T) / sizeof(double));
+  T *xbuf = reinterpret_cast<T *>(buf.data());
+  const T *xs = nb_gather(m, x, incx, xbuf);
+  const T *ys = nb_gather(n, y, incy, xbuf + m);
+#ifdef _OPENMP
+  int nt = nb_threads(double(m) * n, nb_level2_work);
+  #pragma omp parallel for num_threads(nt) if (nt > 1) schedule(static)
+#endif
+  for (int j = 0; j < n; j++)
+    nb_axpy(kr, m, alpha * (conj ? nb_conj(ys[j]) : ys[j]), xs, A + j * ldA);
+}
+
+void dger(int m, int n, double alpha,
+          const double *x, int incx,
+          const double *y, int incy,
+          double *A, int ldA)
+{
+  nb_ger(m, n, alpha, x, incx, y, incy, A, ldA, false);
+}
+
+void zgeru(int m, int n, std::complex<double> alpha,
+           const std::complex<double> *x, int incx,
+           const std::complex<double> *y, int incy,
+           std::complex<double> *A, int ldA)
+{
+  nb_ger(m, n, alpha, x, incx, y, incy, A, ldA, false);
+}
+
+void zgerc(int m, int n, std::complex<double> alpha,
+           const std::complex<double> *x, int incx,
+           const std::complex<double> *y, int incy,
+           std::complex<double> *A, int ldA)
+{
+  nb_ger(m, n, alpha, x, incx, y, incy, A, ldA, true);
+}
+
+} // namespace native_blas
+
+} // namespace itpp
+
+//! \endcond
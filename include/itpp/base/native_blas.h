@@ -0,0 +1,92 @@
+/*!
+ * \file
+ * \brief Built-in BLAS routines used when no BLAS library is available
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef NATIVE_BLAS_H
+#define NATIVE_BLAS_H
+
+#include <complex>
+
+//! \cond
+
+// The routines take the arguments of their BLAS counterparts (see blas.h)
+// by value. Matrices are column-major, and op() is selected by 'n', 't' or
+// 'c' as in BLAS. The GEMM routines copy blocks of the operands into
+// contiguous panels, multiply them with the vectorized kernels of the
+// instruction set chosen by vmath_isa(), and use OpenMP threads for large
+// products when the library is built with OpenMP.
+
+namespace itpp
+{
+
+namespace native_blas
+{
+
+// C = alpha * op(A) * op(B) + beta * C
+void dgemm(char transA, char transB, int m, int n, int k,
+           double alpha, const double *A, int ldA,
+           const double *B, int ldB,
+           double beta, double *C, int ldC);
+
+void zgemm(char transA, char transB, int m, int n, int k,
+           std::complex<double> alpha, const std::complex<double> *A, int ldA,
+           const std::complex<double> *B, int ldB,
+           std::complex<double> beta, std::complex<double> *C, int ldC);
+
+// y = alpha * op(A) * x + beta * y
+void dgemv(char transA, int m, int n,
+           double alpha, const double *A, int ldA,
+           const double *x, int incx,
+           double beta, double *y, int incy);
+
+void zgemv(char transA, int m, int n,
+           std::complex<double> alpha, const std::complex<double> *A, int ldA,
+           const std::complex<double> *x, int incx,
+           std::complex<double> beta, std::complex<double> *y, int incy);
+
+// A = alpha * x * y^T + A, or alpha * x * y^H + A for zgerc()
+void dger(int m, int n, double alpha,
+          const double *x, int incx,
+          const double *y, int incy,
+          double *A, int ldA);
+
+void zgeru(int m, int n, std::complex<double> alpha,
+           const std::complex<double> *x, int incx,
+           const std::complex<double> *y, int incy,
+           std::complex<double> *A, int ldA);
+
+void zgerc(int m, int n, std::complex<double> alpha,
+           const std::complex<double> *x, int incx,
+           const std::complex<double> *y, int incy,
+           std::complex<double> *A, int ldA);
+
+} // namespace native_blas
+
+} // namespace itpp
+
+//! \endcond
+
+#endif // #ifndef NATIVE_BLAS_H
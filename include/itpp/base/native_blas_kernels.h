@@ -0,0 +1,303 @@
+/*!
+ * \file
+ * \brief Kernels of the built-in BLAS routines
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+// No include guard: this file is included by native_blas.cpp once for each
+// instruction set, in a namespace defining the type Pack of the packs of
+// doubles, nb_fma(a, b, c) = c + a * b and nb_fnma(a, b, c) = c - a * b,
+// and the tile sizes: the real tiles have nb_drows packs of rows and
+// nb_dcols columns, the complex ones nb_zrows packs of rows and nb_zcols
+// columns.
+
+static const int nb_width = sizeof(Pack) / sizeof(double);
+static const int nb_dmr = nb_drows * nb_width;
+static const int nb_zmr = nb_zrows * nb_width;
+
+// ----------------------------------------------------------------------
+// Pack operations
+// ----------------------------------------------------------------------
+
+NB_INLINE Pack nb_load(const double *p)
+{
+  Pack v;
+  std::memcpy(&v, p, sizeof(Pack));
+  return v;
+}
+
+NB_INLINE void nb_store(double *p, Pack v)
+{
+  std::memcpy(p, &v, sizeof(Pack));
+}
+
+// c - 0 folds to a broadcast of c, unlike c + 0 which differs for -0
+NB_INLINE Pack nb_set(double c)
+{
+  return c - Pack();
+}
+
+// ----------------------------------------------------------------------
+// GEMM
+// ----------------------------------------------------------------------
+
+// C += alpha * A * B for a tile of m <= nb_dmr rows and n <= nb_dcols
+// columns. A holds nb_dmr rows and B nb_dcols columns for each of the k
+// steps.
+NB_INLINE void nb_dtile(int m, int n, int k, double alpha, const double *a,
+                        const double *b, double *c, int ldc)
+{
+  Pack acc[nb_drows][nb_dcols];
+  NB_UNROLL
+  for (int j = 0; j < nb_dcols; j++) {
+    NB_UNROLL
+    for (int r = 0; r < nb_drows; r++)
+      acc[r][j] = nb_set(0.0);
+  }
+  for (int l = 0; l < k; l++) {
+    NB_UNROLL
+    for (int j = 0; j < nb_dcols; j++) {
+      Pack bj = nb_set(b[j]);
+      NB_UNROLL
+      for (int r = 0; r < nb_drows; r++)
+        acc[r][j] = nb_fma(nb_load(a + r * nb_width), bj, acc[r][j]);
+    }
+    a += nb_dmr;
+    b += nb_dcols;
+  }
+
+  Pack al = nb_set(alpha);
+  if ((m == nb_dmr) && (n == nb_dcols)) {
+    NB_UNROLL
+    for (int j = 0; j < nb_dcols; j++) {
+      NB_UNROLL
+      for (int r = 0; r < nb_drows; r++) {
+        double *p = c + j * ldc + r * nb_width;
+        nb_store(p, nb_fma(al, acc[r][j], nb_load(p)));
+      }
+    }
+  }
+  else {
+    double t[nb_dmr];
+    for (int j = 0; j < n; j++) {
+      for (int r = 0; r < nb_drows; r++)
+        nb_store(t + r * nb_width, acc[r][j]);
+      for (int i = 0; i < m; i++)
+        c[j * ldc + i] += alpha * t[i];
+    }
+  }
+}
+
+// C += alpha * A * B for a block of m rows and n columns, A and B being
+// packed in panels of nb_dmr rows and nb_dcols columns
+static void nb_dgemm_block(int m, int n, int k, double alpha, const double *pa,
+                           const double *pb, double *c, int ldc)
+{
+  for (int j = 0; j < n; j += nb_dcols) {
+    int n1 = (n - j < nb_dcols) ? n - j : nb_dcols;
+    for (int i = 0; i < m; i += nb_dmr) {
+      int m1 = (m - i < nb_dmr) ? m - i : nb_dmr;
+      nb_dtile(m1, n1, k, alpha, pa + i * k, pb + j * k, c + j * ldc + i, ldc);
+    }
+  }
+}
+
+// Complex version of nb_dtile(). For each step A holds the nb_zmr real
+// parts followed by the nb_zmr imaginary parts of the rows, and B the
+// nb_zcols real parts followed by the nb_zcols imaginary parts.
+NB_INLINE void nb_ztile(int m, int n, int k, std::complex<double> alpha,
+                        const double *a, const double *b,
+                        std::complex<double> *c, int ldc)
+{
+  Pack re[nb_zrows][nb_zcols];
+  Pack im[nb_zrows][nb_zcols];
+  NB_UNROLL
+  for (int j = 0; j < nb_zcols; j++) {
+    NB_UNROLL
+    for (int r = 0; r < nb_zrows; r++) {
+      re[r][j] = nb_set(0.0);
+      im[r][j] = nb_set(0.0);
+    }
+  }
+  for (int l = 0; l < k; l++) {
+    Pack ar[nb_zrows];
+    Pack ai[nb_zrows];
+    NB_UNROLL
+    for (int r = 0; r < nb_zrows; r++) {
+      ar[r] = nb_load(a + r * nb_width);
+      ai[r] = nb_load(a + nb_zmr + r * nb_width);
+    }
+    NB_UNROLL
+    for (int j = 0; j < nb_zcols; j++) {
+      Pack br = nb_set(b[j]);
+      Pack bi = nb_set(b[nb_zcols + j]);
+      NB_UNROLL
+      for (int r = 0; r < nb_zrows; r++) {
+        re[r][j] = nb_fnma(ai[r], bi, nb_fma(ar[r], br, re[r][j]));
+        im[r][j] = nb_fma(ai[r], br, nb_fma(ar[r], bi, im[r][j]));
+      }
+    }
+    a += 2 * nb_zmr;
+    b += 2 * nb_zcols;
+  }
+
+  double tr[nb_zmr];
+  double ti[nb_zmr];
+  for (int j = 0; j < n; j++) {
+    for (int r = 0; r < nb_zrows; r++) {
+      nb_store(tr + r * nb_width, re[r][j]);
+      nb_store(ti + r * nb_width, im[r][j]);
+    }
+    std::complex<double> *p = c + j * ldc;
+    for (int i = 0; i < m; i++)
+      p[i] += std::complex<double>(alpha.real() * tr[i] - alpha.imag() * ti[i],
+                                   alpha.real() * ti[i] + alpha.imag() * tr[i]);
+  }
+}
+
+// Complex version of nb_dgemm_block()
+static void nb_zgemm_block(int m, int n, int k, std::complex<double> alpha,
+                           const double *pa, const double *pb,
+                           std::complex<double> *c, int ldc)
+{
+  for (int j = 0; j < n; j += nb_zcols) {
+    int n1 = (n - j < nb_zcols) ? n - j : nb_zcols;
+    for (int i = 0; i < m; i += nb_zmr) {
+      int m1 = (m - i < nb_zmr) ? m - i : nb_zmr;
+      nb_ztile(m1, n1, k, alpha, pa + 2 * i * k, pb + 2 * j * k, c + j * ldc + i, ldc);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// GEMV and GER
+// ----------------------------------------------------------------------
+
+// y += A * x, four columns at a time
+static void nb_dgemv_n(int m, int n, const double *A, int ldA, const double *x,
+                       double *y)
+{
+  int j = 0;
+  for (; j + 4 <= n; j += 4) {
+    const double *a0 = A + j * ldA;
+    const double *a1 = a0 + ldA;
+    const double *a2 = a1 + ldA;
+    const double *a3 = a2 + ldA;
+    Pack x0 = nb_set(x[j]);
+    Pack x1 = nb_set(x[j + 1]);
+    Pack x2 = nb_set(x[j + 2]);
+    Pack x3 = nb_set(x[j + 3]);
+    int i = 0;
+    for (; i + nb_width <= m; i += nb_width) {
+      Pack s = nb_fma(nb_load(a0 + i), x0, nb_load(y + i));
+      s = nb_fma(nb_load(a1 + i), x1, s);
+      s = nb_fma(nb_load(a2 + i), x2, s);
+      nb_store(y + i, nb_fma(nb_load(a3 + i), x3, s));
+    }
+    for (; i < m; i++)
+      y[i] += a0[i] * x[j] + a1[i] * x[j + 1] + a2[i] * x[j + 2] + a3[i] * x[j + 3];
+  }
+  for (; j < n; j++) {
+    const double *a0 = A + j * ldA;
+    Pack x0 = nb_set(x[j]);
+    int i = 0;
+    for (; i + nb_width <= m; i += nb_width)
+      nb_store(y + i, nb_fma(nb_load(a0 + i), x0, nb_load(y + i)));
+    for (; i < m; i++)
+      y[i] += a0[i] * x[j];
+  }
+}
+
+NB_INLINE double nb_sum(Pack v)
+{
+  double t[nb_width];
+  nb_store(t, v);
+  double s = t[0];
+  for (int i = 1; i < nb_width; i++)
+    s += t[i];
+  return s;
+}
+
+// y += alpha * A^T * x, four columns at a time
+static void nb_dgemv_t(int m, int n, double alpha, const double *A, int ldA,
+                       const double *x, double *y)
+{
+  int j = 0;
+  for (; j + 4 <= n; j += 4) {
+    const double *a0 = A + j * ldA;
+    const double *a1 = a0 + ldA;
+    const double *a2 = a1 + ldA;
+    const double *a3 = a2 + ldA;
+    Pack s0 = nb_set(0.0);
+    Pack s1 = nb_set(0.0);
+    Pack s2 = nb_set(0.0);
+    Pack s3 = nb_set(0.0);
+    int i = 0;
+    for (; i + nb_width <= m; i += nb_width) {
+      Pack xi = nb_load(x + i);
+      s0 = nb_fma(nb_load(a0 + i), xi, s0);
+      s1 = nb_fma(nb_load(a1 + i), xi, s1);
+      s2 = nb_fma(nb_load(a2 + i), xi, s2);
+      s3 = nb_fma(nb_load(a3 + i), xi, s3);
+    }
+    double t0 = nb_sum(s0), t1 = nb_sum(s1), t2 = nb_sum(s2), t3 = nb_sum(s3);
+    for (; i < m; i++) {
+      t0 += a0[i] * x[i];
+      t1 += a1[i] * x[i];
+      t2 += a2[i] * x[i];
+      t3 += a3[i] * x[i];
+    }
+    y[j] += alpha * t0;
+    y[j + 1] += alpha * t1;
+    y[j + 2] += alpha * t2;
+    y[j + 3] += alpha * t3;
+  }
+  for (; j < n; j++) {
+    const double *a0 = A + j * ldA;
+    Pack s0 = nb_set(0.0);
+    int i = 0;
+    for (; i + nb_width <= m; i += nb_width)
+      s0 = nb_fma(nb_load(a0 + i), nb_load(x + i), s0);
+    double t0 = nb_sum(s0);
+    for (; i < m; i++)
+      t0 += a0[i] * x[i];
+    y[j] += alpha * t0;
+  }
+}
+
+// y += a * x
+static void nb_daxpy(int n, double a, const double *x, double *y)
+{
+  Pack av = nb_set(a);
+  int i = 0;
+  for (; i + nb_width <= n; i += nb_width)
+    nb_store(y + i, nb_fma(nb_load(x + i), av, nb_load(y + i)));
+  for (; i < n; i++)
+    y[i] += a * x[i];
+}
+
+static const Nb_Kernels nb_kernels = {
+  nb_dmr, nb_dcols, nb_zmr, nb_zcols,
+  nb_dgemm_block, nb_zgemm_block, nb_dgemv_n, nb_dgemv_t, nb_daxpy
+};
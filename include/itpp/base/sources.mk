@@ -1,6 +1,8 @@
 noinst_h_base_sources = \
 	$(top_srcdir)/itpp/base/blas.h \
-	$(top_srcdir)/itpp/base/itcompat.h
+	$(top_srcdir)/itpp/base/itcompat.h \
+	$(top_srcdir)/itpp/base/native_blas.h \
+	$(top_srcdir)/itpp/base/native_blas_kernels.h
 
 h_base_sources = \
 	$(top_srcdir)/itpp/base/array.h \
@@ -10,6 +12,7 @@ h_base_sources = \
 	$(top_srcdir)/itpp/base/circular_buffer.h \
 	$(top_srcdir)/itpp/base/converters.h \
 	$(top_srcdir)/itpp/base/copy_vector.h \
+	$(top_srcdir)/itpp/base/elem_expr.h \
 	$(top_srcdir)/itpp/base/factory.h \
 	$(top_srcdir)/itpp/base/fastmath.h \
 	$(top_srcdir)/itpp/base/gf2mat.h \
@@ -29,7 +32,8 @@ h_base_sources = \
 	$(top_srcdir)/itpp/base/stack.h \
 	$(top_srcdir)/itpp/base/svec.h \
 	$(top_srcdir)/itpp/base/timing.h \
-	$(top_srcdir)/itpp/base/vec.h
+	$(top_srcdir)/itpp/base/vec.h \
+	$(top_srcdir)/itpp/base/view.h
 
 cpp_base_sources = \
 	$(top_srcdir)/itpp/base/bessel.cpp \
@@ -37,6 +41,7 @@ cpp_base_sources = \
 	$(top_srcdir)/itpp/base/binfile.cpp \
 	$(top_srcdir)/itpp/base/converters.cpp \
 	$(top_srcdir)/itpp/base/copy_vector.cpp \
+	$(top_srcdir)/itpp/base/factory.cpp \
 	$(top_srcdir)/itpp/base/fastmath.cpp \
 	$(top_srcdir)/itpp/base/gf2mat.cpp \
 	$(top_srcdir)/itpp/base/help_functions.cpp \
@@ -45,6 +50,7 @@ cpp_base_sources = \
 	$(top_srcdir)/itpp/base/itfile.cpp \
 	$(top_srcdir)/itpp/base/mat.cpp \
 	$(top_srcdir)/itpp/base/matfunc.cpp \
+	$(top_srcdir)/itpp/base/native_blas.cpp \
 	$(top_srcdir)/itpp/base/operators.cpp \
 	$(top_srcdir)/itpp/base/parser.cpp \
 	$(top_srcdir)/itpp/base/random.cpp \
@@ -52,5 +58,6 @@ cpp_base_sources = \
 	$(top_srcdir)/itpp/base/specmat.cpp \
 	$(top_srcdir)/itpp/base/svec.cpp \
 	$(top_srcdir)/itpp/base/timing.cpp \
-	$(top_srcdir)/itpp/base/vec.cpp
+	$(top_srcdir)/itpp/base/vec.cpp \
+	$(top_srcdir)/itpp/base/view.cpp
 
@@ -34,6 +34,8 @@
 
 #if defined (HAVE_BLAS)
 #  include <itpp/base/blas.h>
+#else
+#  include <itpp/base/native_blas.h>
 #endif
 
 #include <itpp/base/vec.h>
@@ -317,11 +319,9 @@ mat outer_product(const vec &v1, const vec &v2, bool)
                   "Vec::outer_product:: Input vector of zero size");
   int v1_l = v1.length(); int v2_l = v2.length();
   mat out(v1_l, v2_l);
-  for (int i = 0; i < v1_l; ++i) {
-    for (int j = 0; j < v2_l; ++j) {
-      out(i, j) = v1._data()[i] * v2._data()[j];
-    }
-  }
+  out.zeros();
+  native_blas::dger(v1_l, v2_l, 1.0, v1._data(), 1, v2._data(), 1,
+                    out._data(), v1_l);
   return out;
 }
 
@@ -332,19 +332,15 @@ cmat outer_product(const cvec &v1, const cvec &v2, bool hermitian)
                   "Vec::outer_product:: Input vector of zero size");
   int v1_l = v1.length(); int v2_l = v2.length();
   cmat out(v1_l, v2_l);
+  out.zeros();
+  std::complex<double> alpha(1.0);
   if (hermitian) {
-    for (int i = 0; i < v1_l; ++i) {
-      for (int j = 0; j < v2_l; ++j) {
-        out(i, j) = v1._data()[i] * conj(v2._data()[j]);
-      }
-    }
+    native_blas::zgerc(v1_l, v2_l, alpha, v1._data(), 1, v2._data(), 1,
+                       out._data(), v1_l);
   }
   else {
-    for (int i = 0; i < v1_l; ++i) {
-      for (int j = 0; j < v2_l; ++j) {
-        out(i, j) = v1._data()[i] * v2._data()[j];
-      }
-    }
+    native_blas::zgeru(v1_l, v2_l, alpha, v1._data(), 1, v2._data(), 1,
+                       out._data(), v1_l);
   }
   return out;
 }
@@ -34,6 +34,7 @@
 #include <itpp/base/copy_vector.h>
 #include <itpp/base/factory.h>
 #include <vector>
+#include <utility>
 #include <itpp/itexports.h>
 
 namespace itpp
@@ -43,6 +44,8 @@ namespace itpp
 template<class Num_T> class Vec;
 // Declaration of Mat
 template<class Num_T> class Mat;
+// Declaration of Elem_Expr
+template<class E> class Elem_Expr;
 // Declaration of bin
 class bin;
 
@@ -253,6 +256,10 @@ public:
   explicit Vec(int size, const Factory &f = DEFAULT_FACTORY);
   //! Copy constructor
   Vec(const Vec<Num_T> &v);
+#ifdef ITPP_HAVE_RVALUE_REFS
+  //! Move constructor. Takes over the storage of \c v, which is left empty
+  Vec(Vec<Num_T> &&v);
+#endif
   //! Copy constructor, which takes an element factory \c f as an additional argument.
   Vec(const Vec<Num_T> &v, const Factory &f);
   //! Constructor taking a char string as input. An element factory \c f can be specified.
@@ -261,6 +268,9 @@ public:
   Vec(const std::string &str, const Factory &f = DEFAULT_FACTORY);
   //! Constructor taking a C-array as input. Copies all data. An element factory \c f can be specified.
   Vec(const Num_T *c_array, int size, const Factory &f = DEFAULT_FACTORY);
+  //! Constructor evaluating the elementwise expression \c e (see elem_expr.h). An element factory \c f can be specified.
+  template<class E>
+  explicit Vec(const Elem_Expr<E> &e, const Factory &f = DEFAULT_FACTORY);
 
   //! Destructor
   ~Vec();
@@ -458,12 +468,19 @@ public:
   Vec<Num_T>& operator=(Num_T t);
   //! Assign vector the value and length of \c v
   Vec<Num_T>& operator=(const Vec<Num_T> &v);
+#ifdef ITPP_HAVE_RVALUE_REFS
+  //! Take over the storage of \c v, or copy it if the element factories differ
+  Vec<Num_T>& operator=(Vec<Num_T> &&v);
+#endif
   //! Assign vector equal to the 1-dimensional matrix \c m
   Vec<Num_T>& operator=(const Mat<Num_T> &m);
   //! Assign vector the values in the string \c str
   Vec<Num_T>& operator=(const char *str);
   //! Assign vector the values in the string \c str
   Vec<Num_T>& operator=(const std::string &str);
+  //! Assign vector the value and length of the elementwise expression \c e (see elem_expr.h)
+  template<class E>
+  Vec<Num_T>& operator=(const Elem_Expr<E> &e);
 
   //! Elementwise equal to the scalar \c t
   Vec<bin> operator==(Num_T t) const;
@@ -627,6 +644,15 @@ Vec<Num_T>::Vec(const Vec<Num_T> &v) : datasize(0), data(0), factory(v.factory)
   copy_vector(datasize, v.data, data);
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+template<class Num_T> inline
+Vec<Num_T>::Vec(Vec<Num_T> &&v) : datasize(v.datasize), data(v.data), factory(v.factory)
+{
+  v.datasize = 0;
+  v.data = 0;
+}
+#endif
+
 template<class Num_T> inline
 Vec<Num_T>::Vec(const Vec<Num_T> &v, const Factory &f) : datasize(0), data(0), factory(f)
 {
@@ -1163,6 +1189,182 @@ Vec<Num_T> operator/(Num_T t, const Vec<Num_T> &v)
   return r;
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+
+//-----------------------------------------------------------------------------------
+// Operators reusing the storage of a temporary operand
+//-----------------------------------------------------------------------------------
+
+//! Addition of two vectors, reusing the storage of \c v1
+template<class Num_T> inline
+Vec<Num_T> operator+(Vec<Num_T> &&v1, const Vec<Num_T> &v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec<>::operator+(): Wrong sizes");
+  const Num_T *p1 = v1._data();
+  const Num_T *p2 = v2._data();
+  Num_T *r = v1._data();
+  for (int i = 0; i < v1.size(); i++)
+    r[i] = p1[i] + p2[i];
+  return std::move(v1);
+}
+
+//! Addition of two vectors, reusing the storage of \c v2
+template<class Num_T> inline
+Vec<Num_T> operator+(const Vec<Num_T> &v1, Vec<Num_T> &&v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec<>::operator+(): Wrong sizes");
+  const Num_T *p1 = v1._data();
+  const Num_T *p2 = v2._data();
+  Num_T *r = v2._data();
+  for (int i = 0; i < v2.size(); i++)
+    r[i] = p1[i] + p2[i];
+  return std::move(v2);
+}
+
+//! Addition of two vectors, reusing the storage of \c v1
+template<class Num_T> inline
+Vec<Num_T> operator+(Vec<Num_T> &&v1, Vec<Num_T> &&v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec<>::operator+(): Wrong sizes");
+  const Num_T *p1 = v1._data();
+  const Num_T *p2 = v2._data();
+  Num_T *r = v1._data();
+  for (int i = 0; i < v1.size(); i++)
+    r[i] = p1[i] + p2[i];
+  return std::move(v1);
+}
+
+//! Addition of a vector and a scalar, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator+(Vec<Num_T> &&v, Num_T t)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = p[i] + t;
+  return std::move(v);
+}
+
+//! Addition of a scalar and a vector, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator+(Num_T t, Vec<Num_T> &&v)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = t + p[i];
+  return std::move(v);
+}
+
+//! Subtraction of \c v2 from \c v1, reusing the storage of \c v1
+template<class Num_T> inline
+Vec<Num_T> operator-(Vec<Num_T> &&v1, const Vec<Num_T> &v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec<>::operator-(): Wrong sizes");
+  const Num_T *p1 = v1._data();
+  const Num_T *p2 = v2._data();
+  Num_T *r = v1._data();
+  for (int i = 0; i < v1.size(); i++)
+    r[i] = p1[i] - p2[i];
+  return std::move(v1);
+}
+
+//! Subtraction of \c v2 from \c v1, reusing the storage of \c v2
+template<class Num_T> inline
+Vec<Num_T> operator-(const Vec<Num_T> &v1, Vec<Num_T> &&v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec<>::operator-(): Wrong sizes");
+  const Num_T *p1 = v1._data();
+  const Num_T *p2 = v2._data();
+  Num_T *r = v2._data();
+  for (int i = 0; i < v2.size(); i++)
+    r[i] = p1[i] - p2[i];
+  return std::move(v2);
+}
+
+//! Subtraction of \c v2 from \c v1, reusing the storage of \c v1
+template<class Num_T> inline
+Vec<Num_T> operator-(Vec<Num_T> &&v1, Vec<Num_T> &&v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec<>::operator-(): Wrong sizes");
+  const Num_T *p1 = v1._data();
+  const Num_T *p2 = v2._data();
+  Num_T *r = v1._data();
+  for (int i = 0; i < v1.size(); i++)
+    r[i] = p1[i] - p2[i];
+  return std::move(v1);
+}
+
+//! Subtraction of a scalar from a vector, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator-(Vec<Num_T> &&v, Num_T t)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = p[i] - t;
+  return std::move(v);
+}
+
+//! Subtraction of a vector from a scalar, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator-(Num_T t, Vec<Num_T> &&v)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = t - p[i];
+  return std::move(v);
+}
+
+//! Negation of a vector, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator-(Vec<Num_T> &&v)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = -p[i];
+  return std::move(v);
+}
+
+//! Multiplication of a vector and a scalar, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator*(Vec<Num_T> &&v, Num_T t)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = p[i] * t;
+  return std::move(v);
+}
+
+//! Multiplication of a scalar and a vector, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator*(Num_T t, Vec<Num_T> &&v)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = p[i] * t;
+  return std::move(v);
+}
+
+//! Division of all elements in \c v by \c t, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator/(Vec<Num_T> &&v, Num_T t)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = p[i] / t;
+  return std::move(v);
+}
+
+//! Division of \c t by all elements in \c v, reusing the storage of \c v
+template<class Num_T> inline
+Vec<Num_T> operator/(Num_T t, Vec<Num_T> &&v)
+{
+  Num_T *p = v._data();
+  for (int i = 0; i < v.size(); i++)
+    p[i] = t / p[i];
+  return std::move(v);
+}
+
+#endif // #ifdef ITPP_HAVE_RVALUE_REFS
+
 template<class Num_T>
 Vec<Num_T> elem_div(Num_T t, const Vec<Num_T> &v)
 {
@@ -1504,6 +1706,27 @@ Vec<Num_T>& Vec<Num_T>::operator=(const Vec<Num_T> &v)
   return *this;
 }
 
+#ifdef ITPP_HAVE_RVALUE_REFS
+template<class Num_T> inline
+Vec<Num_T>& Vec<Num_T>::operator=(Vec<Num_T> &&v)
+{
+  if (this != &v) {
+    if (&factory == &v.factory) {
+      free();
+      datasize = v.datasize;
+      data = v.data;
+      v.datasize = 0;
+      v.data = 0;
+    }
+    else {
+      set_size(v.datasize, false);
+      copy_vector(datasize, v.data, data);
+    }
+  }
+  return *this;
+}
+#endif
+
 template<class Num_T>
 Vec<Num_T>& Vec<Num_T>::operator=(const Mat<Num_T> &m)
 {
@@ -0,0 +1,236 @@
+/*!
+ * \file
+ * \brief Non-owning strided views of vectors and matrices
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/base/view.h>
+
+#ifndef _MSC_VER
+#  include <itpp/config.h>
+#else
+#  include <itpp/config_msvc.h>
+#endif
+
+#if defined (HAVE_BLAS)
+#  include <itpp/base/blas.h>
+#else
+#  include <itpp/base/native_blas.h>
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+// Matrix products of BLAS, or of the built-in routines without BLAS
+
+#if defined(HAVE_BLAS)
+
+static void view_gemm(char transA, char transB, int m, int n, int k,
+                      const double *A, int ldA, const double *B, int ldB,
+                      double *C, int ldC)
+{
+  double alpha = 1.0;
+  double beta = 0.0;
+  blas::dgemm_(&transA, &transB, &m, &n, &k, &alpha, A, &ldA, B, &ldB,
+               &beta, C, &ldC);
+}
+
+static void view_gemm(char transA, char transB, int m, int n, int k,
+                      const std::complex<double> *A, int ldA,
+                      const std::complex<double> *B, int ldB,
+                      std::complex<double> *C, int ldC)
+{
+  std::complex<double> alpha = std::complex<double>(1.0);
+  std::complex<double> beta = std::complex<double>(0.0);
+  blas::zgemm_(&transA, &transB, &m, &n, &k, &alpha, A, &ldA, B, &ldB,
+               &beta, C, &ldC);
+}
+
+static void view_gemv(char trans, int m, int n, const double *A, int ldA,
+                      const double *x, int incx, double *y)
+{
+  double alpha = 1.0;
+  double beta = 0.0;
+  int incy = 1;
+  blas::dgemv_(&trans, &m, &n, &alpha, A, &ldA, x, &incx, &beta, y, &incy);
+}
+
+static void view_gemv(char trans, int m, int n, const std::complex<double> *A,
+                      int ldA, const std::complex<double> *x, int incx,
+                      std::complex<double> *y)
+{
+  std::complex<double> alpha = std::complex<double>(1.0);
+  std::complex<double> beta = std::complex<double>(0.0);
+  int incy = 1;
+  blas::zgemv_(&trans, &m, &n, &alpha, A, &ldA, x, &incx, &beta, y, &incy);
+}
+
+template<>
+double dot(const vec_view &v1, const vec_view &v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "vec_view::dot(): Wrong sizes");
+  int n = v1.size(); int inc1 = v1.stride(); int inc2 = v2.stride();
+  return blas::ddot_(&n, v1._data(), &inc1, v2._data(), &inc2);
+}
+
+#else
+
+static void view_gemm(char transA, char transB, int m, int n, int k,
+                      const double *A, int ldA, const double *B, int ldB,
+                      double *C, int ldC)
+{
+  native_blas::dgemm(transA, transB, m, n, k, 1.0, A, ldA, B, ldB, 0.0, C, ldC);
+}
+
+static void view_gemm(char transA, char transB, int m, int n, int k,
+                      const std::complex<double> *A, int ldA,
+                      const std::complex<double> *B, int ldB,
+                      std::complex<double> *C, int ldC)
+{
+  native_blas::zgemm(transA, transB, m, n, k, std::complex<double>(1.0), A,
+                     ldA, B, ldB, std::complex<double>(0.0), C, ldC);
+}
+
+static void view_gemv(char trans, int m, int n, const double *A, int ldA,
+                      const double *x, int incx, double *y)
+{
+  native_blas::dgemv(trans, m, n, 1.0, A, ldA, x, incx, 0.0, y, 1);
+}
+
+static void view_gemv(char trans, int m, int n, const std::complex<double> *A,
+                      int ldA, const std::complex<double> *x, int incx,
+                      std::complex<double> *y)
+{
+  native_blas::zgemv(trans, m, n, std::complex<double>(1.0), A, ldA, x, incx,
+                     std::complex<double>(0.0), y, 1);
+}
+
+template<>
+double dot(const vec_view &v1, const vec_view &v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "vec_view::dot(): Wrong sizes");
+  double r = 0.0;
+  for (int i = 0; i < v1.size(); ++i)
+    r += v1[i] * v2[i];
+  return r;
+}
+
+#endif // HAVE_BLAS
+
+// A view is a BLAS operand op(A), A being column-major with leading
+// dimension ld, when one of its strides is 1
+template<class Num_T>
+static bool blas_operand(const Mat_View<Num_T> &m, char &trans, int &ld)
+{
+  if ((m.row_stride() == 1) && (m.col_stride() >= m.rows()) && (m.col_stride() >= 1)) {
+    trans = 'n';
+    ld = m.col_stride();
+    return true;
+  }
+  if ((m.col_stride() == 1) && (m.row_stride() >= m.cols()) && (m.row_stride() >= 1)) {
+    trans = 't';
+    ld = m.row_stride();
+    return true;
+  }
+  return false;
+}
+
+template<class Num_T>
+static Mat<Num_T> view_prod(const Mat_View<Num_T> &m1, const Mat_View<Num_T> &m2)
+{
+  it_assert_debug(m1.cols() == m2.rows(), "Mat_View<>::operator*(): Wrong sizes");
+  int r_r = m1.rows(); int r_c = m2.cols(); int k = m1.cols();
+  Mat<Num_T> r(r_r, r_c);
+  if ((r_r == 0) || (r_c == 0))
+    return r;
+  if (k == 0) {
+    r.zeros();
+    return r;
+  }
+  // Operands with no unit stride are gathered first
+  char trans1, trans2;
+  int ld1, ld2;
+  const Num_T *p1 = m1._data(), *p2 = m2._data();
+  Mat<Num_T> a, b;
+  if (!blas_operand(m1, trans1, ld1)) {
+    a = Mat<Num_T>(m1);
+    p1 = a._data();
+    trans1 = 'n';
+    ld1 = r_r;
+  }
+  if (!blas_operand(m2, trans2, ld2)) {
+    b = Mat<Num_T>(m2);
+    p2 = b._data();
+    trans2 = 'n';
+    ld2 = k;
+  }
+  view_gemm(trans1, trans2, r_r, r_c, k, p1, ld1, p2, ld2, r._data(), r_r);
+  return r;
+}
+
+template<class Num_T>
+static Vec<Num_T> view_prod(const Mat_View<Num_T> &m, const Vec_View<Num_T> &v)
+{
+  it_assert_debug(m.cols() == v.size(), "Mat_View<>::operator*(): Wrong sizes");
+  Vec<Num_T> r(m.rows());
+  if (m.rows() == 0)
+    return r;
+  if (m.cols() == 0) {
+    r.zeros();
+    return r;
+  }
+  char trans;
+  int ld;
+  const Num_T *p = m._data();
+  Mat<Num_T> a;
+  if (!blas_operand(m, trans, ld)) {
+    a = Mat<Num_T>(m);
+    p = a._data();
+    trans = 'n';
+    ld = m.rows();
+  }
+  // BLAS takes the sizes of the stored matrix, before op()
+  int a_r = (trans == 'n') ? m.rows() : m.cols();
+  int a_c = (trans == 'n') ? m.cols() : m.rows();
+  view_gemv(trans, a_r, a_c, p, ld, v._data(), v.stride(), r._data());
+  return r;
+}
+
+template<>
+mat operator*(const mat_view &m1, const mat_view &m2) { return view_prod(m1, m2); }
+
+template<>
+cmat operator*(const cmat_view &m1, const cmat_view &m2) { return view_prod(m1, m2); }
+
+template<>
+vec operator*(const mat_view &m, const vec_view &v) { return view_prod(m, v); }
+
+template<>
+cvec operator*(const cmat_view &m, const cvec_view &v) { return view_prod(m, v); }
+
+} // namespace itpp
+
+//! \endcond
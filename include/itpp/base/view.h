@@ -0,0 +1,417 @@
+/*!
+ * \file
+ * \brief Non-owning strided views of vectors and matrices
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <itpp/base/elem_expr.h>
+#include <itpp/itexports.h>
+#include <cmath>
+#include <complex>
+
+
+namespace itpp
+{
+
+/*!
+  \ingroup arr_vec_mat
+  \brief Read-only view of equally spaced elements of a vector or a matrix
+
+  A Vec_View refers to \c size() elements located \c stride() elements apart
+  in memory, e.g. a part of a Vec, or a row or a column of a Mat. Nothing is
+  allocated nor copied, so slicing is cheap, but the viewed storage must not
+  be resized nor freed while the view is in use.
+
+  A view is an elementwise expression (see Elem_Expr), so it can be used
+  directly in lazily evaluated expressions, and is copied into a Vec by
+  assignment or by the explicit Vec constructor:
+
+  \code
+  mat A;
+  vec_view c = mat_view(A).get_col(2);
+  double s = sum(c), n = norm(c);
+  vec y(exp(-c * 0.5));
+  vec x;
+  x = c(0, 9);
+  \endcode
+*/
+template<class Num_T>
+class Vec_View : public Elem_Expr<Vec_View<Num_T> >
+{
+public:
+  //! The type of the elements
+  typedef Num_T value_type;
+
+  //! View of all the elements of \c v
+  Vec_View(const Vec<Num_T> &v) : data(v._data()), len(v.size()), inc(1) {}
+  //! View of the elements \c i1 to \c i2 of \c v. -1 is the last element
+  Vec_View(const Vec<Num_T> &v, int i1, int i2);
+  //! View of \c n elements starting at \c d and \c stride elements apart
+  Vec_View(const Num_T *d, int n, int stride = 1) : data(d), len(n), inc(stride) {
+    it_assert_debug((n >= 0) && (stride > 0), "Vec_View<>::Vec_View(): Wrong size or stride");
+  }
+
+  //! Number of elements
+  int size() const { return len; }
+  //! Number of elements
+  int length() const { return len; }
+  //! Distance in memory between two consecutive elements
+  int stride() const { return inc; }
+  //! Pointer to the first element
+  const Num_T *_data() const { return data; }
+
+  //! Element \c i
+  const Num_T &operator()(int i) const {
+    it_assert_debug((i >= 0) && (i < len), "Vec_View<>::operator(): Index out of range");
+    return data[i * inc];
+  }
+  //! Element \c i, without range check
+  const Num_T &operator[](int i) const { return data[i * inc]; }
+  //! View of the elements \c i1 to \c i2. -1 is the last element
+  Vec_View<Num_T> operator()(int i1, int i2) const;
+
+  //! Number of rows, as an elementwise expression
+  int rows() const { return len; }
+  //! Number of columns, as an elementwise expression
+  int cols() const { return 1; }
+
+private:
+  const Num_T *data;
+  int len, inc;
+};
+
+/*!
+  \ingroup arr_vec_mat
+  \brief Read-only strided view of a matrix
+
+  A Mat_View refers to a \c rows() by \c cols() matrix whose element (r, c)
+  is at \c r*row_stride()+c*col_stride() from the first one. A whole Mat is
+  viewed with strides 1 and \c rows(). Submatrices, rows, columns and the
+  transpose are again views of the same storage, so none of them costs a
+  copy:
+
+  \code
+  mat A, B;
+  mat_view Av(A);
+  mat C = Av(0, -1, 0, 3) * mat_view(B).transpose();  // BLAS, no copy
+  vec s = sum(Av.get_cols(2, 5));
+  \endcode
+
+  Products of views use BLAS whenever one of the strides of each operand is
+  1. As an elementwise expression (see Elem_Expr) the elements are taken in
+  column-major order. The viewed storage must not be resized nor freed while
+  the view is in use.
+*/
+template<class Num_T>
+class Mat_View : public Elem_Expr<Mat_View<Num_T> >
+{
+public:
+  //! The type of the elements
+  typedef Num_T value_type;
+
+  //! View of the whole matrix \c m
+  Mat_View(const Mat<Num_T> &m) :
+      data(m._data()), no_rows(m.rows()), no_cols(m.cols()), rinc(1), cinc(m.rows()) {}
+  //! View of rows \c r1 to \c r2 and columns \c c1 to \c c2 of \c m. -1 is the last one
+  Mat_View(const Mat<Num_T> &m, int r1, int r2, int c1, int c2);
+  //! View of a \c r by \c c matrix starting at \c d with the given strides
+  Mat_View(const Num_T *d, int r, int c, int row_stride, int col_stride) :
+      data(d), no_rows(r), no_cols(c), rinc(row_stride), cinc(col_stride) {
+    it_assert_debug((r >= 0) && (c >= 0) && (row_stride > 0) && (col_stride > 0),
+                    "Mat_View<>::Mat_View(): Wrong size or strides");
+  }
+
+  //! Number of rows
+  int rows() const { return no_rows; }
+  //! Number of columns
+  int cols() const { return no_cols; }
+  //! Number of elements
+  int size() const { return no_rows * no_cols; }
+  //! Distance in memory between two consecutive elements of a column
+  int row_stride() const { return rinc; }
+  //! Distance in memory between two consecutive elements of a row
+  int col_stride() const { return cinc; }
+  //! Pointer to the element (0, 0)
+  const Num_T *_data() const { return data; }
+
+  //! Element (\c r, \c c)
+  const Num_T &operator()(int r, int c) const {
+    it_assert_debug((r >= 0) && (r < no_rows) && (c >= 0) && (c < no_cols),
+                    "Mat_View<>::operator(): Indexing out of range");
+    return data[r * rinc + c * cinc];
+  }
+  //! Element \c i in column-major order, without range check
+  const Num_T &operator[](int i) const {
+    return data[(i % no_rows) * rinc + (i / no_rows) * cinc];
+  }
+  //! View of rows \c r1 to \c r2 and columns \c c1 to \c c2. -1 is the last one
+  Mat_View<Num_T> operator()(int r1, int r2, int c1, int c2) const;
+
+  //! View of row \c r
+  Vec_View<Num_T> get_row(int r) const {
+    it_assert_debug((r >= 0) && (r < no_rows), "Mat_View<>::get_row(): Index out of range");
+    return Vec_View<Num_T>(data + r * rinc, no_cols, cinc);
+  }
+  //! View of column \c c
+  Vec_View<Num_T> get_col(int c) const {
+    it_assert_debug((c >= 0) && (c < no_cols), "Mat_View<>::get_col(): Index out of range");
+    return Vec_View<Num_T>(data + c * cinc, no_rows, rinc);
+  }
+  //! View of rows \c r1 to \c r2
+  Mat_View<Num_T> get_rows(int r1, int r2) const { return operator()(r1, r2, 0, no_cols - 1); }
+  //! View of columns \c c1 to \c c2
+  Mat_View<Num_T> get_cols(int c1, int c2) const { return operator()(0, no_rows - 1, c1, c2); }
+
+  //! View of the transpose, obtained by swapping the strides
+  Mat_View<Num_T> transpose() const {
+    return Mat_View<Num_T>(data, no_cols, no_rows, cinc, rinc);
+  }
+  //! View of the transpose, obtained by swapping the strides
+  Mat_View<Num_T> T() const { return transpose(); }
+
+private:
+  const Num_T *data;
+  int no_rows, no_cols;
+  int rinc, cinc;
+};
+
+//! \cond
+
+template<class Num_T>
+Vec_View<Num_T>::Vec_View(const Vec<Num_T> &v, int i1, int i2) : inc(1)
+{
+  if (i1 == -1) i1 = v.size() - 1;
+  if (i2 == -1) i2 = v.size() - 1;
+  it_assert_debug((i1 >= 0) && (i1 <= i2) && (i2 < v.size()),
+                  "Vec_View<>::Vec_View(): Indexing out of range");
+  data = v._data() + i1;
+  len = i2 - i1 + 1;
+}
+
+template<class Num_T>
+Vec_View<Num_T> Vec_View<Num_T>::operator()(int i1, int i2) const
+{
+  if (i1 == -1) i1 = len - 1;
+  if (i2 == -1) i2 = len - 1;
+  it_assert_debug((i1 >= 0) && (i1 <= i2) && (i2 < len),
+                  "Vec_View<>::operator()(i1, i2): Indexing out of range");
+  return Vec_View<Num_T>(data + i1 * inc, i2 - i1 + 1, inc);
+}
+
+template<class Num_T>
+Mat_View<Num_T>::Mat_View(const Mat<Num_T> &m, int r1, int r2, int c1, int c2) :
+    rinc(1), cinc(m.rows())
+{
+  if (r1 == -1) r1 = m.rows() - 1;
+  if (r2 == -1) r2 = m.rows() - 1;
+  if (c1 == -1) c1 = m.cols() - 1;
+  if (c2 == -1) c2 = m.cols() - 1;
+  it_assert_debug((r1 >= 0) && (r1 <= r2) && (r2 < m.rows()) &&
+                  (c1 >= 0) && (c1 <= c2) && (c2 < m.cols()),
+                  "Mat_View<>::Mat_View(): Wrong indexing");
+  data = m._data() + r1 + c1 * cinc;
+  no_rows = r2 - r1 + 1;
+  no_cols = c2 - c1 + 1;
+}
+
+template<class Num_T>
+Mat_View<Num_T> Mat_View<Num_T>::operator()(int r1, int r2, int c1, int c2) const
+{
+  if (r1 == -1) r1 = no_rows - 1;
+  if (r2 == -1) r2 = no_rows - 1;
+  if (c1 == -1) c1 = no_cols - 1;
+  if (c2 == -1) c2 = no_cols - 1;
+  it_assert_debug((r1 >= 0) && (r1 <= r2) && (r2 < no_rows) &&
+                  (c1 >= 0) && (c1 <= c2) && (c2 < no_cols),
+                  "Mat_View<>::operator()(r1, r2, c1, c2): Wrong indexing");
+  return Mat_View<Num_T>(data + r1 * rinc + c1 * cinc, r2 - r1 + 1, c2 - c1 + 1,
+                         rinc, cinc);
+}
+
+//! \endcond
+
+// ----------------------------------------------------------------------
+// Type definitions
+// ----------------------------------------------------------------------
+
+/*!
+  \relates Vec_View
+  \brief Definition of double vector view type
+*/
+typedef Vec_View<double> vec_view;
+
+/*!
+  \relates Vec_View
+  \brief Definition of complex<double> vector view type
+*/
+typedef Vec_View<std::complex<double> > cvec_view;
+
+/*!
+  \relates Mat_View
+  \brief Definition of double matrix view type
+*/
+typedef Mat_View<double> mat_view;
+
+/*!
+  \relates Mat_View
+  \brief Definition of complex<double> matrix view type
+*/
+typedef Mat_View<std::complex<double> > cmat_view;
+
+// ----------------------------------------------------------------------
+// Functions on views
+// ----------------------------------------------------------------------
+
+/*!
+  \relates Vec_View
+  \brief Sum of all elements of the view
+*/
+template<class Num_T>
+Num_T sum(const Vec_View<Num_T> &v)
+{
+  Num_T M = Num_T(0);
+  for (int i = 0; i < v.size(); i++)
+    M += v[i];
+  return M;
+}
+
+/*!
+  \relates Mat_View
+  \brief Sum of the elements of each column (\c dim = 1) or each row (\c dim = 2)
+*/
+template<class Num_T>
+Vec<Num_T> sum(const Mat_View<Num_T> &m, int dim = 1)
+{
+  it_assert((dim == 1) || (dim == 2), "sum: dimension need to be 1 or 2");
+  Vec<Num_T> out;
+
+  if (dim == 1) {
+    out.set_size(m.cols(), false);
+    for (int i = 0; i < m.cols(); i++)
+      out(i) = sum(m.get_col(i));
+  }
+  else {
+    out.set_size(m.rows(), false);
+    for (int i = 0; i < m.rows(); i++)
+      out(i) = sum(m.get_row(i));
+  }
+
+  return out;
+}
+
+/*!
+  \relates Vec_View
+  \brief 2-norm of the view: norm(v)=sqrt(sum(abs(v).^2))
+*/
+template<class Num_T>
+double norm(const Vec_View<Num_T> &v)
+{
+  double E = 0.0;
+  for (int i = 0; i < v.size(); i++)
+    E += static_cast<double>(v[i]) * static_cast<double>(v[i]);
+  return std::sqrt(E);
+}
+
+/*!
+  \relates Vec_View
+  \brief 2-norm of the view: norm(v)=sqrt(sum(abs(v).^2))
+*/
+inline double norm(const cvec_view &v)
+{
+  double E = 0.0;
+  for (int i = 0; i < v.size(); i++)
+    E += std::norm(v[i]);
+  return std::sqrt(E);
+}
+
+/*!
+  \relates Vec_View
+  \brief Inner (dot) product of two views
+*/
+template<class Num_T>
+Num_T dot(const Vec_View<Num_T> &v1, const Vec_View<Num_T> &v2)
+{
+  it_assert_debug(v1.size() == v2.size(), "Vec_View<>::dot(): Wrong sizes");
+  Num_T r = Num_T(0);
+  for (int i = 0; i < v1.size(); i++)
+    r += v1[i] * v2[i];
+  return r;
+}
+
+//! \cond
+template<> ITPP_EXPORT double dot(const vec_view &v1, const vec_view &v2);
+//! \endcond
+
+/*!
+  \relates Mat_View
+  \brief Multiplication of two matrix views
+*/
+template<class Num_T>
+Mat<Num_T> operator*(const Mat_View<Num_T> &m1, const Mat_View<Num_T> &m2)
+{
+  it_assert_debug(m1.cols() == m2.rows(), "Mat_View<>::operator*(): Wrong sizes");
+  Mat<Num_T> r(m1.rows(), m2.cols());
+  for (int j = 0; j < r.cols(); j++)
+    for (int i = 0; i < r.rows(); i++) {
+      Num_T tmp = Num_T(0);
+      for (int k = 0; k < m1.cols(); k++)
+        tmp += m1(i, k) * m2(k, j);
+      r(i, j) = tmp;
+    }
+  return r;
+}
+
+//! \cond
+template<> ITPP_EXPORT mat operator*(const mat_view &m1, const mat_view &m2);
+template<> ITPP_EXPORT cmat operator*(const cmat_view &m1, const cmat_view &m2);
+//! \endcond
+
+/*!
+  \relates Mat_View
+  \brief Multiplication of a matrix view and a vector view (column vector)
+*/
+template<class Num_T>
+Vec<Num_T> operator*(const Mat_View<Num_T> &m, const Vec_View<Num_T> &v)
+{
+  it_assert_debug(m.cols() == v.size(), "Mat_View<>::operator*(): Wrong sizes");
+  Vec<Num_T> r(m.rows());
+  for (int i = 0; i < m.rows(); i++) {
+    r(i) = Num_T(0);
+    for (int k = 0; k < m.cols(); k++)
+      r(i) += m(i, k) * v[k];
+  }
+  return r;
+}
+
+//! \cond
+template<> ITPP_EXPORT vec operator*(const mat_view &m, const vec_view &v);
+template<> ITPP_EXPORT cvec operator*(const cmat_view &m, const cvec_view &v);
+//! \endcond
+
+} // namespace itpp
+
+#endif // #ifndef VIEW_H
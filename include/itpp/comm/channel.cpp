@@ -31,6 +31,7 @@
 #include <itpp/base/math/error.h>
 #include <itpp/base/math/trig_hyp.h>
 #include <itpp/base/bessel.h>
+#include <itpp/base/elem_expr.h>
 #include <itpp/base/matfunc.h>
 #include <itpp/base/specmat.h>
 #include <itpp/signal/resampling.h>
@@ -301,16 +302,16 @@ void Rice_Fading_Generator::generate(int no_samples, cvec &output)
     double tmp_re, tmp_im;
     if (los_power > 0.0) { // LOS component exists
       for (int i = 0; i < no_samples; i++) {
-        tmp_re = sum(elem_mult(c1, cos(m_2pi * f1 * n_dopp * (i + time_offset) + th1)));
-        tmp_im = sum(elem_mult(c2, cos(m_2pi * f2 * n_dopp * (i + time_offset) + th2)));
+        tmp_re = sum(elem_mult(lazy(c1), cos(m_2pi * lazy(f1) * n_dopp * (i + time_offset) + lazy(th1))));
+        tmp_im = sum(elem_mult(lazy(c2), cos(m_2pi * lazy(f2) * n_dopp * (i + time_offset) + lazy(th2))));
         output(i) = std::complex<double>(tmp_re, tmp_im);
         add_LOS(i, output(i));
       }
     }
     else {
       for (int i = 0; i < no_samples; i++) {
-        tmp_re = sum(elem_mult(c1, cos(m_2pi * f1 * n_dopp * (i + time_offset) + th1)));
-        tmp_im = sum(elem_mult(c2, cos(m_2pi * f2 * n_dopp * (i + time_offset) + th2)));
+        tmp_re = sum(elem_mult(lazy(c1), cos(m_2pi * lazy(f1) * n_dopp * (i + time_offset) + lazy(th1))));
+        tmp_im = sum(elem_mult(lazy(c2), cos(m_2pi * lazy(f2) * n_dopp * (i + time_offset) + lazy(th2))));
         output(i) = std::complex<double>(tmp_re, tmp_im);
       }
     }
@@ -321,9 +322,9 @@ void Rice_Fading_Generator::generate(int no_samples, cvec &output)
     double tmp;
     for (int i = 0; i < no_samples; i++) {
       tmp = m_2pi * n_dopp * (i + time_offset);
-      output(i) = sum(elem_mult(c1, cos(f1 * tmp + th1)))
+      output(i) = sum(elem_mult(lazy(c1), cos(lazy(f1) * tmp + lazy(th1))))
                   * std::complex<double>(std::cos(f01 * tmp), -std::sin(f01 * tmp))
-                  + sum(elem_mult(c2, cos(f2 * tmp + th2)))
+                  + sum(elem_mult(lazy(c2), cos(lazy(f2) * tmp + lazy(th2))))
                   * std::complex<double>(std::cos(f02 * tmp), -std::sin(f02 * tmp));
     }
     break;
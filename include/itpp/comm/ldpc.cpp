@@ -27,6 +27,9 @@
  */
 
 #include <itpp/comm/ldpc.h>
+#include <itpp/comm/ldpc_min_sum.h>
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <sstream>
 
@@ -1042,7 +1045,8 @@ void LDPC_Generator_Systematic::encode(const bvec &input, bvec &output)
 
 BLDPC_Generator::BLDPC_Generator(const BLDPC_Parity* const H,
                                  const std::string type):
-    LDPC_Generator(type), H_enc(), N(0), M(0), K(0), Z(0)
+    LDPC_Generator(type), H_enc(), N(0), M(0), K(0), Z(0), H_b(),
+    qc_shift(-1)
 {
   construct(H);
 }
@@ -1055,6 +1059,11 @@ void BLDPC_Generator::encode(const bvec &input, bvec &output)
   it_assert(input.size() == K, "BLDPC_Generator::encode(): Input vector "
             "length is not equal to K");
 
+  if (qc_shift >= 0) {
+    encode_qc(input, output);
+    return;
+  }
+
   // copy systematic bits first
   output = input;
   output.set_size(N, true);
@@ -1132,10 +1141,105 @@ void BLDPC_Generator::construct(const BLDPC_Parity* const H)
       r1++;
     }
 
+    H_b = H->get_base_matrix();
+    setup_qc_encoder();
     mark_initialized();
   }
 }
 
+void BLDPC_Generator::setup_qc_encoder()
+{
+  qc_shift = -1;
+  int mb = H_b.rows();
+  int kb = H_b.cols() - mb;
+  if ((mb < 2) || (kb < 1) || (mb * Z != M) || (H_b.cols() * Z != N)) {
+    return;
+  }
+
+  // block columns kb+1 .. kb+mb-1: identities on the rows t and t+1
+  for (int t = 0; t < mb - 1; t++) {
+    for (int r = 0; r < mb; r++) {
+      int h = H_b(r, kb + 1 + t);
+      if ((r == t) || (r == t + 1)) {
+        if ((h < 0) || (h % Z != 0))
+          return;
+      }
+      else if (h >= 0) {
+        return;
+      }
+    }
+  }
+
+  // block column kb: the sum of its circulants must be a single one, so
+  // that the sum of all the block rows gives the first parity block
+  ivec count = zeros_i(Z);
+  for (int r = 0; r < mb; r++) {
+    if (H_b(r, kb) >= 0)
+      count(H_b(r, kb) % Z)++;
+  }
+  int shift = -1;
+  for (int h = 0; h < Z; h++) {
+    if (count(h) & 1) {
+      if (shift >= 0)
+        return;
+      shift = h;
+    }
+  }
+  qc_shift = shift;
+}
+
+// y += P^h x, on blocks of Z bits: y(i) += x((i + h) mod Z)
+static void qc_add_shifted(bin *y, const bin *x, int h, int Z)
+{
+  for (int i = 0; i < Z - h; i++)
+    y[i] += x[i + h];
+  for (int i = Z - h; i < Z; i++)
+    y[i] += x[i + h - Z];
+}
+
+void BLDPC_Generator::encode_qc(const bvec &input, bvec &output) const
+{
+  int mb = H_b.rows();
+  int kb = H_b.cols() - mb;
+
+  output = input;
+  output.set_size(N, true);
+  const bin *s = input._data();
+  bin *p = output._data() + K;
+
+  // products of the block rows by the systematic part, and their sum
+  bvec lambda(M), sigma(Z);
+  lambda.zeros();
+  sigma.zeros();
+  for (int r = 0; r < mb; r++) {
+    bin *l = lambda._data() + r * Z;
+    for (int c = 0; c < kb; c++) {
+      if (H_b(r, c) >= 0)
+        qc_add_shifted(l, s + c * Z, H_b(r, c) % Z, Z);
+    }
+    for (int i = 0; i < Z; i++)
+      sigma(i) += l[i];
+  }
+
+  // the identities of the dual diagonal cancel in the sum of the block
+  // rows, leaving P^qc_shift p_0 = sigma
+  qc_add_shifted(p, sigma._data(), (Z - qc_shift) % Z, Z);
+
+  // block row t gives p_(t+1) = p_t + lambda_t + P^h(t) p_0
+  for (int t = 0; t < mb - 1; t++) {
+    bin *next = p + (t + 1) * Z;
+    const bin *l = lambda._data() + t * Z;
+    for (int i = 0; i < Z; i++)
+      next[i] = l[i];
+    if (t > 0) {
+      for (int i = 0; i < Z; i++)
+        next[i] += p[t * Z + i];
+    }
+    if (H_b(t, kb) >= 0)
+      qc_add_shifted(next, p, H_b(t, kb) % Z, Z);
+  }
+}
+
 
 void BLDPC_Generator::save(const std::string& filename) const
 {
@@ -1158,6 +1262,8 @@ void BLDPC_Generator::save(const std::string& filename) const
   f << Name("H_T") << H_T;
   f << Name("H_Z") << H_Z;
   f << Name("Z") << Z;
+  if (qc_shift >= 0)
+    f << Name("H_b") << H_b;
   f.close();
 }
 
@@ -1177,6 +1283,9 @@ void BLDPC_Generator::load(const std::string& filename)
   f >> Name("H_T") >> H_T;
   f >> Name("H_Z") >> H_Z;
   f >> Name("Z") >> Z;
+  H_b.set_size(0, 0);
+  if (f.seek("H_b"))
+    f >> Name("H_b") >> H_b;
   f.close();
 
   N = H_T.cols();
@@ -1195,6 +1304,7 @@ void BLDPC_Generator::load(const std::string& filename)
   }
   H_enc = H_enc.concatenate_vertical(H_Z);
 
+  setup_qc_encoder();
   mark_initialized();
 }
 
@@ -1205,13 +1315,16 @@ void BLDPC_Generator::load(const std::string& filename)
 
 LDPC_Code::LDPC_Code(): H_defined(false), G_defined(false), dec_method(new std::string),
     max_iters(50), psc(true), pisc(false),
-    llrcalc(LLR_calc_unit()) { set_decoding_method("BP");}
+    llrcalc(LLR_calc_unit()), ms_factor(0.75), ms_offset(0.5), ms_bits(8),
+    qc_Z(0)
+{ set_decoding_method("BP");}
 
 LDPC_Code::LDPC_Code(const LDPC_Parity* const H,
                      LDPC_Generator* const G_in,
                      bool perform_integrity_check):
     H_defined(false), G_defined(false), dec_method(new std::string), max_iters(50),
-    psc(true), pisc(false), llrcalc(LLR_calc_unit())
+    psc(true), pisc(false), llrcalc(LLR_calc_unit()), ms_factor(0.75),
+    ms_offset(0.5), ms_bits(8), qc_Z(0)
 {
     set_decoding_method("BP");
     set_code(H, G_in, perform_integrity_check);
@@ -1220,7 +1333,8 @@ LDPC_Code::LDPC_Code(const LDPC_Parity* const H,
 LDPC_Code::LDPC_Code(const std::string& filename,
                      LDPC_Generator* const G_in):
     H_defined(false), G_defined(false), dec_method(new std::string), max_iters(50),
-    psc(true), pisc(false), llrcalc(LLR_calc_unit())
+    psc(true), pisc(false), llrcalc(LLR_calc_unit()), ms_factor(0.75),
+    ms_offset(0.5), ms_bits(8), qc_Z(0)
 {
   set_decoding_method("BP");
   load_code(filename, G_in);
@@ -1232,6 +1346,7 @@ void LDPC_Code::set_code(const LDPC_Parity* const H,
                          bool perform_integrity_check)
 {
   decoder_parameterization(H);
+  qc_parameterization(H);
   setup_decoder();
   G = G_in;
   if (G != 0) {
@@ -1265,6 +1380,11 @@ void LDPC_Code::load_code(const std::string& filename,
   f >> Name("sumX2") >> sumX2;
   f >> Name("iind") >> iind;
   f >> Name("jind") >> jind;
+  qc_Z = 0;
+  if (f.seek("qc_Z")) {
+    f >> Name("qc_Z") >> qc_Z;
+    f >> Name("qc_base") >> qc_base;
+  }
   f.close();
 
   // load generator data
@@ -1306,6 +1426,10 @@ void LDPC_Code::save_code(const std::string& filename) const
   f << Name("sumX2") << sumX2;
   f << Name("iind") << iind;
   f << Name("jind") << jind;
+  if (qc_Z > 0) {
+    f << Name("qc_Z") << qc_Z;
+    f << Name("qc_base") << qc_base;
+  }
   f.close();
 
   // save generator data;
@@ -1322,11 +1446,28 @@ void LDPC_Code::save_code(const std::string& filename) const
 
 void LDPC_Code::set_decoding_method(const std::string& method_in)
 {
-  it_assert((method_in == "bp") || (method_in == "BP"),
+  it_assert((method_in == "bp") || (method_in == "BP")
+            || (method_in == "lnms") || (method_in == "LNMS")
+            || (method_in == "loms") || (method_in == "LOMS"),
             "LDPC_Code::set_decoding_method(): Not implemented decoding method");
   *dec_method = method_in;
 }
 
+void LDPC_Code::set_min_sum_parameters(double normalization, double offset,
+                                       int msg_bits)
+{
+  it_assert((normalization > 0) && (normalization <= 1),
+            "LDPC_Code::set_min_sum_parameters(): Normalization factor "
+            "must be in (0, 1]");
+  it_assert((offset >= 0) && (offset < 1000), "LDPC_Code::"
+            "set_min_sum_parameters(): Offset out of range");
+  it_assert((msg_bits == 8) || (msg_bits == 16), "LDPC_Code::"
+            "set_min_sum_parameters(): Messages must have 8 or 16 bits");
+  ms_factor = normalization;
+  ms_offset = offset;
+  ms_bits = msg_bits;
+}
+
 void LDPC_Code::set_exit_conditions(int max_iters_in,
                                     bool syndr_check_each_iter,
                                     bool syndr_check_at_start)
@@ -1364,7 +1505,7 @@ void LDPC_Code::decode(const vec &llr_in, bvec &syst_bits)
 {
   QLLRvec qllrin = llrcalc.to_qllr(llr_in);
   QLLRvec qllrout;
-  bp_decode(qllrin, qllrout);
+  decode_method(qllrin, qllrout);
   syst_bits = (qllrout.left(nvar - ncheck) < 0);
 }
 
@@ -1379,7 +1520,7 @@ void LDPC_Code::decode_soft_out(const vec &llr_in, vec &llr_out)
 {
   QLLRvec qllrin = llrcalc.to_qllr(llr_in);
   QLLRvec qllrout;
-  bp_decode(qllrin, qllrout);
+  decode_method(qllrin, qllrout);
   llr_out = llrcalc.to_double(qllrout);
 }
 
@@ -1390,7 +1531,98 @@ vec LDPC_Code::decode_soft_out(const vec &llr_in)
   return llr_out;
 }
 
+void LDPC_Code::decode(const mat &llr_in, bmat &syst_bits)
+{
+  QLLRmat qllrout;
+  decode_batch(llrcalc.to_qllr(llr_in), qllrout);
+  syst_bits.set_size(nvar - ncheck, qllrout.cols());
+  for (int j = 0; j < qllrout.cols(); j++) {
+    for (int i = 0; i < nvar - ncheck; i++) {
+      syst_bits(i, j) = (qllrout(i, j) < 0);
+    }
+  }
+}
+
+bmat LDPC_Code::decode(const mat &llr_in)
+{
+  bmat syst_bits;
+  decode(llr_in, syst_bits);
+  return syst_bits;
+}
+
+void LDPC_Code::decode_soft_out(const mat &llr_in, mat &llr_out)
+{
+  QLLRmat qllrout;
+  decode_batch(llrcalc.to_qllr(llr_in), qllrout);
+  llr_out = llrcalc.to_double(qllrout);
+}
+
+mat LDPC_Code::decode_soft_out(const mat &llr_in)
+{
+  mat llr_out;
+  decode_soft_out(llr_in, llr_out);
+  return llr_out;
+}
+
+ivec LDPC_Code::decode_batch(const QLLRmat &LLRin, QLLRmat &LLRout) const
+{
+  it_assert(H_defined, "LDPC_Code::decode_batch(): Parity check matrix not "
+            "defined");
+  it_assert(LLRin.rows() == nvar, "LDPC_Code::decode_batch(): Wrong input "
+            "dimensions");
+
+  const int ncw = LLRin.cols();
+  LLRout.set_size(nvar, ncw);
+  ivec iters(ncw);
+
+  // The threads share the parity check structure and own their messages
+  if ((*dec_method == "bp") || (*dec_method == "BP")) {
+#pragma omp parallel
+    {
+      QLLRvec mvc_t(mvc.size()), mcv_t(mcv.size()), in, out;
+#pragma omp for schedule(dynamic)
+      for (int j = 0; j < ncw; j++) {
+        in = LLRin.get_col(j);
+        iters(j) = bp_decode(in, out, mvc_t, mcv_t);
+        LLRout.set_col(j, out);
+      }
+    }
+  }
+  else if (qc_Z > 0) {
+#pragma omp parallel
+    {
+      svec post, msg;
+      QLLRvec in, out;
+#pragma omp for schedule(dynamic)
+      for (int j = 0; j < ncw; j++) {
+        in = LLRin.get_col(j);
+        iters(j) = min_sum_decode(in, out, post, msg);
+        LLRout.set_col(j, out);
+      }
+    }
+  }
+  else {
+    const int nbatches = (ncw + ldpc_ms_lanes - 1) / ldpc_ms_lanes;
+#pragma omp parallel
+    {
+      svec post, msg;
+#pragma omp for schedule(dynamic)
+      for (int b = 0; b < nbatches; b++) {
+        min_sum_decode_frames(LLRin, b * ldpc_ms_lanes, LLRout, iters, post,
+                              msg);
+      }
+    }
+  }
+  return iters;
+}
+
 int LDPC_Code::bp_decode(const QLLRvec &LLRin, QLLRvec &LLRout)
+{
+  return bp_decode(LLRin, LLRout, mvc, mcv);
+}
+
+int LDPC_Code::bp_decode(const QLLRvec &LLRin, QLLRvec &LLRout,
+                         QLLRvec &mvc, QLLRvec &mcv) const
 {
   // Note the IT++ convention that a sure zero corresponds to
   // LLR=+infinity
@@ -1633,6 +1865,204 @@ int LDPC_Code::bp_decode(const QLLRvec &LLRin, QLLRvec &LLRout)
 }
 
 
+// Fixed-point unit of the min-sum methods, 2^-frac with msg_bits bits
+static int ms_frac(int msg_bits)
+{
+  return (msg_bits == 8) ? 2 : 4;
+}
+
+static LDPC_MS_Update ms_update(const std::string &method, double factor,
+                                double offset, int msg_bits)
+{
+  LDPC_MS_Update u;
+  u.post_max = (1 << 14) - 1;
+  u.msg_max = (msg_bits == 8) ? 127 : u.post_max;
+  if ((method == "lnms") || (method == "LNMS")) {
+    u.factor = std::max(round_i(16 * factor), 1);
+    u.offset = 0;
+  }
+  else {
+    u.factor = 16;
+    u.offset = std::min(round_i((1 << ms_frac(msg_bits)) * offset),
+                        u.post_max);
+  }
+  return u;
+}
+
+static short ms_fixed(const LLR_calc_unit &llrcalc, QLLR l, double scale,
+                      int post_max)
+{
+  double x = std::floor(0.5 + scale * llrcalc.to_double(l));
+  return static_cast<short>(std::max(std::min(x, double(post_max)),
+                                     double(-post_max)));
+}
+
+int LDPC_Code::min_sum_decode(const QLLRvec &LLRin, QLLRvec &LLRout)
+{
+  return min_sum_decode(LLRin, LLRout, ms_post, ms_msg);
+}
+
+int LDPC_Code::min_sum_decode(const QLLRvec &LLRin, QLLRvec &LLRout,
+                              svec &post_buf, svec &msg_buf) const
+{
+  it_assert(H_defined, "LDPC_Code::min_sum_decode(): Parity check matrix "
+            "not defined");
+  it_assert((LLRin.size() == nvar) && (sumX1.size() == nvar)
+            && (sumX2.size() == ncheck), "LDPC_Code::min_sum_decode(): "
+            "Wrong input dimensions");
+
+  if (pisc && syndrome_check(LLRin)) {
+    LLRout = LLRin;
+    return 0;
+  }
+
+  const double scale = 1 << ms_frac(ms_bits);
+  const LDPC_MS_Update u = ms_update(*dec_method, ms_factor, ms_offset,
+                                     ms_bits);
+
+  post_buf.set_size(ms_post.size());
+  msg_buf.set_size(ms_msg.size());
+  short *post = post_buf._data();
+  for (int i = 0; i < nvar; i++) {
+    post[i] = ms_fixed(llrcalc, LLRin(i), scale, u.post_max);
+  }
+  post[nvar] = 0;
+  msg_buf.zeros();
+
+  int iter = 0;
+  bool is_valid_codeword = false;
+  do {
+    iter++;
+    min_sum_iteration(post, msg_buf, u);
+
+    if (psc) {
+      // syndrome check on the fixed-point LLRs
+      bool valid = true;
+      for (int j = 0; (j < ncheck) && valid; j++) {
+        int synd = 0;
+        int vind = j; // tracks j+i*ncheck
+        for (int i = 0; i < sumX2(j); i++) {
+          synd += (post[V(vind)] < 0);
+          vind += ncheck;
+        }
+        valid = ((synd & 1) == 0);
+      }
+      if (valid) {
+        is_valid_codeword = true;
+        break;
+      }
+    }
+  }
+  while (iter < max_iters);
+
+  LLRout.set_size(nvar);
+  for (int i = 0; i < nvar; i++) {
+    LLRout(i) = llrcalc.to_qllr(post[i] / scale);
+  }
+  return (is_valid_codeword ? iter : -iter);
+}
+
+void LDPC_Code::min_sum_iteration(short *post, svec &msg,
+                                  const LDPC_MS_Update &u) const
+{
+  if (qc_Z > 0) {
+    // the work space of the layers follows the posterior LLRs
+    short *work = post + nvar + 1;
+    if (ms_bits == 8) {
+      ldpc_ms_iteration_qc(qc_deg.size(), qc_deg._data(), qc_cols._data(),
+                           qc_shifts._data(), qc_Z, post,
+                           reinterpret_cast<signed char *>(msg._data()),
+                           work, u);
+    }
+    else {
+      ldpc_ms_iteration_qc(qc_deg.size(), qc_deg._data(), qc_cols._data(),
+                           qc_shifts._data(), qc_Z, post, msg._data(), work,
+                           u);
+    }
+  }
+  else if (ms_bits == 8) {
+    ldpc_ms_iteration(ms_deg.size(), ms_deg._data(), ms_vars._data(), post,
+                      reinterpret_cast<signed char *>(msg._data()), u);
+  }
+  else {
+    ldpc_ms_iteration(ms_deg.size(), ms_deg._data(), ms_vars._data(), post,
+                      msg._data(), u);
+  }
+}
+
+void LDPC_Code::min_sum_decode_frames(const QLLRmat &LLRin, int first,
+                                      QLLRmat &LLRout, ivec &iters,
+                                      svec &post_buf, svec &msg_buf) const
+{
+  const int L = ldpc_ms_lanes;
+  const int count = std::min(L, LLRin.cols() - first);
+
+  // bit f tells that the codeword first + f is still being decoded
+  unsigned int active = 0;
+  for (int f = 0; f < count; f++) {
+    if (pisc && syndrome_check(LLRin.get_col(first + f))) {
+      LLRout.set_col(first + f, LLRin.get_col(first + f));
+      iters(first + f) = 0;
+    }
+    else {
+      active |= 1u << f;
+    }
+  }
+  if (active == 0) {
+    return;
+  }
+
+  const double scale = 1 << ms_frac(ms_bits);
+  const LDPC_MS_Update u = ms_update(*dec_method, ms_factor, ms_offset,
+                                     ms_bits);
+
+  post_buf.set_size((nvar + 1) * L);
+  msg_buf.set_size(ms_vars.size() * L);
+  short *post = post_buf._data();
+  for (int i = 0; i < nvar; i++) {
+    for (int f = 0; f < L; f++) {
+      post[i * L + f] = (f < count) ?
+                        ms_fixed(llrcalc, LLRin(i, first + f), scale, u.post_max) : 0;
+    }
+  }
+  for (int f = 0; f < L; f++) {
+    post[nvar * L + f] = 0;
+  }
+  msg_buf.zeros();
+
+  const int ngroups = ms_deg.size();
+  int iter = 0;
+  do {
+    iter++;
+    if (ms_bits == 8) {
+      ldpc_ms_iteration_frames(ngroups, ms_deg._data(), ms_vars._data(), nvar,
+                               post, reinterpret_cast<signed char *>(msg_buf._data()), u);
+    }
+    else {
+      ldpc_ms_iteration_frames(ngroups, ms_deg._data(), ms_vars._data(), nvar,
+                               post, msg_buf._data(), u);
+    }
+
+    unsigned int valid = 0;
+    if (psc) {
+      valid = active & ~ldpc_ms_syndrome_frames(ngroups, ms_deg._data(),
+                                                ms_vars._data(), nvar, post);
+    }
+    // the codewords which are done leave the batch
+    const unsigned int done = (iter < max_iters) ? valid : active;
+    for (int f = 0; f < count; f++) {
+      if (done & (1u << f)) {
+        for (int i = 0; i < nvar; i++) {
+          LLRout(i, first + f) = llrcalc.to_qllr(post[i * L + f] / scale);
+        }
+        iters(first + f) = (valid & (1u << f)) ? iter : -iter;
+      }
+    }
+    active &= ~done;
+  }
+  while (active != 0);
+}
+
 bool LDPC_Code::syndrome_check(const bvec &x) const
 {
   QLLRvec llr = 1 - 2 * to_ivec(x);
@@ -1754,12 +2184,63 @@ void LDPC_Code::decoder_parameterization(const LDPC_Parity* const Hmat)
 }
 
 
+void LDPC_Code::qc_parameterization(const LDPC_Parity* const H)
+{
+  const BLDPC_Parity *B = dynamic_cast<const BLDPC_Parity *>(H);
+  if ((B != 0) && B->is_valid()) {
+    qc_Z = B->get_exp_factor();
+    qc_base = B->get_base_matrix();
+  }
+  else {
+    qc_Z = 0;
+    qc_base.set_size(0, 0);
+  }
+}
+
 void LDPC_Code::setup_decoder()
 {
   if (H_defined) {
     mcv.set_size(max(sumX2) * ncheck);
     mvc.set_size(max(sumX1) * nvar);
+
+    if (qc_Z > 0) {
+      // one layer per row of the base matrix
+      qc_deg.set_size(qc_base.rows());
+      qc_cols.set_size(0);
+      qc_shifts.set_size(0);
+      for (int r = 0; r < qc_base.rows(); r++) {
+        qc_deg(r) = 0;
+        for (int c = 0; c < qc_base.cols(); c++) {
+          if (qc_base(r, c) >= 0) {
+            qc_deg(r)++;
+            qc_cols = concat(qc_cols, c);
+            qc_shifts = concat(qc_shifts, qc_base(r, c) % qc_Z);
+          }
+        }
+        it_assert(qc_deg(r) <= ldpc_ms_max_degree, "LDPC_Code::"
+                  "setup_decoder(): Check degree too large for the layered "
+                  "decoder");
+      }
+      ms_deg.set_size(0);
+      ms_vars.set_size(0);
+      const int zp = ldpc_ms_qc_padding(qc_Z);
+      ms_post.set_size(nvar + 1 + max(qc_deg) * zp);
+      ms_msg.set_size(qc_cols.size() * zp);
+    }
+    else {
+      ldpc_ms_schedule(nvar, ncheck, V, sumX2, ms_deg, ms_vars);
+      ms_post.set_size(nvar + 1);
+      ms_msg.set_size(ms_vars.size());
+    }
+  }
+}
+
+int LDPC_Code::decode_method(const QLLRvec &LLRin, QLLRvec &LLRout)
+{
+  if ((*dec_method == "bp") || (*dec_method == "BP")) {
+    return bp_decode(LLRin, LLRout);
   }
+  return min_sum_decode(LLRin, LLRout);
 }
 
 
@@ -1803,7 +2284,11 @@ std::ostream &operator<<(std::ostream &os, const LDPC_Code &C)
   os << "--- LDPC codec ----------------------------------\n"
   << "Nvar : " << C.get_nvar() << "\n"
   << "Ncheck : " << C.get_ncheck() << "\n"
-  << "Rate : " << C.get_rate() << "\n"
+  << "Rate : " << C.get_rate() << "\n";
+  if (C.qc_Z > 0) {
+    os << "Expansion factor : " << C.qc_Z << "\n";
+  }
+  os
   << "Column degrees (node perspective): " << cdeg << "\n"
   << "Row degrees (node perspective): " << rdeg << "\n"
   << "-------------------------------------------------\n"
@@ -1811,7 +2296,13 @@ std::ostream &operator<<(std::ostream &os, const LDPC_Code &C)
   << " - method : " << C.get_decoding_method() << "\n"
   << " - max. iterations : " << C.max_iters << "\n"
   << " - syndrome check at each iteration : " << C.psc << "\n"
-  << " - syndrome check at start : " << C.pisc << "\n"
+  << " - syndrome check at start : " << C.pisc << "\n";
+  if ((C.get_decoding_method() != "bp") && (C.get_decoding_method() != "BP")) {
+    os << " - normalization factor : " << C.ms_factor << "\n"
+    << " - offset : " << C.ms_offset << "\n"
+    << " - message bits : " << C.ms_bits << "\n";
+  }
+  os
   << "-------------------------------------------------\n"
   << C.llrcalc << "\n";
   return os;
@@ -646,7 +646,8 @@ class ITPP_EXPORT BLDPC_Generator : public LDPC_Generator
 public:
   //! Default constructor
   BLDPC_Generator(const std::string type = "BLDPC"):
-      LDPC_Generator(type), H_enc(), N(0), M(0), K(0), Z(0) {}
+      LDPC_Generator(type), H_enc(), N(0), M(0), K(0), Z(0), H_b(),
+      qc_shift(-1) {}
   //! Parametrized constructor
   BLDPC_Generator(const BLDPC_Parity* const H,
                   const std::string type = "BLDPC");
@@ -654,7 +655,16 @@ public:
   //! Get expansion factor
   int get_exp_factor() const { return Z; }
 
-  //! Generator specific encode function
+  /*!
+    \brief Generator specific encode function
+
+    When the parity part of the base matrix has the dual-diagonal
+    structure of [MYK05] (as in IEEE 802.16e and 802.11n), and the
+    circulants of its first column sum to a single shifted identity, the
+    parity bits are computed block by block from the base matrix, with
+    cyclic shifts of Z-bit blocks. Other codes use the preprocessed
+    parity check matrix.
+  */
   void encode(const bvec &input, bvec &output);
 
   //! Construct the BLDPC generator
@@ -671,6 +681,14 @@ protected:
   int M;       //!< Number of parity check bits = H_enc.rows()
   int K;   //!< Number of information bits = N-M
   int Z;   //!< Expansion factor
+  imat H_b;  //!< Base matrix
+  int qc_shift;  //!< Shift solving the first parity block, or -1
+
+private:
+  //! Check whether \c encode() can work on the base matrix
+  void setup_qc_encoder();
+  //! Encode with the base matrix
+  void encode_qc(const bvec &input, bvec &output) const;
 };
 
 
@@ -678,6 +696,10 @@ protected:
 // LDPC_Code
 // ----------------------------------------------------------------------
 
+//! \cond
+struct LDPC_MS_Update;
+//! \endcond
+
 /*!
   \ingroup fec
   \brief Low-density parity check (LDPC) codec
@@ -798,13 +820,32 @@ public:
   /*!
     \brief Set the decoding method
 
-    Currently only a belief propagation method ("BP" or "bp") is
-    supported.
+    The supported methods are:
+    - "BP" or "bp": belief propagation, see \c bp_decode()
+    - "LNMS" or "lnms": layered normalized min-sum, see \c min_sum_decode()
+    - "LOMS" or "loms": layered offset min-sum, see \c min_sum_decode()
 
     \note The default method set in the class constructors is "BP".
   */
   void set_decoding_method(const std::string& method);
 
+  /*!
+    \brief Set the parameters of the min-sum decoding methods
+
+    \param normalization Factor applied to the check to variable messages
+    by the "LNMS" method, in (0, 1]. It is rounded to a multiple of 1/16.
+    \param offset Value subtracted from the magnitude of the check to
+    variable messages by the "LOMS" method
+    \param msg_bits Number of bits of the check to variable messages, 8
+    or 16. The 8-bit messages have a resolution of 1/4 and saturate at
+    31.75, the 16-bit ones a resolution of 1/16.
+
+    \note The default values set in the class constructors are: "0.75",
+    "0.5" and "8", respectively.
+  */
+  void set_min_sum_parameters(double normalization = 0.75,
+                              double offset = 0.5, int msg_bits = 8);
+
   /*!
     \brief Set the decoding loop exit conditions
 
@@ -859,11 +900,43 @@ public:
   //! This function outputs systematic bits of the decoded codeword
   virtual bvec decode(const vec &llr_in);
 
-  //! This function is a wrapper for \c bp_decode()
+  //! This function is a wrapper for \c bp_decode() or \c min_sum_decode()
   void decode_soft_out(const vec &llr_in, vec &llr_out);
-  //! This function is a wrapper for \c bp_decode()
+  //! This function is a wrapper for \c bp_decode() or \c min_sum_decode()
   vec decode_soft_out(const vec &llr_in);
 
+  //! Outputs the systematic bits of the codewords in the columns of \c llr_in
+  void decode(const mat &llr_in, bmat &syst_bits);
+  //! Outputs the systematic bits of the codewords in the columns of \c llr_in
+  bmat decode(const mat &llr_in);
+
+  //! This function is a wrapper for \c decode_batch()
+  void decode_soft_out(const mat &llr_in, mat &llr_out);
+  //! This function is a wrapper for \c decode_batch()
+  mat decode_soft_out(const mat &llr_in);
+
+  /*! \brief Decoding of several codewords
+
+    Decodes each column of \c LLRin with the method set in \c
+    set_decoding_method(), giving the same results as \c bp_decode() or
+    \c min_sum_decode() called on each column in turn.
+
+    The codewords are spread over the OpenMP threads, which share the
+    parity check structure of the codec and each use their own message
+    buffers, so that the object is not modified. With the min-sum
+    methods, the codewords are moreover decoded 16 at a time, in the
+    lanes of vector registers: a batch runs until all its codewords meet
+    the exit conditions. Quasi-cyclic codes are already vectorized within
+    each codeword and are decoded one codeword per thread.
+
+    \param LLRin  matrix of \c nvar input LLR values per column
+    \param LLRout matrix of \c nvar output LLR values per column
+
+    Returns for each codeword the number of iterations performed, with a
+    negative sign if the decoder did not converge to a valid codeword.
+  */
+  ivec decode_batch(const QLLRmat &LLRin, QLLRmat &LLRout) const;
+
   /*! \brief Belief propagation decoding.
 
     This function implements the sum-product message passing decoder
@@ -888,6 +961,34 @@ public:
   */
   int bp_decode(const QLLRvec &LLRin, QLLRvec &LLRout);
 
+  /*! \brief Layered min-sum decoding.
+
+    This function implements a layered (row-serial) min-sum decoder: the
+    checks are updated one after the other, each one using the posterior
+    LLRs already updated by the previous checks, which roughly halves the
+    number of iterations needed compared with \c bp_decode(). The check
+    node update keeps the two smallest input magnitudes, which are
+    multiplied by the normalization factor ("LNMS" method) or reduced by
+    the offset ("LOMS" method) set in \c set_min_sum_parameters().
+
+    The LLRs are saturated fixed-point numbers: 16 bits for the posterior
+    LLRs, 8 or 16 bits for the messages. Checks of equal degree and with
+    no variable in common are processed 16 at a time in the lanes of
+    vector registers.
+
+    For the codes defined by a \c BLDPC_Parity, the layers are the rows
+    of the base matrix: the decoder keeps the base matrix and processes
+    each circulant as a cyclic shift of a block of \c Z contiguous LLRs,
+    instead of looking up the variables of each check.
+
+    \param LLRin  vector of \c nvar input LLR values
+    \param LLRout vector of \c nvar output LLR values
+
+    The return value and the exit conditions are the same as those of
+    \c bp_decode().
+  */
+  int min_sum_decode(const QLLRvec &LLRin, QLLRvec &LLRout);
+
   /*! \brief Syndrome check, on QLLR vector
 
     This function performs a syndrome check on a softbit (LLR
@@ -949,6 +1050,28 @@ protected:
   //! Initialize decoder
   void setup_decoder();
 
+  //! Decode with the method set in \c set_decoding_method()
+  int decode_method(const QLLRvec &LLRin, QLLRvec &LLRout);
+
+  //! \c bp_decode() with the given message buffers
+  int bp_decode(const QLLRvec &LLRin, QLLRvec &LLRout, QLLRvec &mvc,
+                QLLRvec &mcv) const;
+
+  //! \c min_sum_decode() with the given buffers
+  int min_sum_decode(const QLLRvec &LLRin, QLLRvec &LLRout, svec &post,
+                     svec &msg) const;
+
+  //! Min-sum decoding of up to 16 columns of \c LLRin, from \c first
+  void min_sum_decode_frames(const QLLRmat &LLRin, int first, QLLRmat &LLRout,
+                             ivec &iters, svec &post, svec &msg) const;
+
+  //! One min-sum iteration on the posterior LLRs \c post
+  void min_sum_iteration(short *post, svec &msg,
+                         const LDPC_MS_Update &u) const;
+
+  //! Keep the base matrix of \c H if it is a \c BLDPC_Parity
+  void qc_parameterization(const LDPC_Parity* const H);
+
 private:
   bool H_defined;  //!< true if parity check matrix is defined
   bool G_defined;  //!< true if generator is defined
@@ -962,12 +1085,27 @@ private:
   bool psc;   //!< check syndrom after each iteration
   bool pisc;   //!< check syndrom before first iteration
   LLR_calc_unit llrcalc; //!< LLR calculation unit
+  double ms_factor; //!< normalization factor of the min-sum methods
+  double ms_offset; //!< offset of the min-sum methods
+  int ms_bits; //!< number of bits of the min-sum messages
   // Parity check matrix parameterization
   ivec C, V, sumX1, sumX2, iind, jind;
 
   // temporary storage for decoder (memory allocated when codec defined)
   QLLRvec mvc, mcv;
 
+  // layered min-sum decoder: degree and variables of the groups of checks,
+  // posterior LLRs and messages (the 8-bit messages using half of ms_msg)
+  ivec ms_deg, ms_vars;
+  svec ms_post, ms_msg;
+
+  // quasi-cyclic codes: expansion factor (0 for other codes) and base
+  // matrix, and the block columns and shifts of the circulants of each
+  // layer, which replace ms_vars
+  int qc_Z;
+  imat qc_base;
+  ivec qc_deg, qc_cols, qc_shifts;
+
   //! Maximum check node degree that the class can handle
   static const int max_cnd = 200;
 };
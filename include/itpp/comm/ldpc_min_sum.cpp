@@ -0,0 +1,308 @@
+/*!
+ * \file
+ * \brief Layered min-sum kernels of the LDPC decoder
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/comm/ldpc_min_sum.h>
+#include <itpp/base/math/vmath.h>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+// The kernels of ldpc_min_sum_kernels.h are compiled for each instruction
+// set as those of vmath.cpp, and chosen with vmath_isa()
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define MS_X86
+// The lanes are inlined, never passed between functions
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__GNUC__)
+#  define MS_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#  define MS_INLINE __forceinline
+#else
+#  define MS_INLINE inline
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+#if defined(__GNUC__)
+// A vector holding all the lanes of a group. Without a wider instruction
+// set, the compiler splits it into the vectors of the target.
+typedef short ms_v16 __attribute__((vector_size(32)));
+
+namespace ms_generic
+{
+typedef ms_v16 Lanes;
+#include <itpp/comm/ldpc_min_sum_kernels.h>
+}
+#else
+namespace ms_generic
+{
+typedef short Lanes;
+#include <itpp/comm/ldpc_min_sum_kernels.h>
+}
+#endif
+
+#if defined(MS_X86)
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx2")
+#endif
+namespace ms_avx2
+{
+typedef ms_v16 Lanes;
+#include <itpp/comm/ldpc_min_sum_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+#endif // MS_X86
+
+// ----------------------------------------------------------------------
+// Schedule
+// ----------------------------------------------------------------------
+
+// Number of groups being filled at a time. A check goes to the first of
+// them with which it has no variable in common.
+static const int ms_open_groups = 32;
+
+void ldpc_ms_schedule(int nvar, int ncheck, const ivec &V, const ivec &sumX2,
+                      ivec &deg, ivec &vars)
+{
+  // checks by increasing degree, in their order within a degree
+  std::vector<std::pair<int, int> > order(ncheck);
+  for (int j = 0; j < ncheck; j++) {
+    it_assert(sumX2(j) <= ldpc_ms_max_degree, "ldpc_ms_schedule(): Check "
+              "degree too large for the layered decoder");
+    order[j] = std::make_pair(sumX2(j), j);
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<std::vector<int> > groups;
+  // slot s of open holds the index of an open group, or -1, and bit s of
+  // used[i] tells that this group contains the variable i
+  std::vector<int> open(ms_open_groups, -1);
+  std::vector<unsigned int> used(nvar, 0);
+  int next_slot = 0;
+  int degree = -1;
+
+  for (int c = 0; c < ncheck; c++) {
+    const int j = order[c].second;
+    const int d = order[c].first;
+    if (d != degree) {
+      open.assign(ms_open_groups, -1);
+      used.assign(nvar, 0);
+      degree = d;
+    }
+
+    unsigned int mask = 0;
+    for (int e = 0; e < d; e++)
+      mask |= used[V(j + e * ncheck)];
+    int slot = -1;
+    for (int s = 0; s < ms_open_groups && slot < 0; s++) {
+      if (open[s] >= 0 && !(mask & (1u << s)))
+        slot = s;
+    }
+    if (slot < 0) {
+      // a new group, closing the oldest one if all slots are taken
+      slot = next_slot;
+      next_slot = (next_slot + 1) % ms_open_groups;
+      if (open[slot] >= 0) {
+        const std::vector<int> &g = groups[open[slot]];
+        for (std::size_t k = 0; k < g.size(); k++)
+          for (int e = 0; e < d; e++)
+            used[V(g[k] + e * ncheck)] &= ~(1u << slot);
+      }
+      open[slot] = static_cast<int>(groups.size());
+      groups.push_back(std::vector<int>());
+    }
+
+    std::vector<int> &g = groups[open[slot]];
+    g.push_back(j);
+    for (int e = 0; e < d; e++)
+      used[V(j + e * ncheck)] |= 1u << slot;
+    if (static_cast<int>(g.size()) == ldpc_ms_lanes) {
+      for (std::size_t k = 0; k < g.size(); k++)
+        for (int e = 0; e < d; e++)
+          used[V(g[k] + e * ncheck)] &= ~(1u << slot);
+      open[slot] = -1;
+    }
+  }
+
+  const int ngroups = static_cast<int>(groups.size());
+  int nedges = 0;
+  deg.set_size(ngroups);
+  for (int g = 0; g < ngroups; g++) {
+    deg(g) = sumX2(groups[g][0]);
+    nedges += deg(g) * ldpc_ms_lanes;
+  }
+  vars.set_size(nedges);
+  int k = 0;
+  for (int g = 0; g < ngroups; g++) {
+    for (int e = 0; e < deg(g); e++) {
+      for (int l = 0; l < ldpc_ms_lanes; l++) {
+        const int size = static_cast<int>(groups[g].size());
+        vars(k++) = (l < size) ? V(groups[g][l] + e * ncheck) : nvar;
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// Iteration
+// ----------------------------------------------------------------------
+
+void ldpc_ms_iteration(int ngroups, const int *deg, const int *vars,
+                       short *post, short *R, const LDPC_MS_Update &u)
+{
+#if defined(MS_X86)
+  if (vmath_isa() >= VMATH_AVX2) {
+    ms_avx2::ms_iteration<ms_avx2::Lanes>(ngroups, deg, vars, post, R, u);
+    return;
+  }
+#endif
+  ms_generic::ms_iteration<ms_generic::Lanes>(ngroups, deg, vars, post, R, u);
+}
+
+void ldpc_ms_iteration(int ngroups, const int *deg, const int *vars,
+                       short *post, signed char *R, const LDPC_MS_Update &u)
+{
+#if defined(MS_X86)
+  if (vmath_isa() >= VMATH_AVX2) {
+    ms_avx2::ms_iteration<ms_avx2::Lanes>(ngroups, deg, vars, post, R, u);
+    return;
+  }
+#endif
+  ms_generic::ms_iteration<ms_generic::Lanes>(ngroups, deg, vars, post, R, u);
+}
+
+void ldpc_ms_iteration_frames(int ngroups, const int *deg, const int *vars,
+                              int nvar, short *post, short *R,
+                              const LDPC_MS_Update &u)
+{
+#if defined(MS_X86)
+  if (vmath_isa() >= VMATH_AVX2) {
+    ms_avx2::ms_iteration_frames<ms_avx2::Lanes>(ngroups, deg, vars, nvar,
+                                                 post, R, u);
+    return;
+  }
+#endif
+  ms_generic::ms_iteration_frames<ms_generic::Lanes>(ngroups, deg, vars, nvar,
+                                                     post, R, u);
+}
+
+void ldpc_ms_iteration_frames(int ngroups, const int *deg, const int *vars,
+                              int nvar, short *post, signed char *R,
+                              const LDPC_MS_Update &u)
+{
+#if defined(MS_X86)
+  if (vmath_isa() >= VMATH_AVX2) {
+    ms_avx2::ms_iteration_frames<ms_avx2::Lanes>(ngroups, deg, vars, nvar,
+                                                 post, R, u);
+    return;
+  }
+#endif
+  ms_generic::ms_iteration_frames<ms_generic::Lanes>(ngroups, deg, vars, nvar,
+                                                     post, R, u);
+}
+
+template<class Msg>
+static void ms_iteration_qc(int nlayers, const int *deg, const int *cols,
+                            const int *shifts, int Z, short *post, Msg *R,
+                            short *work, const LDPC_MS_Update &u)
+{
+  void (*layer)(int, int, short *, Msg *, const LDPC_MS_Update &)
+    = ms_generic::ms_layer<ms_generic::Lanes, Msg>;
+#if defined(MS_X86)
+  if (vmath_isa() >= VMATH_AVX2)
+    layer = ms_avx2::ms_layer<ms_avx2::Lanes, Msg>;
+#endif
+
+  const int zp = ldpc_ms_qc_padding(Z);
+  for (int r = 0; r < nlayers; r++) {
+    const int d = deg[r];
+    // the check i of the layer meets the variable (i + shift) % Z of a block
+    for (int e = 0; e < d; e++) {
+      const short *p = post + cols[e] * Z;
+      short *x = work + e * zp;
+      const int h = shifts[e];
+      std::memcpy(x, p + h, (Z - h) * sizeof(short));
+      std::memcpy(x + Z - h, p, h * sizeof(short));
+      std::memset(x + Z, 0, (zp - Z) * sizeof(short));
+    }
+    layer(d, zp, work, R, u);
+    for (int e = 0; e < d; e++) {
+      short *p = post + cols[e] * Z;
+      const short *x = work + e * zp;
+      const int h = shifts[e];
+      std::memcpy(p + h, x, (Z - h) * sizeof(short));
+      std::memcpy(p, x + Z - h, h * sizeof(short));
+    }
+    cols += d;
+    shifts += d;
+    R += d * zp;
+  }
+}
+
+void ldpc_ms_iteration_qc(int nlayers, const int *deg, const int *cols,
+                          const int *shifts, int Z, short *post, short *R,
+                          short *work, const LDPC_MS_Update &u)
+{
+  ms_iteration_qc(nlayers, deg, cols, shifts, Z, post, R, work, u);
+}
+
+void ldpc_ms_iteration_qc(int nlayers, const int *deg, const int *cols,
+                          const int *shifts, int Z, short *post,
+                          signed char *R, short *work,
+                          const LDPC_MS_Update &u)
+{
+  ms_iteration_qc(nlayers, deg, cols, shifts, Z, post, R, work, u);
+}
+
+unsigned int ldpc_ms_syndrome_frames(int ngroups, const int *deg,
+                                     const int *vars, int nvar,
+                                     const short *post)
+{
+#if defined(MS_X86)
+  if (vmath_isa() >= VMATH_AVX2)
+    return ms_avx2::ms_syndrome_frames<ms_avx2::Lanes>(ngroups, deg, vars,
+                                                       nvar, post);
+#endif
+  return ms_generic::ms_syndrome_frames<ms_generic::Lanes>(ngroups, deg, vars,
+                                                           nvar, post);
+}
+
+} // namespace itpp
+
+//! \endcond
@@ -0,0 +1,127 @@
+/*!
+ * \file
+ * \brief Layered min-sum kernels of the LDPC decoder
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef LDPC_MIN_SUM_H
+#define LDPC_MIN_SUM_H
+
+#include <itpp/base/vec.h>
+
+//! \cond
+
+// The layered decoder of LDPC_Code updates the checks in groups of
+// ldpc_ms_lanes checks of equal degree which have no variable in common,
+// so that the checks of a group are processed side by side in the lanes of
+// a vector. The posterior LLRs and the check to variable messages are
+// fixed-point numbers, saturated to 16 bits and to 8 or 16 bits.
+
+namespace itpp
+{
+
+//! Number of checks processed together by the layered decoder
+const int ldpc_ms_lanes = 16;
+
+//! Largest check degree accepted by the layered decoder
+const int ldpc_ms_max_degree = 200;
+
+//! Check node update, in the fixed-point unit of the messages
+struct LDPC_MS_Update {
+  int factor;   //!< Normalization factor in sixteenths, 16 for none
+  int offset;   //!< Offset subtracted from the magnitudes
+  int msg_max;  //!< Saturation of the check to variable messages
+  int post_max; //!< Saturation of the posterior LLRs
+};
+
+/*!
+  Groups the checks for ldpc_ms_iteration(). V and sumX2 describe the
+  checks as in LDPC_Code. Group g gets deg(g) edges per check, and vars
+  receives for each group, each edge and each lane the variable of the
+  edge. The lanes left empty in a group point at the variable nvar, an
+  extra entry of the posterior LLRs which is never read back.
+*/
+void ldpc_ms_schedule(int nvar, int ncheck, const ivec &V, const ivec &sumX2,
+                      ivec &deg, ivec &vars);
+
+/*!
+  One layered min-sum iteration over the ngroups groups of checks built
+  by ldpc_ms_schedule(). post holds the posterior LLRs and R the messages
+  of the edges, in the order of vars.
+*/
+void ldpc_ms_iteration(int ngroups, const int *deg, const int *vars,
+                       short *post, short *R, const LDPC_MS_Update &u);
+void ldpc_ms_iteration(int ngroups, const int *deg, const int *vars,
+                       short *post, signed char *R, const LDPC_MS_Update &u);
+
+/*!
+  The same iteration for ldpc_ms_lanes codewords at a time, the codewords
+  being in the lanes: the posterior LLR of the variable i in the codeword
+  f is post[i * ldpc_ms_lanes + f], and the message of the edge k (in the
+  order of vars) is R[k * ldpc_ms_lanes + f].
+*/
+void ldpc_ms_iteration_frames(int ngroups, const int *deg, const int *vars,
+                              int nvar, short *post, short *R,
+                              const LDPC_MS_Update &u);
+void ldpc_ms_iteration_frames(int ngroups, const int *deg, const int *vars,
+                              int nvar, short *post, signed char *R,
+                              const LDPC_MS_Update &u);
+
+//! Number of checks of a layer of ldpc_ms_iteration_qc(), Z rounded up
+inline int ldpc_ms_qc_padding(int Z)
+{
+  return (Z + ldpc_ms_lanes - 1) / ldpc_ms_lanes * ldpc_ms_lanes;
+}
+
+/*!
+  One layered min-sum iteration over a quasi-cyclic code of expansion
+  factor Z, with the layers given by the rows of the base matrix. Layer r
+  has deg[r] circulants, whose block columns and shifts (in [0, Z)) are
+  read from cols and shifts, concatenated over the layers. The posteriors
+  of a block are rotated into work, updated in place by the Z checks of
+  the layer side by side, and rotated back. R holds
+  ldpc_ms_qc_padding(Z) messages per circulant, work as many LLRs per
+  circulant of the largest layer.
+*/
+void ldpc_ms_iteration_qc(int nlayers, const int *deg, const int *cols,
+                          const int *shifts, int Z, short *post, short *R,
+                          short *work, const LDPC_MS_Update &u);
+void ldpc_ms_iteration_qc(int nlayers, const int *deg, const int *cols,
+                          const int *shifts, int Z, short *post,
+                          signed char *R, short *work,
+                          const LDPC_MS_Update &u);
+
+/*!
+  Syndrome check of the codewords of ldpc_ms_iteration_frames(). Bit f of
+  the result is set if the codeword f fails a parity check.
+*/
+unsigned int ldpc_ms_syndrome_frames(int ngroups, const int *deg,
+                                     const int *vars, int nvar,
+                                     const short *post);
+
+} // namespace itpp
+
+//! \endcond
+
+#endif // #ifndef LDPC_MIN_SUM_H
@@ -0,0 +1,279 @@
+/*!
+ * \file
+ * \brief Layered min-sum kernels of the LDPC decoder, for one instruction set
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+// No include guard: this file is included by ldpc_min_sum.cpp once for each
+// instruction set, in a namespace defining the type Lanes, which is either
+// short or a vector of shorts holding a whole number of lanes.
+//
+// For each check of a group, with the posterior LLRs L and the messages R:
+//   t_e = L_e - R_e,   R_e = sign(prod t_f) * g(min |t_f|),   L_e = t_e + R_e
+// where f runs over the edges other than e, and g applies the
+// normalization factor and the offset. Only the two smallest magnitudes
+// and the position of the smallest are needed for the minimum.
+
+// ----------------------------------------------------------------------
+// Lane operations
+// ----------------------------------------------------------------------
+
+template<class V>
+MS_INLINE V ms_set(int c)
+{
+  return V() + static_cast<short>(c);
+}
+
+template<class V>
+MS_INLINE V ms_clamp(V x, V lo, V hi)
+{
+  x = (x < lo) ? lo : x;
+  return (x > hi) ? hi : x;
+}
+
+template<class V>
+MS_INLINE V ms_gather(const short *post, const int *vars)
+{
+  const int n = sizeof(V) / sizeof(short);
+  short a[n];
+  for (int k = 0; k < n; k++)
+    a[k] = post[vars[k]];
+  V x;
+  std::memcpy(&x, a, sizeof(V));
+  return x;
+}
+
+template<class V>
+MS_INLINE void ms_scatter(short *post, const int *vars, V x)
+{
+  const int n = sizeof(V) / sizeof(short);
+  short a[n];
+  std::memcpy(a, &x, sizeof(V));
+  for (int k = 0; k < n; k++)
+    post[vars[k]] = a[k];
+}
+
+template<class V>
+MS_INLINE V ms_load(const short *R)
+{
+  V x;
+  std::memcpy(&x, R, sizeof(V));
+  return x;
+}
+
+template<class V>
+MS_INLINE V ms_load(const signed char *R)
+{
+  const int n = sizeof(V) / sizeof(short);
+  short a[n];
+  for (int k = 0; k < n; k++)
+    a[k] = R[k];
+  V x;
+  std::memcpy(&x, a, sizeof(V));
+  return x;
+}
+
+template<class V>
+MS_INLINE void ms_store(short *R, V x)
+{
+  std::memcpy(R, &x, sizeof(V));
+}
+
+template<class V>
+MS_INLINE void ms_store(signed char *R, V x)
+{
+  const int n = sizeof(V) / sizeof(short);
+  short a[n];
+  std::memcpy(a, &x, sizeof(V));
+  for (int k = 0; k < n; k++)
+    R[k] = static_cast<signed char>(a[k]);
+}
+
+// g(m) = max(factor * m / 16 - offset, 0), saturated to msg_max. The
+// product is split so as not to overflow 16 bits.
+template<class V>
+MS_INLINE V ms_correct(V m, V factor, V offset, V msg_max, V zero)
+{
+  m = (m >> 4) * factor + (((m & ms_set<V>(15)) * factor) >> 4) - offset;
+  m = (m < zero) ? zero : m;
+  return (m > msg_max) ? msg_max : m;
+}
+
+// ----------------------------------------------------------------------
+// Check node update
+// ----------------------------------------------------------------------
+
+template<class V>
+struct Ms_Consts {
+  explicit Ms_Consts(const LDPC_MS_Update &u):
+    zero(ms_set<V>(0)), pmax(ms_set<V>(u.post_max)), pmin(-pmax),
+    rmax(ms_set<V>(u.msg_max)), factor(ms_set<V>(u.factor)),
+    offset(ms_set<V>(u.offset)), inf(ms_set<V>(0x7fff)) {}
+  V zero, pmax, pmin, rmax, factor, offset, inf;
+};
+
+// Replaces the inputs t[0], ..., t[d - 1] of a check by the messages r
+template<class V>
+MS_INLINE void ms_check(int d, const V *t, V *r, const Ms_Consts<V> &c)
+{
+  V min1 = c.inf, min2 = c.inf, pos = c.zero, sgn = c.zero;
+  for (int e = 0; e < d; e++) {
+    const V x = t[e];
+    // the sign bit of the xor is the parity of the negative inputs
+    sgn = sgn ^ x;
+    V a = (x < c.zero) ? -x : x;
+    V less = a < min1;
+    min2 = less ? min1 : ((a < min2) ? a : min2);
+    min1 = less ? a : min1;
+    pos = less ? ms_set<V>(e) : pos;
+  }
+  const V c1 = ms_correct(min1, c.factor, c.offset, c.rmax, c.zero);
+  const V c2 = ms_correct(min2, c.factor, c.offset, c.rmax, c.zero);
+  for (int e = 0; e < d; e++) {
+    V m = (pos == ms_set<V>(e)) ? c2 : c1;
+    r[e] = ((sgn ^ t[e]) < c.zero) ? -m : m;
+  }
+}
+
+// ----------------------------------------------------------------------
+// Iteration
+// ----------------------------------------------------------------------
+
+// One codeword, the lanes holding the checks of a group
+template<class V, class Msg>
+static void ms_iteration(int ngroups, const int *deg, const int *vars,
+                         short *post, Msg *R, const LDPC_MS_Update &u)
+{
+  const int n = sizeof(V) / sizeof(short);
+  const Ms_Consts<V> c(u);
+  V t[ldpc_ms_max_degree], r[ldpc_ms_max_degree];
+
+  for (int g = 0; g < ngroups; g++) {
+    const int d = deg[g];
+    for (int l = 0; l < ldpc_ms_lanes; l += n) {
+      for (int e = 0; e < d; e++) {
+        const int k = e * ldpc_ms_lanes + l;
+        t[e] = ms_clamp<V>(ms_gather<V>(post, vars + k) - ms_load<V>(R + k),
+                           c.pmin, c.pmax);
+      }
+      ms_check(d, t, r, c);
+      for (int e = 0; e < d; e++) {
+        const int k = e * ldpc_ms_lanes + l;
+        ms_store(R + k, r[e]);
+        ms_scatter(post, vars + k, ms_clamp<V>(t[e] + r[e], c.pmin, c.pmax));
+      }
+    }
+    vars += d * ldpc_ms_lanes;
+    R += d * ldpc_ms_lanes;
+  }
+}
+
+// ldpc_ms_lanes codewords, the lanes holding the codewords. The checks are
+// updated one at a time, in the order of the groups.
+template<class V, class Msg>
+static void ms_iteration_frames(int ngroups, const int *deg, const int *vars,
+                                int nvar, short *post, Msg *R,
+                                const LDPC_MS_Update &u)
+{
+  const int n = sizeof(V) / sizeof(short);
+  const Ms_Consts<V> c(u);
+  V t[ldpc_ms_max_degree], r[ldpc_ms_max_degree];
+
+  for (int g = 0; g < ngroups; g++) {
+    const int d = deg[g];
+    for (int l = 0; (l < ldpc_ms_lanes) && (vars[l] != nvar); l++) {
+      for (int f = 0; f < ldpc_ms_lanes; f += n) {
+        for (int e = 0; e < d; e++) {
+          const int k = e * ldpc_ms_lanes + l;
+          t[e] = ms_clamp<V>(ms_load<V>(post + vars[k] * ldpc_ms_lanes + f)
+                             - ms_load<V>(R + k * ldpc_ms_lanes + f),
+                             c.pmin, c.pmax);
+        }
+        ms_check(d, t, r, c);
+        for (int e = 0; e < d; e++) {
+          const int k = e * ldpc_ms_lanes + l;
+          ms_store(R + k * ldpc_ms_lanes + f, r[e]);
+          ms_store(post + vars[k] * ldpc_ms_lanes + f,
+                   ms_clamp<V>(t[e] + r[e], c.pmin, c.pmax));
+        }
+      }
+    }
+    vars += d * ldpc_ms_lanes;
+    R += d * ldpc_ms_lanes * ldpc_ms_lanes;
+  }
+}
+
+// The zp checks of a layer of a quasi-cyclic code, the input of the edge e
+// of the check i being x[e * zp + i]. x receives the posterior LLRs.
+template<class V, class Msg>
+static void ms_layer(int d, int zp, short *x, Msg *R, const LDPC_MS_Update &u)
+{
+  const int n = sizeof(V) / sizeof(short);
+  const Ms_Consts<V> c(u);
+  V t[ldpc_ms_max_degree], r[ldpc_ms_max_degree];
+
+  for (int i = 0; i < zp; i += n) {
+    for (int e = 0; e < d; e++) {
+      const int k = e * zp + i;
+      t[e] = ms_clamp<V>(ms_load<V>(x + k) - ms_load<V>(R + k), c.pmin, c.pmax);
+    }
+    ms_check(d, t, r, c);
+    for (int e = 0; e < d; e++) {
+      const int k = e * zp + i;
+      ms_store(R + k, r[e]);
+      ms_store(x + k, ms_clamp<V>(t[e] + r[e], c.pmin, c.pmax));
+    }
+  }
+}
+
+// Bit f of the result is set if the codeword f fails a parity check
+template<class V>
+static unsigned int ms_syndrome_frames(int ngroups, const int *deg,
+                                       const int *vars, int nvar,
+                                       const short *post)
+{
+  const int n = sizeof(V) / sizeof(short);
+  const V zero = ms_set<V>(0);
+  unsigned int failed = 0;
+  for (int f = 0; f < ldpc_ms_lanes; f += n) {
+    V bad = zero;
+    const int *v = vars;
+    for (int g = 0; g < ngroups; g++) {
+      const int d = deg[g];
+      for (int l = 0; (l < ldpc_ms_lanes) && (v[l] != nvar); l++) {
+        V sgn = zero;
+        for (int e = 0; e < d; e++)
+          sgn = sgn ^ ms_load<V>(post + v[e * ldpc_ms_lanes + l]
+                                 * ldpc_ms_lanes + f);
+        bad = bad | (sgn < zero);
+      }
+      v += d * ldpc_ms_lanes;
+    }
+    short b[n];
+    std::memcpy(b, &bad, sizeof(V));
+    for (int k = 0; k < n; k++)
+      failed |= (b[k] != 0) << (f + k);
+  }
+  return failed;
+}
@@ -61,12 +61,27 @@ void OFDM::modulate(const cvec &input, cvec &output)
   it_assert(N*Nfft == input.length(), "OFDM::modulate: Length of input vector is not a multiple of Nfft.");
 
   output.set_length(Nupsample*N*(Nfft + Ncp));
-  cvec outtemp(Nfft);
+  if (N == 0)
+    return;
 
+  // the upsampled symbols are the columns of X, transformed in one batch
+  const int h = Nfft / 2, L = 2 * h + Nfft * (Nupsample - 1), cp = Nupsample * Ncp;
+  cmat X(L, N);
+  X.zeros();
   for (int i = 0; i < N; i++) {
-    outtemp = ifft(concat(input.mid(i * Nfft, Nfft / 2), zeros_c(Nfft * (Nupsample - 1)),
-                          input.mid(i * Nfft + Nfft / 2, Nfft / 2))) * norm_factor;
-    output.replace_mid(Nupsample*(Nfft + Ncp)*i, concat(outtemp.right(Nupsample*Ncp), outtemp));
+    for (int k = 0; k < h; k++) {
+      X(k, i) = input(i * Nfft + k);
+      X(L - h + k, i) = input(i * Nfft + h + k);
+    }
+  }
+  ifft_batch(X, X);
+
+  for (int i = 0; i < N; i++) {
+    const int offset = Nupsample * (Nfft + Ncp) * i;
+    for (int k = 0; k < cp; k++)
+      output(offset + k) = X(L - cp + k, i) * norm_factor;
+    for (int k = 0; k < L; k++)
+      output(offset + cp + k) = X(k, i) * norm_factor;
   }
 }
 
@@ -84,10 +99,26 @@ void OFDM::demodulate(const cvec& input, cvec &output)
   it_assert(Nupsample*N*(Nfft + Ncp) == input.length(), "OFDM: Length of input vector is not a multiple of Nfft+Ncp.");
 
   output.set_length(N*Nfft);
+  if (N == 0)
+    return;
+
+  // the symbols without their cyclic prefix are the columns of X,
+  // transformed in one batch
+  const int h = Nfft / 2, L = Nupsample * Nfft;
+  cmat X(L, N);
+  for (int i = 0; i < N; i++) {
+    const int offset = Nupsample * (i * (Nfft + Ncp) + Ncp);
+    for (int k = 0; k < L; k++)
+      X(k, i) = input(offset + k);
+  }
+  fft_batch(X, X);
+
   // normalize also taking the energy loss into the cyclic prefix into account
   for (int i = 0; i < N; i++) {
-    cvec x = fft(input.mid(Nupsample * (i * (Nfft + Ncp) + Ncp), Nupsample * Nfft));
-    output.replace_mid(Nfft*i, concat(x.left(Nfft / 2), x.right(Nfft / 2)) / norm_factor);
+    for (int k = 0; k < h; k++) {
+      output(Nfft * i + k) = X(k, i) / norm_factor;
+      output(Nfft * i + h + k) = X(L - h + k, i) / norm_factor;
+    }
   }
 }
 
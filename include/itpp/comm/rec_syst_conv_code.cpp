@@ -27,6 +27,7 @@
  */
 
 #include <itpp/comm/rec_syst_conv_code.h>
+#include <itpp/comm/rsc_trellis.h>
 
 
 namespace itpp
@@ -65,7 +66,44 @@ int Rec_Syst_Conv_Code::calc_state_transition(const int instate, const int input
   return in + ((instate << 1) & ((1 << m) - 1));
 }
 
+void Rec_Syst_Conv_Code::trellis_decode(const vec &rec_systematic, const double *rec_parity,
+                                        const vec &extrinsic_input, vec &extrinsic_output,
+                                        double scale, bool log_map)
+{
+  RSC_Decode_Args a;
+  a.nstates = Nstates;
+  a.nparity = n - 1;
+  a.signs = trellis_signs._data();
+  a.length = rec_systematic.length();
+  a.sys = rec_systematic._data();
+  a.ext = extrinsic_input._data();
+  a.ext_length = extrinsic_input.length();
+  a.parity = rec_parity;
+  a.scale = scale;
+  a.terminated = terminated;
+  a.log_map = log_map;
+  a.window = decoder_window;
+  a.training = decoder_training;
+  a.radix = decoder_radix;
+  a.sub_blocks = decoder_sub_blocks;
+  extrinsic_output.set_size(a.ext_length, false);
+  a.out = extrinsic_output._data();
+  rsc_log_decode(a);
+}
+
 // --------------- Public functions -------------------------
+Rec_Syst_Conv_Code::Rec_Syst_Conv_Code(const Rec_Syst_Conv_Code &c):
+    n(c.n), K(c.K), m(c.m), gen_pol(c.gen_pol), gen_pol_rev(c.gen_pol_rev),
+    encoder_state(c.encoder_state), Nstates(c.Nstates), rate(c.rate), Lc(c.Lc),
+    state_trans(c.state_trans), output_parity(c.output_parity),
+    rev_state_trans(c.rev_state_trans), rev_output_parity(c.rev_output_parity),
+    terminated(c.terminated), ln2(c.ln2), llrcalc(c.llrcalc),
+    trellis_signs(c.trellis_signs), decoder_window(c.decoder_window),
+    decoder_training(c.decoder_training), decoder_radix(c.decoder_radix),
+    decoder_sub_blocks(c.decoder_sub_blocks), infinity(c.infinity)
+{
+}
+
 void Rec_Syst_Conv_Code::set_generator_polynomials(const ivec &gen, int constraint_length)
 {
   int j;
@@ -105,6 +143,8 @@ void Rec_Syst_Conv_Code::set_generator_polynomials(const ivec &gen, int constrai
     }
   }
 
+  rsc_trellis_signs(state_trans, output_parity, trellis_signs);
+
   ln2 = std::log(2.0);
 
   //The default value of Lc is 1:
@@ -121,6 +161,28 @@ void Rec_Syst_Conv_Code::set_scaling_factor(double in_Lc)
   Lc = in_Lc;
 }
 
+void Rec_Syst_Conv_Code::set_decoder_window(int window_length, int training_length)
+{
+  it_assert((window_length >= 0) && (training_length >= 0),
+            "Rec_Syst_Conv_Code::set_decoder_window: Negative length");
+  decoder_window = window_length;
+  decoder_training = training_length;
+}
+
+void Rec_Syst_Conv_Code::set_decoder_radix(int radix)
+{
+  it_assert((radix == 2) || (radix == 4),
+            "Rec_Syst_Conv_Code::set_decoder_radix: The radix is either 2 or 4");
+  decoder_radix = radix;
+}
+
+void Rec_Syst_Conv_Code::set_decoder_sub_blocks(int nrof_sub_blocks)
+{
+  it_assert(nrof_sub_blocks > 0,
+            "Rec_Syst_Conv_Code::set_decoder_sub_blocks: At least one sub-block is needed");
+  decoder_sub_blocks = nrof_sub_blocks;
+}
+
 void Rec_Syst_Conv_Code::encode_tail(const bvec &input, bvec &tail, bmat &parity_bits)
 {
   int i, j, length = input.size(), target_state;
@@ -170,6 +232,16 @@ void Rec_Syst_Conv_Code::map_decode(const vec &rec_systematic, const mat &rec_pa
   int j, s0, s1, k, kk, s, s_prim, s_prim0, s_prim1, block_length = rec_systematic.length();
   ivec p0, p1;
 
+  if (in_terminated) { terminated = true; }
+
+  //The vectorized decoder computes the same in the log domain
+  if (trellis_signs.size() > 0) {
+    it_assert((extrinsic_input.length() == block_length) && (rec_parity.rows() == block_length)
+              && (rec_parity.cols() == n - 1), "Rec_Syst_Conv_Code::map_decode: Wrong size of input vectors");
+    trellis_decode(rec_systematic, rec_parity._data(), extrinsic_input, extrinsic_output, Lc, true);
+    return;
+  }
+
   mat alpha(Nstates, block_length + 1);
   mat beta(Nstates, block_length + 1);
   mat gamma(2*Nstates, block_length + 1);
@@ -178,8 +250,6 @@ void Rec_Syst_Conv_Code::map_decode(const vec &rec_systematic, const mat &rec_pa
 
   extrinsic_output.set_size(block_length, false);
 
-  if (in_terminated) { terminated = true; }
-
   //Calculate gamma
   for (k = 1; k <= block_length; k++) {
     kk = k - 1;
@@ -308,6 +378,20 @@ void Rec_Syst_Conv_Code::log_decode(const vec &rec_systematic, const mat &rec_pa
     it_error("Rec_Syst_Conv_Code::log_decode: Illegal metric parameter");
   }
 
+  if (in_terminated) { terminated = true; }
+
+  //Check that Lc = 1.0
+  it_assert(Lc == 1.0,
+            "Rec_Syst_Conv_Code::log_decode: This function assumes that Lc = 1.0. Please use proper scaling of the input data");
+
+  if (trellis_signs.size() > 0) {
+    it_assert((extrinsic_input.length() == block_length) && (rec_parity.rows() == block_length)
+              && (rec_parity.cols() == n - 1), "Rec_Syst_Conv_Code::log_decode: Wrong size of input vectors");
+    trellis_decode(rec_systematic, rec_parity._data(), extrinsic_input, extrinsic_output, 1.0,
+                   metric == "LOGMAP");
+    return;
+  }
+
   mat alpha(Nstates, block_length + 1);
   mat beta(Nstates, block_length + 1);
   mat gamma(2*Nstates, block_length + 1);
@@ -315,12 +399,6 @@ void Rec_Syst_Conv_Code::log_decode(const vec &rec_systematic, const mat &rec_pa
   vec denom(block_length + 1);
   for (k = 0; k <= block_length; k++) { denom(k) = -infinity; }
 
-  if (in_terminated) { terminated = true; }
-
-  //Check that Lc = 1.0
-  it_assert(Lc == 1.0,
-            "Rec_Syst_Conv_Code::log_decode: This function assumes that Lc = 1.0. Please use proper scaling of the input data");
-
   //Calculate gamma
   for (k = 1; k <= block_length; k++) {
     kk = k - 1;
@@ -429,18 +507,26 @@ void Rec_Syst_Conv_Code::log_decode_n2(const vec &rec_systematic, const vec &rec
     it_error("Rec_Syst_Conv_Code::log_decode_n2: Illegal metric parameter");
   }
 
-  mat alpha(Nstates, block_length + 1);
-  mat beta(Nstates, block_length + 1);
-  mat gamma(2*Nstates, block_length + 1);
-  extrinsic_output.set_size(ext_info_length, false);
-  //denom.set_size(block_length+1,false); for (k=0; k<=block_length; k++) { denom(k) = -infinity; }
-
   if (in_terminated) { terminated = true; }
 
   //Check that Lc = 1.0
   it_assert(Lc == 1.0,
             "Rec_Syst_Conv_Code::log_decode_n2: This function assumes that Lc = 1.0. Please use proper scaling of the input data");
 
+  if (trellis_signs.size() > 0) {
+    it_assert((ext_info_length <= block_length) && (rec_parity.length() == block_length) && (n == 2),
+              "Rec_Syst_Conv_Code::log_decode_n2: Wrong size of input vectors");
+    trellis_decode(rec_systematic, rec_parity._data(), extrinsic_input, extrinsic_output, 1.0,
+                   metric == "LOGMAP");
+    return;
+  }
+
+  mat alpha(Nstates, block_length + 1);
+  mat beta(Nstates, block_length + 1);
+  mat gamma(2*Nstates, block_length + 1);
+  extrinsic_output.set_size(ext_info_length, false);
+  //denom.set_size(block_length+1,false); for (k=0; k<=block_length; k++) { denom(k) = -infinity; }
+
   //Initiate alpha
   for (s = 1; s < Nstates; s++) { alpha(s, 0) = -infinity; }
   alpha(0, 0) = 0.0;
@@ -53,7 +53,11 @@ class ITPP_EXPORT Rec_Syst_Conv_Code
 public:
 
   //! Class constructor
-  Rec_Syst_Conv_Code(): infinity(1e30) {}
+  Rec_Syst_Conv_Code(): decoder_window(0), decoder_training(32),
+    decoder_radix(2), decoder_sub_blocks(1), infinity(1e30) {}
+
+  //! Copy constructor, copying the code and the decoder settings
+  Rec_Syst_Conv_Code(const Rec_Syst_Conv_Code &c);
 
   //! Class constructor
   virtual ~Rec_Syst_Conv_Code() {}
@@ -88,6 +92,45 @@ public:
   */
   void set_llrcalc(LLR_calc_unit in_llrcalc);
 
+  /*!
+    \brief Set the window of the backward recursion of the decoders
+
+    For the codes of 4 to 64 states, map_decode() and the "LOGMAP" and
+    "LOGMAX" metrics of log_decode() and log_decode_n2() use a vectorized
+    decoder which keeps the forward state metrics of \a window_length
+    trellis steps at a time. The backward recursion of a window starts
+    \a training_length steps after its end, from equiprobable states,
+    unless it reaches the end of the block. A \a window_length of 0, the
+    default, decodes the whole block at once and gives the exact results of
+    the unwindowed decoders. A window, e.g. of 128 steps with a training
+    length of 32, bounds the memory of long blocks at the cost of slightly
+    different results.
+  */
+  void set_decoder_window(int window_length, int training_length = 32);
+
+  /*!
+    \brief Set the radix of the vectorized decoder
+
+    With a \a radix of 4, the recursions of the vectorized decoder (see
+    set_decoder_window()) advance two trellis steps at a time, which halves
+    their chain of dependent operations at the cost of more operations per
+    step. The default radix 2 is the faster one unless the processor has
+    execution units left idle by the recursions.
+  */
+  void set_decoder_radix(int radix);
+
+  /*!
+    \brief Set the number of sub-blocks decoded in parallel
+
+    The vectorized decoder (see set_decoder_window()) cuts the block into
+    \a nrof_sub_blocks parts of equal length, decoded concurrently by the
+    OpenMP threads. The forward recursion of a part starts from equiprobable
+    states the training length before it, as the backward recursion of a
+    window does after it. The results depend on the number of parts but not
+    on the number of threads. The default is 1, a single part.
+  */
+  void set_decoder_sub_blocks(int nrof_sub_blocks);
+
   /*!
     \brief Encode a binary vector of inputs and also adds a tail of \a K-1 zeros to force the encoder into the zero state.
 
@@ -208,6 +251,10 @@ public:
 private:
   //! Used for precalculations of the trellis state transitions
   int calc_state_transition(const int instate, const int input, ivec &parity);
+  //! Decoding with the vectorized decoder, the parity LLRs being column-major
+  void trellis_decode(const vec &rec_systematic, const double *rec_parity,
+                      const vec &extrinsic_input, vec &extrinsic_output,
+                      double scale, bool log_map);
 
   int n, K, m;
   ivec gen_pol, gen_pol_rev;
@@ -223,6 +270,11 @@ private:
   */
   LLR_calc_unit llrcalc;
 
+  //! Sign tables of the vectorized decoder, empty if it does not apply
+  vec trellis_signs;
+  //! Window, training length, radix and sub-blocks of the vectorized decoder
+  int decoder_window, decoder_training, decoder_radix, decoder_sub_blocks;
+
   // This const value replaces INT definition used previously
   const double infinity;
 };
@@ -0,0 +1,243 @@
+/*!
+ * \file
+ * \brief Vectorized log-domain decoder of Rec_Syst_Conv_Code
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/comm/rsc_trellis.h>
+#include <itpp/base/math/vmath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// The kernels of rsc_trellis_kernels.h are compiled for each instruction
+// set as those of vmath.cpp, and chosen with vmath_isa()
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define RSC_X86
+// The lanes are inlined, never passed between functions
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__GNUC__)
+#  define RSC_INLINE inline __attribute__((always_inline))
+#  define RSC_UNROLL _Pragma("GCC unroll 16")
+#elif defined(_MSC_VER)
+#  define RSC_INLINE __forceinline
+#  define RSC_UNROLL
+#else
+#  define RSC_INLINE inline
+#  define RSC_UNROLL
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+// The sign tables hold rows of nstates doubles, one per state, giving the
+// sign (+1 or -1) of an input of the step in a branch metric, the inputs
+// being the systematic one and then the parity ones (S of them). For the
+// kernels, they are grouped as
+//   f2: S rows for each predecessor p of the forward step
+//   b2: S rows for each branch b of the backward step
+//   fb: the feedback bit of the state, 1.0 or 0.0, which is the input of
+//       the branch b = 1
+//   fbm: the feedback bits of the successors 2 (s mod H) + b
+//   f4: 2 S rows, for the two steps, for each predecessor q two steps back
+//   b4: 2 S rows for each successor r two steps further
+struct Rsc_Tables {
+  Rsc_Tables(const double *signs, int nstates, int nparity):
+    S(nparity + 1), f2(signs), b2(f2 + 2 * S * nstates),
+    fb(b2 + 2 * S * nstates), fbm(fb + nstates), f4(fbm + 2 * nstates),
+    b4(f4 + 8 * S * nstates) {}
+  //! Number of rows of the tables
+  static int rows(int nparity) { return 20 * (nparity + 1) + 3; }
+
+  int S;
+  const double *f2, *b2, *fb, *fbm, *f4, *b4;
+};
+
+// Metric of the states which cannot be reached
+static const double rsc_minus_inf = -1e30;
+
+// Inputs of the step k: half the systematic plus a priori LLR, and half
+// the parity LLRs
+static inline void rsc_inputs(const RSC_Decode_Args &d, int k, double *in)
+{
+  const double e = (k < d.ext_length) ? d.ext[k] : 0.0;
+  in[0] = 0.5 * (e + d.scale * d.sys[k]);
+  for (int j = 0; j < d.nparity; j++)
+    in[j + 1] = 0.5 * d.scale * d.parity[k + j * d.length];
+}
+
+#if defined(__GNUC__)
+typedef double rsc_v4 __attribute__((vector_size(32)));
+typedef long long rsc_m4 __attribute__((vector_size(32)));
+
+namespace rsc_generic
+{
+typedef rsc_v4 Lanes;
+typedef rsc_m4 Mask;
+#include <itpp/comm/rsc_trellis_kernels.h>
+}
+#else
+namespace rsc_generic
+{
+typedef double Lanes;
+typedef long long Mask;
+#include <itpp/comm/rsc_trellis_kernels.h>
+}
+#endif
+
+#if defined(RSC_X86)
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx2,fma")
+#endif
+namespace rsc_avx2
+{
+typedef rsc_v4 Lanes;
+typedef rsc_m4 Mask;
+#include <itpp/comm/rsc_trellis_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+#endif // RSC_X86
+
+// ----------------------------------------------------------------------
+// Tables
+// ----------------------------------------------------------------------
+
+// The S signs of the branch leaving s with the input u, N apart
+static void rsc_branch_signs(const imat &output_parity, int s, int u, int N,
+                             double *g)
+{
+  g[0] = 1.0 - 2 * u;
+  for (int j = 0; j < output_parity.cols() / 2; j++)
+    g[(j + 1) * N] = 1.0 - 2 * output_parity(s, 2 * j + u);
+}
+
+void rsc_trellis_signs(const imat &state_trans, const imat &output_parity,
+                       vec &signs)
+{
+  const int N = state_trans.rows();
+  const int P = output_parity.cols() / 2;
+  const int S = P + 1;
+  signs.set_size(0);
+  if (N < rsc_min_states || N > rsc_max_states || (N & (N - 1))
+      || P > rsc_max_parity)
+    return;
+
+  // the kernels rely on the branches of s going to 2 (s mod H) + b
+  ivec fb(N);
+  for (int s = 0; s < N; s++) {
+    fb(s) = state_trans(s, 0) & 1;
+    for (int u = 0; u < 2; u++) {
+      if (state_trans(s, u) != (((s << 1) & (N - 1)) | (fb(s) ^ u)))
+        return;
+    }
+  }
+
+  // in the order of Rsc_Tables
+  signs.set_size(Rsc_Tables::rows(P) * N);
+  double *f2 = signs._data();
+  double *b2 = f2 + 2 * S * N;
+  double *fbr = b2 + 2 * S * N;
+  double *fbm = fbr + N;
+  double *f4 = fbm + 2 * N;
+  double *b4 = f4 + 8 * S * N;
+
+  const int H = N / 2, Q = N / 4;
+  for (int s = 0; s < N; s++) {
+    fbr[s] = fb(s);
+    fbm[s] = fb(2 * (s % (N / 2)));
+    fbm[N + s] = fb(2 * (s % (N / 2)) + 1);
+    for (int p = 0; p < 2; p++) {
+      const int prev = (s >> 1) + p * H;
+      rsc_branch_signs(output_parity, prev, (s & 1) ^ fb(prev), N,
+                       f2 + p * S * N + s);
+    }
+    for (int b = 0; b < 2; b++)
+      rsc_branch_signs(output_parity, s, b ^ fb(s), N, b2 + b * S * N + s);
+    for (int q = 0; q < 4; q++) {
+      const int prev = (s >> 2) + q * Q;
+      const int b1 = (s >> 1) & 1;
+      const int mid = 2 * (prev % H) + b1;
+      double *g = f4 + 2 * q * S * N + s;
+      rsc_branch_signs(output_parity, prev, b1 ^ fb(prev), N, g);
+      rsc_branch_signs(output_parity, mid, (s & 1) ^ fb(mid), N, g + S * N);
+    }
+    for (int r = 0; r < 4; r++) {
+      const int b1 = r >> 1;
+      const int mid = 2 * (s % H) + b1;
+      double *g = b4 + 2 * r * S * N + s;
+      rsc_branch_signs(output_parity, s, b1 ^ fb(s), N, g);
+      rsc_branch_signs(output_parity, mid, (r & 1) ^ fb(mid), N, g + S * N);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------
+// Decoder
+// ----------------------------------------------------------------------
+
+void rsc_log_decode(const RSC_Decode_Args &a)
+{
+  it_assert(a.signs && a.nparity <= rsc_max_parity,
+            "rsc_log_decode(): Trellis not handled by the decoder");
+  it_assert(a.radix == 2 || a.radix == 4,
+            "rsc_log_decode(): The radix is either 2 or 4");
+  const Rsc_Tables t(a.signs, a.nstates, a.nparity);
+  const bool radix4 = (a.radix == 4);
+  const int nsub = std::max(std::min(a.sub_blocks, a.length), 1);
+  const int size = (a.length + nsub - 1) / nsub;
+  const int window = (a.window > 0 && a.window < size) ? a.window : size;
+
+  rsc_generic::Rsc_Decode decode
+    = rsc_generic::rsc_decoder(a.nstates, a.log_map, radix4);
+#if defined(RSC_X86)
+  if (vmath_isa() >= VMATH_AVX2)
+    decode = rsc_avx2::rsc_decoder(a.nstates, a.log_map, radix4);
+#endif
+
+  // The sub-blocks only share the inputs and the tables
+#pragma omp parallel for if (nsub > 1) schedule(static, 1)
+  for (int j = 0; j < nsub; j++) {
+    const int b0 = j * size;
+    if (b0 < a.length) {
+      std::vector<double> alpha((window + 1) * a.nstates);
+      decode(a, t, &alpha[0], b0, std::min(b0 + size, a.length));
+    }
+  }
+}
+
+} // namespace itpp
+
+//! \endcond
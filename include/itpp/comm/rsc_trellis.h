@@ -0,0 +1,104 @@
+/*!
+ * \file
+ * \brief Vectorized log-domain decoder of Rec_Syst_Conv_Code
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef RSC_TRELLIS_H
+#define RSC_TRELLIS_H
+
+#include <itpp/base/mat.h>
+
+//! \cond
+
+// The state metrics of a trellis step are held in vectors covering all the
+// states, and the forward and backward recursions advance one step (radix
+// 2) or two steps at a time (radix 4). The states s of a recursive
+// systematic encoder with m memory cells are left by the branches to
+// 2 (s mod 2^(m-1)) + b, b = 0 or 1, so the predecessors and the successors
+// of a group of states are found by fixed shuffles, and the branch metrics
+// are linear combinations of the inputs of the step with signs tabulated
+// per state by rsc_trellis_signs(). Radix 4 halves the length of the chain
+// of dependent operations of the recursions but combines four branches per
+// state instead of two, so it only pays where the processor has execution
+// units to spare along the chain.
+//
+// The backward recursion runs over windows of the block. The forward state
+// metrics of a window are kept, and the backward one is started at the end
+// of the window from equiprobable states a few steps further (the training
+// length), so that the memory does not depend on the block length. The
+// block may also be cut into sub-blocks decoded in parallel, whose forward
+// recursions start in the same way the training length before them.
+
+namespace itpp
+{
+
+//! Smallest and largest number of states of the vectorized decoder
+const int rsc_min_states = 4;
+const int rsc_max_states = 64;
+
+//! Largest number of parity bits per step of the vectorized decoder
+const int rsc_max_parity = 7;
+
+//! Problem solved by rsc_log_decode()
+struct RSC_Decode_Args {
+  int nstates;             //!< Number of states, a power of two
+  int nparity;             //!< Number of parity bits per step
+  const double *signs;     //!< Tables of rsc_trellis_signs()
+  int length;              //!< Number of trellis steps
+  const double *sys;       //!< Systematic LLRs, length of them
+  const double *ext;       //!< A priori LLRs of the first ext_length steps
+  int ext_length;          //!< Number of extrinsic outputs
+  const double *parity;    //!< Parity LLRs, length x nparity column-major
+  double scale;            //!< Channel reliability applied to sys and parity
+  bool terminated;         //!< Trellis ending in the zero state
+  bool log_map;            //!< Log-MAP, or max-log-MAP if false
+  int window;              //!< Window of the backward recursion, 0 for none
+  int training;            //!< Training length of the backward recursion
+  int radix;               //!< 2 or 4, steps of the recursions by one or two
+  int sub_blocks;          //!< Sub-blocks decoded by the OpenMP threads
+  double *out;             //!< Extrinsic LLRs, ext_length of them
+};
+
+/*!
+  Sign tables of the branch metrics of a trellis given as in
+  Rec_Syst_Conv_Code, or an empty vector if the vectorized decoder does not
+  handle it.
+*/
+void rsc_trellis_signs(const imat &state_trans, const imat &output_parity,
+                       vec &signs);
+
+/*!
+  Log-MAP or max-log-MAP decoding, with the branch metrics and the
+  extrinsic outputs of Rec_Syst_Conv_Code::log_decode(). The state metrics
+  start from the zero state and end as given by terminated, or, if not
+  terminated, from the forward state metrics at the end of the block.
+*/
+void rsc_log_decode(const RSC_Decode_Args &a);
+
+} // namespace itpp
+
+//! \endcond
+
+#endif // #ifndef RSC_TRELLIS_H
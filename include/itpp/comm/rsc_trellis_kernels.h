@@ -0,0 +1,476 @@
+/*!
+ * \file
+ * \brief Kernels of the vectorized log-domain decoder of Rec_Syst_Conv_Code,
+ * for one instruction set
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+// No include guard: this file is included by rsc_trellis.cpp once for each
+// instruction set, in a namespace defining the type Lanes, which is either
+// double or a vector of doubles, and the type Mask of 64-bit integers of
+// the same shape. Rsc_Tables, rsc_inputs() and rsc_minus_inf are defined
+// in rsc_trellis.cpp.
+//
+// The state metrics of a step are arrays of N doubles, processed by groups
+// of lanes s, s + 1, ... With H = N / 2 and Q = N / 4, the predecessors of
+// the state s are (s >> 1) + p H, p = 0 or 1, one step back, and
+// (s >> 2) + q Q, q = 0 to 3, two steps back. Its successors are
+// 2 (s mod H) + b and 4 (s mod Q) + r, b = 0 or 1, r = 0 to 3.
+
+// ----------------------------------------------------------------------
+// Lane operations
+// ----------------------------------------------------------------------
+
+template<class V>
+RSC_INLINE V rsc_set(double c)
+{
+  return V() + c;
+}
+
+template<class V>
+RSC_INLINE V rsc_load(const double *p)
+{
+  V x;
+  std::memcpy(&x, p, sizeof(V));
+  return x;
+}
+
+template<class V>
+RSC_INLINE void rsc_store(double *p, const V &x)
+{
+  std::memcpy(p, &x, sizeof(V));
+}
+
+// The lanes x[((s + l) >> shift) + offset]
+template<class V>
+RSC_INLINE V rsc_pred(const double *x, int s, int shift, int offset)
+{
+  const int w = sizeof(V) / sizeof(double);
+  double a[w];
+  for (int l = 0; l < w; l++)
+    a[l] = x[((s + l) >> shift) + offset];
+  return rsc_load<V>(a);
+}
+
+// The lanes x[(((s + l) & mask) << shift) + offset]
+template<class V>
+RSC_INLINE V rsc_succ(const double *x, int s, int shift, int mask, int offset)
+{
+  const int w = sizeof(V) / sizeof(double);
+  double a[w];
+  for (int l = 0; l < w; l++)
+    a[l] = x[(((s + l) & mask) << shift) + offset];
+  return rsc_load<V>(a);
+}
+
+// log(1 + exp(-d)) for d >= 0
+RSC_INLINE double rsc_log1p_exp(double d)
+{
+  return log1p(std::exp(-d));
+}
+
+template<class V>
+RSC_INLINE V rsc_log1p_exp(const V &d)
+{
+  // e = exp(-d) = 2^k exp(r) with |r| <= ln(2) / 2, d being clamped where
+  // the result vanishes
+  const double round = 6755399441055744.0; // 1.5 * 2^52
+  const V x = -((d < rsc_set<V>(40.0)) ? d : rsc_set<V>(40.0));
+  const V t = x * 1.4426950408889634 + round;
+  const V k = t - round;
+  const V r = (x - k * 6.93147180369123816490e-01)
+              - k * 1.90821492927058770002e-10;
+  V p = r * (1.0 / 39916800.0) + (1.0 / 3628800.0);
+  p = p * r + (1.0 / 362880.0);
+  p = p * r + (1.0 / 40320.0);
+  p = p * r + (1.0 / 5040.0);
+  p = p * r + (1.0 / 720.0);
+  p = p * r + (1.0 / 120.0);
+  p = p * r + (1.0 / 24.0);
+  p = p * r + (1.0 / 6.0);
+  p = p * r + 0.5;
+  p = (p * r) * r + r + 1.0;
+  Mask bits;
+  std::memcpy(&bits, &t, sizeof(V));
+  bits = (bits - 0x4338000000000000LL + 1023) << 52;
+  V scale;
+  std::memcpy(&scale, &bits, sizeof(V));
+  const V e = p * scale;
+
+  // log(1 + e) = 2 atanh(u), from 1 + e or from (1 + e) / 2 whichever is
+  // closer to 1, so that |u| <= 0.172
+  const Mask big = e > rsc_set<V>(0.41421356237309503);
+  const V u = (big ? e - 1.0 : e) / (big ? e + 3.0 : e + 2.0);
+  const V z = u * u;
+  V q = z * (1.0 / 21) + (1.0 / 19);
+  q = q * z + (1.0 / 17);
+  q = q * z + (1.0 / 15);
+  q = q * z + (1.0 / 13);
+  q = q * z + (1.0 / 11);
+  q = q * z + (1.0 / 9);
+  q = q * z + (1.0 / 7);
+  q = q * z + (1.0 / 5);
+  q = q * z + (1.0 / 3);
+  return (2.0 * u) * (q * z + 1.0)
+         + (big ? rsc_set<V>(0.69314718055994531) : rsc_set<V>(0.0));
+}
+
+// max(a, b), or log(exp(a) + exp(b)) for the log-MAP metric
+template<bool LogMap, class V>
+RSC_INLINE V rsc_max(const V &a, const V &b)
+{
+  const V m = (a > b) ? a : b;
+  if (!LogMap)
+    return m;
+  return m + rsc_log1p_exp((a > b) ? a - b : b - a);
+}
+
+// The reduction by rsc_max() of the lanes of nom minus that of den
+template<bool LogMap, class V>
+RSC_INLINE double rsc_llr(const V &nom, const V &den)
+{
+  const int w = sizeof(V) / sizeof(double);
+  double t[2 * w];
+  rsc_store(t, nom);
+  rsc_store(t + w, den);
+  // the two reductions side by side in the lanes
+  for (int n = 2 * w; n > 2; n /= 2) {
+    double a[w], b[w];
+    for (int l = 0; l < w; l++) {
+      const int i = (2 * l < n) ? 2 * l : 0;
+      a[l] = t[i];
+      b[l] = t[i + 1];
+    }
+    rsc_store(t, rsc_max<LogMap>(rsc_load<V>(a), rsc_load<V>(b)));
+  }
+  return t[0] - t[1];
+}
+
+// Branch metrics of the lanes from the rows of signs g (N apart) and the
+// S inputs x of the step
+template<class V, int N>
+RSC_INLINE V rsc_metric(const double *g, const double *x, int S)
+{
+  V m = rsc_load<V>(g) * x[0];
+  for (int t = 1; t < S; t++)
+    m += rsc_load<V>(g + t * N) * x[t];
+  return m;
+}
+
+template<class V, int N>
+RSC_INLINE void rsc_normalize(double *x)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const V c = rsc_set<V>(x[0]);
+  RSC_UNROLL
+  for (int s = 0; s < N; s += w)
+    rsc_store(x + s, rsc_load<V>(x + s) - c);
+}
+
+// ----------------------------------------------------------------------
+// Trellis steps
+// ----------------------------------------------------------------------
+
+// Forward state metrics y one step after x
+template<class V, int N, bool LogMap>
+RSC_INLINE void rsc_forward2(const double *x, double *y, const Rsc_Tables &t,
+                             const double *in)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const int S = t.S;
+  RSC_UNROLL
+  for (int s = 0; s < N; s += w) {
+    const V a0 = rsc_pred<V>(x, s, 1, 0)
+                 + rsc_metric<V, N>(t.f2 + s, in, S);
+    const V a1 = rsc_pred<V>(x, s, 1, N / 2)
+                 + rsc_metric<V, N>(t.f2 + S * N + s, in, S);
+    rsc_store(y + s, rsc_max<LogMap>(a0, a1));
+  }
+}
+
+// Forward state metrics y two steps after x
+template<class V, int N, bool LogMap>
+RSC_INLINE void rsc_forward4(const double *x, double *y, const Rsc_Tables &t,
+                             const double *in1, const double *in2)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const int S = t.S;
+  RSC_UNROLL
+  for (int s = 0; s < N; s += w) {
+    V a[4];
+    for (int q = 0; q < 4; q++) {
+      const double *g = t.f4 + 2 * q * S * N + s;
+      a[q] = rsc_pred<V>(x, s, 2, q * (N / 4))
+             + rsc_metric<V, N>(g, in1, S)
+             + rsc_metric<V, N>(g + S * N, in2, S);
+    }
+    rsc_store(y + s, rsc_max<LogMap>(rsc_max<LogMap>(a[0], a[1]),
+                                     rsc_max<LogMap>(a[2], a[3])));
+  }
+}
+
+// Backward state metrics y (if not NULL) one step before x and, if a holds
+// the forward state metrics of the step, its extrinsic LLR
+template<class V, int N, bool LogMap>
+RSC_INLINE double rsc_backward2(const double *x, double *y, const double *a,
+                                const Rsc_Tables &t, const double *in)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const int S = t.S;
+  const V zero = rsc_set<V>(0.0);
+  V nom = rsc_set<V>(rsc_minus_inf), den = nom;
+  RSC_UNROLL
+  for (int s = 0; s < N; s += w) {
+    const V t0 = rsc_succ<V>(x, s, 1, N / 2 - 1, 0)
+                 + rsc_metric<V, N>(t.b2 + s, in, S);
+    const V t1 = rsc_succ<V>(x, s, 1, N / 2 - 1, 1)
+                 + rsc_metric<V, N>(t.b2 + S * N + s, in, S);
+    if (y)
+      rsc_store(y + s, rsc_max<LogMap>(t0, t1));
+    if (a) {
+      // the branch b = 1 carries the input 0 if the feedback is 1
+      const V as = rsc_load<V>(a + s);
+      const V fb = rsc_load<V>(t.fb + s);
+      nom = rsc_max<LogMap>(nom, as + ((fb > zero) ? t1 : t0));
+      den = rsc_max<LogMap>(den, as + ((fb > zero) ? t0 : t1));
+    }
+  }
+  // the metrics include the systematic and a priori input 2 in[0]
+  return a ? rsc_llr<LogMap>(nom, den) - 2.0 * in[0] : 0.0;
+}
+
+// Backward state metrics y two steps before x and, if a holds the forward
+// state metrics of the earlier step, the extrinsic LLRs of the two steps.
+// The paths through a state and its four successors give both LLRs, so
+// that the state metrics in between are not needed.
+template<class V, int N, bool LogMap>
+RSC_INLINE void rsc_backward4(const double *x, double *y, const double *a,
+                              const Rsc_Tables &t, const double *in1,
+                              const double *in2, double *llr)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const int S = t.S;
+  const V zero = rsc_set<V>(0.0);
+  V nom1 = rsc_set<V>(rsc_minus_inf), den1 = nom1, nom2 = nom1, den2 = nom1;
+  RSC_UNROLL
+  for (int s = 0; s < N; s += w) {
+    V b[4];
+    for (int r = 0; r < 4; r++) {
+      const double *g = t.b4 + 2 * r * S * N + s;
+      b[r] = rsc_succ<V>(x, s, 2, N / 4 - 1, r)
+             + rsc_metric<V, N>(g, in1, S)
+             + rsc_metric<V, N>(g + S * N, in2, S);
+    }
+    const V m0 = rsc_max<LogMap>(b[0], b[1]);
+    const V m1 = rsc_max<LogMap>(b[2], b[3]);
+    rsc_store(y + s, rsc_max<LogMap>(m0, m1));
+    if (a) {
+      // the successor r = 2 b1 + b2 is reached by the inputs b1 ^ fb(s)
+      // and b2 ^ fb(2 (s mod H) + b1)
+      const V as = rsc_load<V>(a + s);
+      const Mask f = rsc_load<V>(t.fb + s) > zero;
+      const Mask f0 = rsc_load<V>(t.fbm + s) > zero;
+      const Mask f1 = rsc_load<V>(t.fbm + N + s) > zero;
+      nom1 = rsc_max<LogMap>(nom1, as + (f ? m1 : m0));
+      den1 = rsc_max<LogMap>(den1, as + (f ? m0 : m1));
+      const V n2 = rsc_max<LogMap>(f0 ? b[1] : b[0], f1 ? b[3] : b[2]);
+      const V d2 = rsc_max<LogMap>(f0 ? b[0] : b[1], f1 ? b[2] : b[3]);
+      nom2 = rsc_max<LogMap>(nom2, as + n2);
+      den2 = rsc_max<LogMap>(den2, as + d2);
+    }
+  }
+  if (a) {
+    llr[0] = rsc_llr<LogMap>(nom1, den1) - 2.0 * in1[0];
+    llr[1] = rsc_llr<LogMap>(nom2, den2) - 2.0 * in2[0];
+  }
+}
+
+// ----------------------------------------------------------------------
+// Decoder
+// ----------------------------------------------------------------------
+
+// The state metrics b one step or, for Radix4, two steps before, with the
+// LLRs of these steps if they are below ext_length
+template<class V, int N, bool LogMap, bool Radix4>
+RSC_INLINE void rsc_backward_llr(const RSC_Decode_Args &d, const Rsc_Tables &t,
+                                 int k, const double *a, double *&b,
+                                 double *&c)
+{
+  double in1[rsc_max_parity + 1], in2[rsc_max_parity + 1];
+  if (Radix4) {
+    double llr[2] = {0.0, 0.0};
+    rsc_inputs(d, k, in1);
+    rsc_inputs(d, k + 1, in2);
+    if (k >= d.ext_length)
+      a = 0;
+    rsc_backward4<V, N, LogMap>(b, c, a, t, in1, in2, llr);
+    for (int j = 0; j < 2 && k + j < d.ext_length; j++)
+      d.out[k + j] = llr[j];
+  }
+  else {
+    rsc_inputs(d, k, in1);
+    if (k >= d.ext_length)
+      a = 0;
+    const double llr = rsc_backward2<V, N, LogMap>(b, c, a, t, in1);
+    if (a)
+      d.out[k] = llr;
+  }
+  rsc_normalize<V, N>(c);
+  std::swap(b, c);
+}
+
+// Decoding of the steps b0 to b1 - 1 of the block. alpha holds the
+// forward state metrics of a window, (window + 1) N doubles. With Radix4,
+// the recursions advance two steps at a time, and only the state metrics
+// of every other step are kept.
+template<class V, int N, bool LogMap, bool Radix4>
+static void rsc_decode(const RSC_Decode_Args &d, const Rsc_Tables &t,
+                       double *alpha, int b0, int b1)
+{
+  const int L = d.length;
+  const int window = (d.window > 0 && d.window < b1 - b0) ? d.window
+                     : b1 - b0;
+  const int step = Radix4 ? 2 : 1;
+  double in1[rsc_max_parity + 1], in2[rsc_max_parity + 1];
+  double buf[2][N];
+
+  // Inside the block, the forward recursion is trained as the backward one
+  const int start = std::max(b0 - d.training, 0);
+  if (start == 0) {
+    alpha[0] = 0.0;
+    for (int s = 1; s < N; s++)
+      alpha[s] = rsc_minus_inf;
+  }
+  else
+    std::memset(alpha, 0, N * sizeof(double));
+  for (int k = start; k < b0; k++) {
+    rsc_inputs(d, k, in1);
+    rsc_forward2<V, N, LogMap>(alpha, alpha + N, t, in1);
+    rsc_normalize<V, N>(alpha + N);
+    std::memcpy(alpha, alpha + N, N * sizeof(double));
+  }
+
+  for (int w0 = b0; w0 < b1; w0 += window) {
+    const int w1 = std::min(w0 + window, b1);
+    // steps of the window done by the recursions by one step
+    const int single = (w1 - w0) % step;
+
+    // Forward recursion over the window, the state metrics of the step
+    // w0 + step i being kept in the slot i
+    double *x = alpha;
+    for (int k = w0; k < w1 - single; k += step, x += N) {
+      rsc_inputs(d, k, in1);
+      if (Radix4) {
+        rsc_inputs(d, k + 1, in2);
+        rsc_forward4<V, N, LogMap>(x, x + N, t, in1, in2);
+      }
+      else
+        rsc_forward2<V, N, LogMap>(x, x + N, t, in1);
+      rsc_normalize<V, N>(x + N);
+    }
+    if (single) {
+      rsc_inputs(d, w1 - 1, in1);
+      rsc_forward2<V, N, LogMap>(x, x + N, t, in1);
+      rsc_normalize<V, N>(x + N);
+    }
+    // slot of the state metrics at the end of the window
+    const double *last = x + single * N;
+
+    // Start of the backward recursion
+    double *b = buf[0], *c = buf[1];
+    int end = w1;
+    if (w1 < L)
+      end = std::min(w1 + d.training, L);
+    if (end == L && d.terminated) {
+      b[0] = 0.0;
+      for (int s = 1; s < N; s++)
+        b[s] = rsc_minus_inf;
+    }
+    else if (w1 == L)
+      std::memcpy(b, last, N * sizeof(double));
+    else
+      std::memset(b, 0, N * sizeof(double));
+
+    // The steps after the window only train the state metrics
+    int k = end;
+    if ((end - w1) % step) {
+      k--;
+      rsc_inputs(d, k, in1);
+      rsc_backward2<V, N, LogMap>(b, c, 0, t, in1);
+      rsc_normalize<V, N>(c);
+      std::swap(b, c);
+    }
+    for (; k > w1; k -= step) {
+      if (Radix4) {
+        rsc_inputs(d, k - 2, in1);
+        rsc_inputs(d, k - 1, in2);
+        rsc_backward4<V, N, LogMap>(b, c, 0, t, in1, in2, 0);
+      }
+      else {
+        rsc_inputs(d, k - 1, in1);
+        rsc_backward2<V, N, LogMap>(b, c, 0, t, in1);
+      }
+      rsc_normalize<V, N>(c);
+      std::swap(b, c);
+    }
+
+    // Backward recursion over the window with the LLRs
+    if (single)
+      rsc_backward_llr<V, N, LogMap, false>(d, t, --k, x, b, c);
+    for (x -= N; k > w0; k -= step, x -= N)
+      rsc_backward_llr<V, N, LogMap, Radix4>(d, t, k - step, x, b, c);
+
+    // the forward recursion of the next window starts where this one ends
+    std::memcpy(alpha, last, N * sizeof(double));
+  }
+}
+
+typedef void (*Rsc_Decode)(const RSC_Decode_Args &, const Rsc_Tables &,
+                           double *, int, int);
+
+template<int N>
+static Rsc_Decode rsc_decoder(bool log_map, bool radix4)
+{
+  if (radix4)
+    return log_map ? rsc_decode<Lanes, N, true, true>
+           : rsc_decode<Lanes, N, false, true>;
+  return log_map ? rsc_decode<Lanes, N, true, false>
+         : rsc_decode<Lanes, N, false, false>;
+}
+
+static Rsc_Decode rsc_decoder(int nstates, bool log_map, bool radix4)
+{
+  switch (nstates) {
+  case 4:
+    return rsc_decoder<4>(log_map, radix4);
+  case 8:
+    return rsc_decoder<8>(log_map, radix4);
+  case 16:
+    return rsc_decoder<16>(log_map, radix4);
+  case 32:
+    return rsc_decoder<32>(log_map, radix4);
+  default:
+    return rsc_decoder<64>(log_map, radix4);
+  }
+}
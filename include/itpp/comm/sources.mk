@@ -1,3 +1,9 @@
+noinst_h_comm_sources = \
+	$(top_srcdir)/itpp/comm/ldpc_min_sum.h \
+	$(top_srcdir)/itpp/comm/ldpc_min_sum_kernels.h \
+	$(top_srcdir)/itpp/comm/rsc_trellis.h \
+	$(top_srcdir)/itpp/comm/rsc_trellis_kernels.h
+
 h_comm_sources = \
 	$(top_srcdir)/itpp/comm/bch.h \
 	$(top_srcdir)/itpp/comm/channel_code.h \
@@ -39,6 +45,7 @@ cpp_comm_sources = \
 	$(top_srcdir)/itpp/comm/hammcode.cpp \
 	$(top_srcdir)/itpp/comm/interleave.cpp \
 	$(top_srcdir)/itpp/comm/ldpc.cpp \
+	$(top_srcdir)/itpp/comm/ldpc_min_sum.cpp \
 	$(top_srcdir)/itpp/comm/llr.cpp \
 	$(top_srcdir)/itpp/comm/modulator.cpp \
 	$(top_srcdir)/itpp/comm/modulator_nd.cpp \
@@ -47,6 +54,7 @@ cpp_comm_sources = \
 	$(top_srcdir)/itpp/comm/punct_convcode.cpp \
 	$(top_srcdir)/itpp/comm/rec_syst_conv_code.cpp \
 	$(top_srcdir)/itpp/comm/reedsolomon.cpp \
+	$(top_srcdir)/itpp/comm/rsc_trellis.cpp \
 	$(top_srcdir)/itpp/comm/sequence.cpp \
 	$(top_srcdir)/itpp/comm/siso_dem.cpp \
 	$(top_srcdir)/itpp/comm/siso_eq.cpp \
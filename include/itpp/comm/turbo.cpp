@@ -34,6 +34,17 @@ namespace itpp
 // -------------------------------------------------------------------------------------
 // Turbo Codec
 // -------------------------------------------------------------------------------------
+Turbo_Codec::Turbo_Codec(const Turbo_Codec &t):
+    interleaver_size(t.interleaver_size), Ncoded(t.Ncoded), Nuncoded(t.Nuncoded),
+    m_tail(t.m_tail), n1(t.n1), n2(t.n2), n_tot(t.n_tot), iterations(t.iterations),
+    Ec(t.Ec), N0(t.N0), Lc(t.Lc), R(t.R), logmax_scale_factor(t.logmax_scale_factor),
+    adaptive_stop(t.adaptive_stop), metric(t.metric),
+    decoded_bits_previous_iteration(t.decoded_bits_previous_iteration),
+    rscc1(t.rscc1), rscc2(t.rscc2), bit_interleaver(t.bit_interleaver),
+    float_interleaver(t.float_interleaver)
+{
+}
+
 std::string Turbo_Codec::string_from_metric(const Turbo_Codec::Metric& in_metric)
 {
   if(in_metric == Metric::LOGMAX) {
@@ -162,6 +173,18 @@ void Turbo_Codec::set_adaptive_stop(bool in_adaptive_stop)
   adaptive_stop = in_adaptive_stop;
 }
 
+void Turbo_Codec::set_decoder_window(int window_length, int training_length)
+{
+  rscc1.set_decoder_window(window_length, training_length);
+  rscc2.set_decoder_window(window_length, training_length);
+}
+
+void Turbo_Codec::set_decoder_sub_blocks(int nrof_sub_blocks)
+{
+  rscc1.set_decoder_sub_blocks(nrof_sub_blocks);
+  rscc2.set_decoder_sub_blocks(nrof_sub_blocks);
+}
+
 void Turbo_Codec::set_awgn_channel_parameters(double in_Ec, double in_N0)
 {
   Ec = in_Ec;
@@ -323,6 +346,30 @@ void Turbo_Codec::decode(const vec &received_signal, bvec &decoded_bits, ivec &n
 
 }
 
+void Turbo_Codec::decode_batch(const mat &received_signals, bmat &decoded_bits, imat &nrof_used_iterations) const
+{
+  int nframes = received_signals.cols();
+  int no_blocks = received_signals.rows() / Ncoded;
+  it_assert(no_blocks * Ncoded == received_signals.rows(),
+            "Turbo_Codec::decode_batch: The frames must hold a whole number of code blocks");
+  decoded_bits.set_size(no_blocks * Nuncoded, nframes, false);
+  nrof_used_iterations.set_size(no_blocks, nframes, false);
+
+  // The threads decode with their own copy of the codec, which is not modified
+#pragma omp parallel
+  {
+    Turbo_Codec worker(*this);
+    bvec bits;
+    ivec iters;
+#pragma omp for schedule(dynamic)
+    for(int j = 0; j < nframes; j++) {
+      worker.decode(received_signals.get_col(j), bits, iters);
+      decoded_bits.set_col(j, bits);
+      nrof_used_iterations.set_col(j, iters);
+    }
+  }
+}
+
 void Turbo_Codec::encode_block(const bvec &input, bvec &in1, bvec &in2, bmat &parity1, bmat &parity2)
 {
   //Local variables:
@@ -760,11 +807,37 @@ void Punctured_Turbo_Codec::encode(const bvec &input, bvec &output)
 
 
 void Punctured_Turbo_Codec::decode(const vec &received_signal, bvec &decoded_bits, ivec &nrof_used_iterations, const bvec &true_bits)
+{
+  vec temp;
+  depuncture(received_signal, temp);
+  Turbo_Codec::decode(temp, decoded_bits, nrof_used_iterations, true_bits);
+}
+
+void Punctured_Turbo_Codec::decode(const vec &received_signal, bvec &decoded_bits, const bvec &true_bits)
+{
+  ivec nrof_used_iterations;
+  decode(received_signal, decoded_bits, nrof_used_iterations, true_bits);
+}
+
+void Punctured_Turbo_Codec::decode_batch(const mat &received_signals, bmat &decoded_bits,
+                                         imat &nrof_used_iterations) const
+{
+  const int no_blocks = received_signals.rows() / pNcoded;
+  mat temp(no_blocks * Ncoded, received_signals.cols());
+  vec col;
+  for(int j = 0; j < received_signals.cols(); j++) {
+    depuncture(received_signals.get_col(j), col);
+    temp.set_col(j, col);
+  }
+  Turbo_Codec::decode_batch(temp, decoded_bits, nrof_used_iterations);
+}
+
+void Punctured_Turbo_Codec::depuncture(const vec &received_signal, vec &temp) const
 {
   int i, k, p, j, p1;
   int index = 0, index_p = 0;
   int no_blocks = received_signal.size() / pNcoded;
-  vec temp(no_blocks * Ncoded);
+  temp.set_size(no_blocks * Ncoded, false);
 
   it_assert(Period != 0, "Punctured_Turbo_Codec: puncture matrix is not set");
   it_assert(no_blocks * pNcoded == received_signal.size(), "Punctured_Turbo_Codec: received vector is not an integer multiple of encoded block");
@@ -825,14 +898,6 @@ void Punctured_Turbo_Codec::decode(const vec &received_signal, bvec &decoded_bit
       p1 = (p1 + 1) % Period;
     } //2nd tail
   }  // for
-
-  Turbo_Codec::decode(temp, decoded_bits, nrof_used_iterations, true_bits);
-}
-
-void Punctured_Turbo_Codec::decode(const vec &received_signal, bvec &decoded_bits, const bvec &true_bits)
-{
-  ivec nrof_used_iterations;
-  decode(received_signal, decoded_bits, nrof_used_iterations, true_bits);
 }
 
 void Punctured_Turbo_Codec::calculate_punctured_size(void)
@@ -70,6 +70,9 @@ public:
   //! Class constructor
   Turbo_Codec(void) {}
 
+  //! Copy constructor, e.g. for a decoder per thread
+  Turbo_Codec(const Turbo_Codec &t);
+
   //! Class destructor
   virtual ~Turbo_Codec(void) {}
 
@@ -169,6 +172,28 @@ public:
   */
   void set_scaling_factor(double in_Lc);
 
+  /*!
+    \brief Set the window of the constituent decoders
+
+    See Rec_Syst_Conv_Code::set_decoder_window(). It applies to the "MAP",
+    "LOGMAP" and "LOGMAX" metrics with constituent codes of 4 to 64 states.
+  */
+  void set_decoder_window(int window_length, int training_length = 32);
+
+  /*!
+    \brief Set the number of sub-blocks of a code block decoded in parallel
+
+    Each constituent decoder cuts the block into \a nrof_sub_blocks parts
+    decoded concurrently by the OpenMP threads, the state metrics at the
+    boundaries of the parts being trained over the training length of
+    set_decoder_window(). A number of sub-blocks around the number of
+    threads reduces the decoding time of a long block, e.g. the 6144 bits
+    of lte_turbo_interleaver_sequence(), at the cost of a small loss of
+    performance. See Rec_Syst_Conv_Code::set_decoder_sub_blocks(). The
+    default is 1.
+  */
+  void set_decoder_sub_blocks(int nrof_sub_blocks);
+
   /*!
     \brief Encoder function
 
@@ -218,6 +243,19 @@ public:
   virtual void decode(const vec &received_signal, bvec &decoded_bits, ivec &nrof_used_iterations,
                       const bvec &true_bits = "0");
 
+  /*!
+    \brief Decoding of several frames
+
+    Decodes each column of \a received_signals as decode() would, the frames being spread over the OpenMP threads.
+    Each thread decodes with its own copy of the constituent decoders, so that the object is not modified. A frame
+    holds a whole number of code blocks.
+
+    \param received_signals The received bits of a frame per column
+    \param decoded_bits The decoded bits of a frame per column
+    \param nrof_used_iterations The number of used iterations for each code block (row) of each frame (column)
+  */
+  virtual void decode_batch(const mat &received_signals, bmat &decoded_bits, imat &nrof_used_iterations) const;
+
   /*!
     \brief Encode a single block
 
@@ -478,6 +516,13 @@ public:
   virtual void decode(const vec &received_signal, bvec &decoded_bits, ivec &nrof_used_iterations,
                       const bvec &true_bits = "0");
 
+  /*!
+    \brief Decoding of several frames
+
+    Decodes each column of \a received_signals as decode() would, see Turbo_Codec::decode_batch().
+  */
+  virtual void decode_batch(const mat &received_signals, bmat &decoded_bits, imat &nrof_used_iterations) const;
+
   /*!
     \brief Calculates length of uncoded block
 
@@ -501,6 +546,11 @@ protected:
   */
   void calculate_punctured_size(void);
 
+  /*!
+    \brief Inserts zeros in place of the punctured bits of several consecutive blocks, as expected by Turbo_Codec
+  */
+  void depuncture(const vec &received_signal, vec &depunctured_signal) const;
+
   //Scalars:
   int Period; ///< Number of columns in the puncturing matrix
   long pNcoded;
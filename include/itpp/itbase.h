@@ -101,6 +101,7 @@
 #include <itpp/base/math/min_max.h>
 #include <itpp/base/math/misc.h>
 #include <itpp/base/math/trig_hyp.h>
+#include <itpp/base/math/vmath.h>
 
 #include <itpp/base/array.h>
 #include <itpp/base/bessel.h>
@@ -108,6 +109,7 @@
 #include <itpp/base/binfile.h>
 #include <itpp/base/circular_buffer.h>
 #include <itpp/base/converters.h>
+#include <itpp/base/elem_expr.h>
 #include <itpp/base/factory.h>
 #include <itpp/base/fastmath.h>
 #include <itpp/base/gf2mat.h>
@@ -125,6 +127,7 @@
 #include <itpp/base/stack.h>
 #include <itpp/base/timing.h>
 #include <itpp/base/vec.h>
+#include <itpp/base/view.h>
 #include <itpp/base/base_exports.h>
 
 #endif // #ifndef ITBASE_H
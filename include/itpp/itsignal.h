@@ -62,6 +62,7 @@
 
 #include <itpp/itbase.h>
 #include <itpp/signal/fastica.h>
+#include <itpp/signal/fastica_io.h>
 #include <itpp/signal/filter.h>
 #include <itpp/signal/filter_design.h>
 #include <itpp/signal/freq_filt.h>
@@ -59,44 +59,347 @@
  * - default approach is SYMM with non-linearity POW3
  */
 
+#ifndef _MSC_VER
+#  include <itpp/config.h>
+#else
+#  include <itpp/config_msvc.h>
+#endif
+
 #include <itpp/signal/fastica.h>
+#include <itpp/signal/fastica_io.h>
 #include <itpp/signal/sigfun.h>
 #include <itpp/signal/resampling.h>
+#include <itpp/base/array.h>
 #include <itpp/base/algebra/eigen.h>
 #include <itpp/base/algebra/svd.h>
+#include <itpp/base/elem_expr.h>
+#include <itpp/base/view.h>
 #include <itpp/base/math/trig_hyp.h>
+#include <itpp/base/math/vmath.h>
+#include <itpp/base/ittypes.h>
 #include <itpp/base/matfunc.h>
 #include <itpp/base/random.h>
 #include <itpp/base/sort.h>
 #include <itpp/base/specmat.h>
-#include <itpp/base/svec.h>
+#include <itpp/base/timing.h>
 #include <itpp/base/math/min_max.h>
 #include <itpp/stat/misc_stat.h>
 
+#if defined(HAVE_BLAS)
+#  include <itpp/base/blas.h>
+#else
+#  include <itpp/base/native_blas.h>
+#endif
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
 
 using namespace itpp;
 
 
+namespace
+{
+
+//! Per-chunk scratch buffers of the fixed-point iterations, kept across
+//! rounds, for samples of type T (double or float)
+template<class T>
+struct Fica_Workspace
+{
+  Array<Mat<T> > Y, Gb;
+  Array<mat> G;
+  Array<vec> Beta, dG;
+
+  void set_size(int n) {
+    if (Y.size() == n) return;
+    Y.set_size(n);
+    Gb.set_size(n);
+    G.set_size(n);
+    Beta.set_size(n);
+    dG.set_size(n);
+  }
+};
+
+//! Selection of the samples used by the subsampled fixed-point iterations
+class Fica_Sampler
+{
+public:
+  Fica_Sampler() { setup(FICA_SAMPLING_RANDOM, FICA_SAMPLING_SEED, 1.0); }
+  //! Set the sampling scheme, the seed and the growth of the sample fraction
+  void setup(int in_mode, unsigned int seed, double in_growth);
+  //! Fraction of the samples to use in the next round
+  double next_round(double sampleSize);
+  //! Copy a \c fraction of the columns of \c X into \c Xsub. Returns their number
+  template<class T> int gather(const Mat<T> &X, double fraction, Mat<T> &Xsub);
+private:
+  //! Uniform number in [0, 1)
+  double draw();
+  //! Fill begins and lengths with the blocks of consecutive samples to use
+  void select(int n, double fraction);
+  int mode;
+  uint32_t state;
+  double growth, scale;
+  std::vector<int> begins, lengths;
+};
+
+//! Source of whitened samples for the fixed-point iterations
+class Fica_Data
+{
+public:
+  virtual ~Fica_Data() {}
+  //! Dimension of the whitened samples
+  virtual int rows() const = 0;
+  //! Number of samples
+  virtual int cols() const = 0;
+  //! G = X * g(transpose(X) * B) over all samples, or over a subset of them
+  //! chosen by sampler when sampleSize < 1. Returns the number of samples used.
+  virtual int nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG) = 0;
+  //! Subsampling scheme
+  Fica_Sampler sampler;
+};
+
+//! Whitened samples held in memory
+class Fica_Mat_Data : public Fica_Data
+{
+public:
+  //! Uses the scratch buffers \c in_ws if given, its own ones otherwise
+  Fica_Mat_Data(const mat &in_X, int in_numThreads, Fica_Workspace<double> *in_ws = 0)
+      : X(in_X), numThreads(in_numThreads), ws(in_ws ? *in_ws : ownWs) {}
+  int rows() const { return X.rows(); }
+  int cols() const { return X.cols(); }
+  int nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG);
+private:
+  const mat &X;
+  int numThreads;
+  mat Xsub;
+  Fica_Workspace<double> ownWs;
+  Fica_Workspace<double> &ws;
+};
+
+//! Whitened samples held in memory in single precision
+class Fica_Float_Data : public Fica_Data
+{
+public:
+  Fica_Float_Data(int in_numThreads) : numThreads(in_numThreads) {}
+  int rows() const { return X.rows(); }
+  int cols() const { return X.cols(); }
+  int nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG);
+  //! Filled by fica_whiten_float()
+  Mat<float> X;
+private:
+  int numThreads;
+  Mat<float> Xsub;
+  Fica_Workspace<float> ws;
+};
+
+//! ICA_Reader over the columns of a matrix held in memory
+class Fica_Mat_Reader : public ICA_Reader
+{
+public:
+  Fica_Mat_Reader(const mat &in_X) : X(in_X), pos(0) {}
+  int channels() const { return X.rows(); }
+  void rewind() { pos = 0; }
+  int read(mat &chunk, int n);
+private:
+  const mat &X;
+  int pos;
+};
+
+//! Blocks of consecutive columns of a matrix, or chunks read from a stream
+class Fica_Blocks
+{
+public:
+  //! Blocks of \c X if it is not 0, else chunks of \c in_reader
+  Fica_Blocks(const mat *in_X, ICA_Reader &in_reader, int in_chunkSize)
+      : X(in_X), reader(in_reader), chunkSize(in_chunkSize), pos(0) {}
+  int channels() const { return X ? X->rows() : reader.channels(); }
+  void rewind();
+  //! Next block of \c n samples, or 0 after the last one
+  const double *next(int &n);
+private:
+  const mat *X;
+  ICA_Reader &reader;
+  int chunkSize, pos;
+  mat chunk;
+};
+
+//! Samples read chunk by chunk from an ICA_Reader and whitened on the fly
+class Fica_Stream_Data : public Fica_Data
+{
+public:
+  Fica_Stream_Data(ICA_Reader &in_reader, const vec &meanValue, const mat &in_whiteningMatrix, int in_numSamples, int in_chunkSize, int in_numThreads);
+  int rows() const { return whiteningMatrix.rows(); }
+  int cols() const { return numSamples; }
+  int nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG);
+private:
+  ICA_Reader &reader;
+  const mat &whiteningMatrix;
+  vec whiteMean;
+  int numSamples, chunkSize, numThreads;
+  Fica_Workspace<double> ws;
+  mat chunk, whiteChunk, subChunk, Gc;
+  vec Betac, dGc;
+};
+
+//! State of a candidate vector of the blocked deflation approach
+struct Fica_Candidate
+{
+  vec w, wOld, wOld2;
+  double myy, stroke, lastStep;
+  int usedNlinearity, notFine, loong, i, endFinetuning;
+  //! Converged while waiting for the candidates before it
+  bool settled;
+
+  void init(const vec &w0, int g, double myy0) {
+    w = w0;
+    wOld = zeros(w0.size());
+    wOld2 = zeros(w0.size());
+    myy = myy0;
+    stroke = 0.0;
+    lastStep = 2.0;
+    usedNlinearity = g;
+    notFine = 1;
+    loong = 0;
+    i = 1;
+    endFinetuning = 0;
+    settled = false;
+  }
+};
+
+//! Collects the telemetry of Fast_ICA::separate() into a Fast_ICA_Stats
+class Fica_Monitor
+{
+public:
+  Fica_Monitor(Fast_ICA_Stats &in_stats, Fast_ICA_Callback in_callback, void *in_userData);
+  //! Charge the time since the previous mark to \c phase
+  void mark(int phase);
+  //! Start a fixed-point round, charging the previous round to its phase
+  void round(int phase, int component, double minAbsCos, int nonlinearity, double mu);
+  //! Charge the last round to its phase
+  void end_rounds();
+  //! Count a halving of the step size
+  void step_halved() { stats.nrof_step_halvings++; }
+  //! Count the allocation of a signal-sized buffer
+  void add_bytes(double bytes) { stats.bytes_estimated += bytes; }
+  //! Copy the traces into the report
+  void finish();
+  //! When true, rounds are charged to FICA_PHASE_REFINEMENT
+  bool refinement;
+private:
+  void emit(int phase, int component, int round, double minAbsCos, int nonlinearity, double mu, double now);
+  Fast_ICA_Stats &stats;
+  Fast_ICA_Callback callback;
+  void *userData;
+  Real_Timer timer;
+  double last;
+  int roundPhase;
+  // Entries of componentRounds and lastNonlinearity start at componentBase
+  // for the current call of fpica()
+  int componentBase;
+  std::vector<double> trace;
+  std::vector<int> componentRounds, lastNonlinearity, switches;
+};
+
+} // anonymous namespace
+
+
 /*!
   \brief Local functions for FastICA
   @{
 */
-static void selcol(const mat oldMatrix, const vec maskVector, mat & newMatrix);
-static int pcamat(const mat vectors, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds);
-static void remmean(mat inVectors, mat & outVectors, vec & meanValue);
-static void whitenv(const mat vectors, const mat E, const mat D, mat & newVectors, mat & whiteningMatrix, mat & dewhiteningMatrix);
-static mat orth(const mat A);
-static mat mpower(const mat A, const double y);
-static ivec getSamples(const int max, const double percentage);
-static vec sumcol(const mat A);
-static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningMatrix, const int approach, const int numOfIC, const int g, const int finetune, const double a1, const double a2, double myy, const int stabilization, const double epsilon, const int maxNumIterations, const int maxFinetune, const int initState, mat guess, double sampleSize, mat & A, mat & W);
+static void selcol(const mat &oldMatrix, const vec &maskVector, mat & newMatrix);
+static int pcamat(const mat &vectors, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds, const int numThreads);
+static int pcacov(const mat &covarianceMatrix, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds);
+static int pcarand(Fica_Blocks &signals, const vec &meanValue, const int numSamples, const int numThreads, const double tolerance, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds);
+static int pcasel(const vec &Dt, const mat &Et, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds);
+static int fica_pca_width(const int vectorSize, const int numOfIC, const int lastEig);
+static void remmean(const mat &inVectors, mat & outVectors, vec & meanValue, const int numThreads);
+static void whitenv(const mat &vectors, const mat &E, const mat &D, mat & newVectors, mat & whiteningMatrix, mat & dewhiteningMatrix, const int numThreads);
+static void whitening_matrices(const mat &E, const mat &D, mat & whiteningMatrix, mat & dewhiteningMatrix);
+static mat orth(const mat &A);
+static mat mpower(const mat &A, const double y);
+static void fica_decorrelate(mat &B);
+static void fica_inv_sqrt_small(const int n, double *M);
+static int fica_num_chunks(const int numSamples, const int numThreads);
+static int fica_chunk_begin(const int numSamples, const int numChunks, const int c);
+static mat fica_scatter(const mat &X, const int numThreads);
+static mat fica_cov(const mat &X, const int numThreads);
+static int fica_stream_moments(ICA_Reader &reader, const int chunkSize, const int numThreads, vec &meanValue, mat &covarianceMatrix);
+static int fica_stream_mean(Fica_Blocks &signals, vec &meanValue);
+static mat fica_count_sketch(Fica_Blocks &signals, const vec &meanValue, const int width);
+static mat fica_cov_mult(Fica_Blocks &signals, const vec &meanValue, const int numSamples, const int numThreads, const mat &Q);
+static void fica_mult(const mat &A, const mat &X, mat &out, const int numThreads);
+static void fica_update_moments(const mat &block, const double decay, const int numThreads, double &weight, vec &meanValue, mat &covarianceMatrix);
+static void fica_whiten_float(const mat &X, const vec &meanValue, const mat &whiteningMatrix, Mat<float> &out, const int numThreads);
+static void fica_gemm(const char transA, const char transB, const int m, const int n, const int k, const double *A, const int ldA, const double *B, const int ldB, const double beta, double *C, const int ldC);
+static void fica_gemm(const char transA, const char transB, const int m, const int n, const int k, const float *A, const int ldA, const float *B, const int ldB, const float beta, float *C, const int ldC);
+static const double *fica_cast(const mat &B, mat &out);
+static const float *fica_cast(const mat &B, Mat<float> &out);
+static void fica_add_product(const int vectorSize, const int numOfIC, const int n, const double *Xb, const double *Y, const int ldY, mat &Gb, mat &G);
+static void fica_add_product(const int vectorSize, const int numOfIC, const int n, const float *Xb, const float *Y, const int ldY, Mat<float> &Gb, mat &G);
+template<class T> static void fica_nonlin_apply(T *y, const int n, const int g, const double a1, const double a2, double &beta, double &dg);
+template<class T> static void fica_nonlin_block(const Mat<T> &X, const T *B, const int numOfIC, const int g, const double a1, const double a2, const int tBegin, const int tEnd, Mat<T> &Y, Mat<T> &Gb, mat &G, vec &Beta, vec &dG);
+template<class T> static void fica_nonlin_symm(const Mat<T> &X, const mat &B, const int g, const double a1, const double a2, const int numThreads, Fica_Workspace<T> &ws, mat &G, vec &Beta, vec &dG);
+static void fica_end_subsampling(int &usedNlinearity, const double step, double &lastStep, const bool stabilized);
+static bool fpica_defl_blocked(Fica_Data &X, const mat &whiteningMatrix, const mat &dewhiteningMatrix, const int numOfIC, const int gOrig, const int gFine, const int fineTuningEnabled, const int stabilizationEnabled, const double a1, const double a2, const double myyOrig, const double myyK, const double epsilon, const int maxNumIterations, const int maxFinetune, const int failureLimit, const int initialStateMode, const mat &guess, const double sampleSize, const int deflBlock, mat & A, mat & W, Fica_Monitor *mon);
+static bool fpica(Fica_Data &X, const mat &whiteningMatrix, const mat &dewhiteningMatrix, const int approach, const int numOfIC, const int g, const int finetune, const double a1, const double a2, double myy, const int stabilization, const double epsilon, const int maxNumIterations, const int maxFinetune, const int initState, mat guess, double sampleSize, const int deflBlock, mat & A, mat & W, Fica_Monitor *mon);
 /*! @} */
 
 namespace itpp
 {
 
 // Constructor, init default values
-Fast_ICA::Fast_ICA(mat ma_mixedSig)
+Fast_ICA::Fast_ICA(const mat &ma_mixedSig)
+{
+
+  mixedSig = ma_mixedSig;
+  borrowedSig = 0;
+  reader = 0;
+
+  init(mixedSig.rows());
+
+}
+
+#ifdef FICA_HAVE_RVALUE_REFS
+// Constructor taking over the mixed signals
+Fast_ICA::Fast_ICA(mat &&ma_mixedSig)
+{
+
+  mixedSig = std::move(ma_mixedSig);
+  borrowedSig = 0;
+  reader = 0;
+
+  init(mixedSig.rows());
+
+}
+#endif
+
+// Borrowing constructor, init default values
+Fast_ICA::Fast_ICA(const mat &ma_mixedSig, Fast_ICA_Borrow)
+{
+
+  borrowedSig = &ma_mixedSig;
+  reader = 0;
+
+  init(borrowedSig->rows());
+
+}
+
+// Streaming constructor, init default values
+Fast_ICA::Fast_ICA(ICA_Reader &in_reader)
+{
+
+  borrowedSig = 0;
+  reader = &in_reader;
+
+  init(reader->channels());
+
+}
+
+void Fast_ICA::init(int nrof_channels)
 {
 
   // Init default values
@@ -108,17 +411,28 @@ Fast_ICA::Fast_ICA(mat ma_mixedSig)
   mu = 1.0;
   epsilon = 0.0001;
   sampleSize = 1.0;
+  sampling = FICA_SAMPLING_RANDOM;
+  samplingSeed = FICA_SAMPLING_SEED;
+  sampleGrowth = 1.0;
   stabilization = false;
   maxNumIterations = 100000;
   maxFineTune = 100;
   firstEig = 1;
 
-  mixedSig = ma_mixedSig;
-
-  lastEig = mixedSig.rows();
-  numOfIC = mixedSig.rows();
+  lastEig = nrof_channels;
+  numOfIC = nrof_channels;
+  noResult = zeros(1, 1);
   PCAonly = false;
   initState = FICA_INIT_RAND;
+  numThreads = 1;
+  chunkSize = FICA_CHUNK_SIZE;
+  singlePrecision = false;
+  refinementIterations = 0;
+  callback = 0;
+  callbackData = 0;
+  deflBlock = 1;
+  pcaMethod = FICA_PCA_FULL;
+  pcaTolerance = FICA_PCA_TOL;
 
 }
 
@@ -126,32 +440,74 @@ Fast_ICA::Fast_ICA(mat ma_mixedSig)
 bool Fast_ICA::separate(void)
 {
 
+  const mat &mixed = borrowedSig ? *borrowedSig : mixedSig;
+
   int Dim = numOfIC;
+  int vectorSize = reader ? reader->channels() : mixed.rows();
 
   mat mixedSigC;
   vec mixedMean;
 
+  Fica_Monitor mon(stats, callback, callbackData);
+
   mat guess;
   if (initState == FICA_INIT_RAND)
     guess = zeros(Dim, Dim);
   else
     guess = mat(initGuess);
 
-  VecPr = zeros(mixedSig.rows(), numOfIC);
-
-  icasig = zeros(numOfIC, mixedSig.cols());
+  VecPr = zeros(vectorSize, numOfIC);
+
+  int numPCs = 0;
+  mat covarianceMatrix;
+  Fica_Mat_Reader mixedReader(mixed);
+  ICA_Reader &signals = reader ? *reader : mixedReader;
+  Fica_Blocks blocks(reader ? 0 : &mixed, signals, chunkSize);
+
+  // The randomized PCA needs only the mean; it is not worth it when most
+  // of the eigenvectors are needed anyway
+  bool randomized = (pcaMethod == FICA_PCA_RANDOMIZED)
+                    && (fica_pca_width(vectorSize, numOfIC, lastEig) < vectorSize);
+
+  if (reader || singlePrecision) {
+    // Streaming mode or single precision: accumulate the mean and the
+    // covariance chunk by chunk, without a centered copy of the signals
+    if (randomized)
+      numSamples = fica_stream_mean(blocks, mixedMean);
+    else
+      numSamples = fica_stream_moments(signals, chunkSize, numThreads, mixedMean, covarianceMatrix);
+    if (reader) mon.add_bytes(8.0 * vectorSize * chunkSize);
+  }
+  else {
+    numSamples = mixed.cols();
+    remmean(mixed, mixedSigC, mixedMean, numThreads);
+    mon.add_bytes(8.0 * mixedSigC.size());
+    if (!randomized) covarianceMatrix = fica_cov(mixedSigC, numThreads);
+  }
+  mon.mark(FICA_PHASE_MOMENTS);
 
-  remmean(mixedSig, mixedSigC, mixedMean);
+  if (randomized)
+    numPCs = pcarand(blocks, mixedMean, numSamples, numThreads, pcaTolerance, numOfIC, firstEig, lastEig, E, D);
+  else
+    numPCs = pcacov(covarianceMatrix, numOfIC, firstEig, lastEig, E, D);
+  mon.mark(FICA_PHASE_PCA);
 
-  if (pcamat(mixedSigC, numOfIC, firstEig, lastEig, E, D) < 1) {
+  if (numPCs < 1) {
     // no principal components could be found (e.g. all-zero data): return the unchanged input
-    icasig = mixedSig;
+    icasig = mixed;
+    mon.finish();
     return false;
   }
 
-  whitenv(mixedSigC, E, diag(D), whitesig, whiteningMatrix, dewhiteningMatrix);
+  if (reader || singlePrecision)
+    whitening_matrices(E, diag(D), whiteningMatrix, dewhiteningMatrix);
+  else {
+    whitenv(mixedSigC, E, diag(D), whitesig, whiteningMatrix, dewhiteningMatrix, numThreads);
+    mon.add_bytes(8.0 * whitesig.size());
+    mixedSigC.set_size(0, 0);
+  }
 
-  Dim = whitesig.rows();
+  Dim = whiteningMatrix.rows();
   if (numOfIC > Dim) numOfIC = Dim;
 
   ivec NcFirst = to_ivec(zeros(numOfIC));
@@ -167,18 +523,83 @@ bool Fast_ICA::separate(void)
   bool result = true;
   if (PCAonly == false) {
 
-    result = fpica(whitesig, whiteningMatrix, dewhiteningMatrix, approach, numOfIC, g, finetune, a1, a2, mu, stabilization, epsilon, maxNumIterations, maxFineTune, initState, guess, sampleSize, A, W);
+    if (reader) {
+      // Further passes over the stream for the fixed-point iterations
+      mon.mark(FICA_PHASE_WHITENING);
+      Fica_Stream_Data X(*reader, mixedMean, whiteningMatrix, numSamples, chunkSize, numThreads);
+      X.sampler.setup(sampling, samplingSeed, sampleGrowth);
+      mon.add_bytes(8.0 * Dim * chunkSize);
+      result = fpica(X, whiteningMatrix, dewhiteningMatrix, approach, numOfIC, g, finetune, a1, a2, mu, stabilization, epsilon, maxNumIterations, maxFineTune, initState, guess, sampleSize, deflBlock, A, W, &mon);
+      mon.end_rounds();
+    }
+    else if (singlePrecision) {
+      Fica_Float_Data X(numThreads);
+      X.sampler.setup(sampling, samplingSeed, sampleGrowth);
+      fica_whiten_float(mixed, mixedMean, whiteningMatrix, X.X, numThreads);
+      mon.add_bytes(4.0 * X.X.size());
+      mon.mark(FICA_PHASE_WHITENING);
+      result = fpica(X, whiteningMatrix, dewhiteningMatrix, approach, numOfIC, g, finetune, a1, a2, mu, stabilization, epsilon, maxNumIterations, maxFineTune, initState, guess, sampleSize, deflBlock, A, W, &mon);
+      mon.end_rounds();
+
+      if (refinementIterations > 0) {
+        // Double precision refinement, starting from the single precision
+        // solution and whitening the signals on the fly
+        X.X.set_size(0, 0);
+        Fica_Stream_Data Xd(mixedReader, mixedMean, whiteningMatrix, numSamples, chunkSize, numThreads);
+        Xd.sampler.setup(sampling, samplingSeed, sampleGrowth);
+        mon.refinement = true;
+        result = fpica(Xd, whiteningMatrix, dewhiteningMatrix, approach, numOfIC, g, false, a1, a2, mu, stabilization, epsilon, refinementIterations + 1, maxFineTune, FICA_INIT_GUESS, A, sampleSize, deflBlock, A, W, &mon);
+        mon.end_rounds();
+      }
 
-    icasig = W * mixedSig;
+      fica_mult(W, mixed, icasig, numThreads);
+      mon.add_bytes(8.0 * icasig.size());
+      mon.mark(FICA_PHASE_OUTPUT);
+    }
+    else {
+      mon.mark(FICA_PHASE_WHITENING);
+      Fica_Mat_Data X(whitesig, numThreads);
+      X.sampler.setup(sampling, samplingSeed, sampleGrowth);
+      result = fpica(X, whiteningMatrix, dewhiteningMatrix, approach, numOfIC, g, finetune, a1, a2, mu, stabilization, epsilon, maxNumIterations, maxFineTune, initState, guess, sampleSize, deflBlock, A, W, &mon);
+      mon.end_rounds();
+
+      fica_mult(W, mixed, icasig, numThreads);
+      mon.add_bytes(8.0 * icasig.size());
+      mon.mark(FICA_PHASE_OUTPUT);
+    }
 
   }
 
   else { // PCA only : returns E as IcaSig
+    mon.mark(FICA_PHASE_WHITENING);
     icasig = VecPr;
   }
+  mon.finish();
   return result;
 }
 
+bool Fast_ICA::write_independent_components(ICA_Writer &writer)
+{
+  if (PCAonly) { it_warning("No ICA performed."); return false; }
+
+  if (!reader) {
+    for (int t0 = 0; t0 < icasig.cols(); t0 += chunkSize) {
+      int t1 = (t0 + chunkSize < icasig.cols()) ? t0 + chunkSize : icasig.cols();
+      if (!writer.write(icasig.get_cols(t0, t1 - 1))) return false;
+    }
+    return true;
+  }
+
+  // Streaming mode: one more pass, separating each chunk as it is read
+  mat chunk, out;
+  reader->rewind();
+  while (reader->read(chunk, chunkSize) > 0) {
+    fica_mult(W, chunk, out, numThreads);
+    if (!writer.write(out)) return false;
+  }
+  return true;
+}
+
 void Fast_ICA::set_approach(int in_approach) { approach = in_approach; if (approach == FICA_APPROACH_DEFL) finetune = true; }
 
 void Fast_ICA::set_nrof_independent_components(int in_nrIC) { numOfIC = in_nrIC; }
@@ -197,6 +618,20 @@ void Fast_ICA::set_epsilon(double fl_epsilon) { epsilon = fl_epsilon; }
 
 void Fast_ICA::set_sample_size(double fl_sampleSize) { sampleSize = fl_sampleSize; }
 
+void Fast_ICA::set_sampling(int in_sampling)
+{
+  it_assert(in_sampling == FICA_SAMPLING_RANDOM || in_sampling == FICA_SAMPLING_STRATIFIED || in_sampling == FICA_SAMPLING_STRIDED, "Fast_ICA::set_sampling(): Unknown sampling scheme");
+  sampling = in_sampling;
+}
+
+void Fast_ICA::set_sampling_seed(unsigned int in_seed) { samplingSeed = in_seed; }
+
+void Fast_ICA::set_sample_growth(double in_growth)
+{
+  it_assert(in_growth >= 1.0, "Fast_ICA::set_sample_growth(): Growth factor must be at least 1");
+  sampleGrowth = in_growth;
+}
+
 void Fast_ICA::set_stabilization(bool in_stabilization) { stabilization = in_stabilization; }
 
 void Fast_ICA::set_max_num_iterations(int in_maxNumIterations) { maxNumIterations = in_maxNumIterations; }
@@ -209,239 +644,1808 @@ void Fast_ICA::set_last_eig(int in_lastEig) { lastEig = in_lastEig; }
 
 void Fast_ICA::set_pca_only(bool in_PCAonly) { PCAonly = in_PCAonly; }
 
-void Fast_ICA::set_init_guess(mat ma_initGuess)
+void Fast_ICA::set_chunk_size(int in_chunkSize)
+{
+  it_assert(in_chunkSize >= 1, "Fast_ICA::set_chunk_size(): Chunk size must be positive");
+  chunkSize = in_chunkSize;
+}
+
+void Fast_ICA::set_deflation_block(int in_deflBlock)
+{
+  it_assert(in_deflBlock >= 1, "Fast_ICA::set_deflation_block(): Block size must be positive");
+  deflBlock = in_deflBlock;
+}
+
+void Fast_ICA::set_single_precision(bool in_singlePrecision) { singlePrecision = in_singlePrecision; }
+
+void Fast_ICA::set_pca_method(int in_pcaMethod)
+{
+  it_assert((in_pcaMethod == FICA_PCA_FULL) || (in_pcaMethod == FICA_PCA_RANDOMIZED), "Fast_ICA::set_pca_method(): unknown method");
+  pcaMethod = in_pcaMethod;
+}
+
+void Fast_ICA::set_pca_tolerance(double in_pcaTolerance)
+{
+  it_assert(in_pcaTolerance > 0.0, "Fast_ICA::set_pca_tolerance(): tolerance must be positive");
+  pcaTolerance = in_pcaTolerance;
+}
+
+void Fast_ICA::set_refinement_iterations(int in_refinementIterations)
+{
+  it_assert(in_refinementIterations >= 0, "Fast_ICA::set_refinement_iterations(): Number of iterations must be non-negative");
+  refinementIterations = in_refinementIterations;
+}
+
+void Fast_ICA::set_num_threads(int in_numThreads)
+{
+  it_assert(in_numThreads >= 1, "Fast_ICA::set_num_threads(): Number of threads must be positive");
+  numThreads = in_numThreads;
+}
+
+void Fast_ICA::set_init_guess(const mat &ma_initGuess)
 {
   initGuess = ma_initGuess;
   initState = FICA_INIT_GUESS;
 }
 
-mat Fast_ICA::get_mixing_matrix() { if (PCAonly) { it_warning("No ICA performed."); return (zeros(1, 1));} else return A; }
+#ifdef FICA_HAVE_RVALUE_REFS
+void Fast_ICA::set_init_guess(mat &&ma_initGuess)
+{
+  initGuess = std::move(ma_initGuess);
+  initState = FICA_INIT_GUESS;
+}
+#endif
+
+const mat &Fast_ICA::get_mixing_matrix() const { if (PCAonly) { it_warning("No ICA performed."); return noResult; } else return A; }
+
+const mat &Fast_ICA::get_separating_matrix() const { if (PCAonly) { it_warning("No ICA performed."); return noResult; } else return W; }
+
+const mat &Fast_ICA::get_independent_components() const
+{
+  if (PCAonly) { it_warning("No ICA performed."); return noResult; }
+  if (reader) { it_warning("Streaming mode: use write_independent_components()."); return noResult; }
+  return icasig;
+}
+
+int Fast_ICA::get_nrof_independent_components() const { return numOfIC; }
+
+void Fast_ICA::set_callback(Fast_ICA_Callback in_callback, void *user_data)
+{
+  callback = in_callback;
+  callbackData = user_data;
+}
+
+const Fast_ICA_Stats &Fast_ICA::get_stats() const { return stats; }
+
+void Fast_ICA_Stats::reset()
+{
+  phase_time = zeros(FICA_NROF_PHASES);
+  phase_rounds = zeros_i(FICA_NROF_PHASES);
+  component_rounds.set_size(0);
+  min_abs_cos.set_size(0);
+  nonlin_switches.set_size(0, 4);
+  nrof_step_halvings = 0;
+  bytes_estimated = 0.0;
+  total_time = 0.0;
+}
+
+int Fast_ICA::get_num_threads() const { return numThreads; }
+
+const mat &Fast_ICA::get_principal_eigenvectors() const { return VecPr; }
+
+const mat &Fast_ICA::get_whitening_matrix() const { return whiteningMatrix; }
+
+const mat &Fast_ICA::get_dewhitening_matrix() const { return dewhiteningMatrix; }
+
+const mat &Fast_ICA::get_white_sig() const { return whitesig; }
+
+// ---------------------- Online_Fast_ICA ----------------------------------
+
+Online_Fast_ICA::Online_Fast_ICA(int in_nrof_channels, int nrof_ics)
+{
+  it_assert(in_nrof_channels >= 1, "Online_Fast_ICA: Number of channels must be positive");
+  it_assert(nrof_ics >= 0 && nrof_ics <= in_nrof_channels, "Online_Fast_ICA: Invalid number of ICs");
+
+  nrof_channels = in_nrof_channels;
+  numOfIC = nrof_ics ? nrof_ics : nrof_channels;
+  g = FICA_NONLIN_POW3;
+  a1 = 1.0;
+  a2 = 1.0;
+  epsilon = 0.0001;
+  lambda = FICA_ONLINE_FORGETTING;
+  windowSize = FICA_ONLINE_WINDOW;
+  maxIterations = FICA_ONLINE_ITERATIONS;
+  numThreads = 1;
+
+  reset();
+}
+
+void Online_Fast_ICA::reset()
+{
+  meanValue = zeros(nrof_channels);
+  covarianceMatrix = zeros(nrof_channels, nrof_channels);
+  weight = 0.0;
+  window.set_size(nrof_channels, windowSize, false);
+  windowPos = 0;
+  windowFill = 0;
+  lastIterations = 0;
+  A.set_size(0, 0);
+  W.set_size(0, 0);
+  whiteningMatrix.set_size(0, 0);
+  dewhiteningMatrix.set_size(0, 0);
+}
+
+void Online_Fast_ICA::set_non_linearity(int in_g) { g = in_g; }
+
+void Online_Fast_ICA::set_a1(double fl_a1) { a1 = fl_a1; }
+
+void Online_Fast_ICA::set_a2(double fl_a2) { a2 = fl_a2; }
+
+void Online_Fast_ICA::set_epsilon(double fl_epsilon) { epsilon = fl_epsilon; }
+
+void Online_Fast_ICA::set_forgetting_factor(double in_lambda)
+{
+  it_assert(in_lambda > 0.0 && in_lambda <= 1.0, "Online_Fast_ICA::set_forgetting_factor(): Forgetting factor must be in ]0, 1]");
+  lambda = in_lambda;
+}
+
+void Online_Fast_ICA::set_window_size(int in_windowSize)
+{
+  it_assert(in_windowSize >= 2, "Online_Fast_ICA::set_window_size(): Window must hold at least 2 samples");
+  windowSize = in_windowSize;
+  window.set_size(nrof_channels, windowSize, false);
+  windowPos = 0;
+  windowFill = 0;
+}
+
+void Online_Fast_ICA::set_max_iterations(int in_maxIterations)
+{
+  it_assert(in_maxIterations >= 1, "Online_Fast_ICA::set_max_iterations(): Number of iterations must be positive");
+  maxIterations = in_maxIterations;
+}
+
+void Online_Fast_ICA::set_num_threads(int in_numThreads)
+{
+  it_assert(in_numThreads >= 1, "Online_Fast_ICA::set_num_threads(): Number of threads must be positive");
+  numThreads = in_numThreads;
+}
+
+void Online_Fast_ICA::push_samples(const mat &block)
+{
+  it_assert(block.rows() == nrof_channels, "Online_Fast_ICA::push_samples(): Wrong number of channels");
+  int n = block.cols();
+  if (n == 0) return;
+
+  fica_update_moments(block, std::pow(lambda, n), numThreads, weight, meanValue, covarianceMatrix);
+
+  // Only the last windowSize samples of the block can remain in the window
+  int t0 = (n > windowSize) ? n - windowSize : 0;
+  for (int t = t0; t < n; t++) {
+    for (int i = 0; i < nrof_channels; i++)
+      window(i, windowPos) = block(i, t);
+    windowPos = (windowPos + 1) % windowSize;
+  }
+  windowFill = (windowFill + n - t0 < windowSize) ? windowFill + n - t0 : windowSize;
+}
+
+bool Online_Fast_ICA::update()
+{
+  lastIterations = 0;
+  if (windowFill < 2) return false;
+
+  mat E;
+  vec D;
+  if (pcacov(covarianceMatrix, numOfIC, 1, nrof_channels, E, D) < 1) return false;
+
+  whitening_matrices(E, diag(D), whiteningMatrix, dewhiteningMatrix);
+  int Dim = whiteningMatrix.rows();
+  int nIC = (numOfIC < Dim) ? numOfIC : Dim;
+
+  // Whiten the window around the running mean. The order of the samples in
+  // the circular buffer does not matter to the iterations.
+  if (windowFill == windowSize)
+    fica_mult(whiteningMatrix, window, whiteWindow, numThreads);
+  else
+    fica_mult(whiteningMatrix, window.get_cols(0, windowFill - 1), whiteWindow, numThreads);
+  vec whiteMean = whiteningMatrix * meanValue;
+  for (int t = 0; t < whiteWindow.cols(); t++)
+    for (int i = 0; i < Dim; i++)
+      whiteWindow(i, t) -= whiteMean(i);
+
+  // Warm start: express the previous separating vectors in the new whitened
+  // space, x being approximately dewhiteningMatrix * z
+  mat B;
+  if (W.rows() == nIC)
+    B = transpose(W * dewhiteningMatrix);
+  else
+    B = orth(randu(Dim, nIC) - 0.5);
+
+  Fica_Mat_Data X(whiteWindow, numThreads);
+  mat BOld, G;
+  vec Beta, dG;
+  bool converged = false;
+
+  for (int round = 0; ; round++) {
+
+    fica_decorrelate(B);
+
+    if (round > 0 && 1 - min(abs(diag(transpose(B) * BOld))) < epsilon) {
+      converged = true;
+      break;
+    }
+    if (round == maxIterations) break;
+
+    BOld = B;
+
+    int n = X.nonlin(B, g, a1, a2, 1.0, G, Beta, dG);
+    for (int j = 0; j < B.cols(); j++)
+      for (int i = 0; i < B.rows(); i++)
+        B(i, j) = (G(i, j) - dG(j) * B(i, j)) / n;
+
+    lastIterations++;
+
+  }
+
+  A = dewhiteningMatrix * B;
+  W = transpose(B) * whiteningMatrix;
+
+  return converged;
+}
+
+void Online_Fast_ICA::separate_samples(const mat &block, mat &out) const
+{
+  it_assert(W.size() > 0, "Online_Fast_ICA::separate_samples(): No separation available, call update() first");
+  fica_mult(W, block, out, numThreads);
+}
+
+const mat &Online_Fast_ICA::get_mixing_matrix() const { return A; }
+
+const mat &Online_Fast_ICA::get_separating_matrix() const { return W; }
+
+const mat &Online_Fast_ICA::get_whitening_matrix() const { return whiteningMatrix; }
+
+int Online_Fast_ICA::get_nrof_iterations() const { return lastIterations; }
+
+// ---------------------- Fast_ICA_Batch ----------------------------------
+
+Fast_ICA_Batch::Fast_ICA_Batch()
+{
+  approach = FICA_APPROACH_SYMM;
+  g = FICA_NONLIN_POW3;
+  finetune = true;
+  a1 = 1.0;
+  a2 = 1.0;
+  mu = 1.0;
+  epsilon = 0.0001;
+  stabilization = false;
+  maxNumIterations = 100000;
+  maxFineTune = 100;
+  numOfIC = 0;
+  numThreads = 1;
+}
+
+void Fast_ICA_Batch::set_approach(int in_approach) { approach = in_approach; if (approach == FICA_APPROACH_DEFL) finetune = true; }
+
+void Fast_ICA_Batch::set_nrof_independent_components(int in_nrIC) { numOfIC = in_nrIC; }
+
+void Fast_ICA_Batch::set_non_linearity(int in_g) { g = in_g; }
+
+void Fast_ICA_Batch::set_fine_tune(bool in_finetune) { finetune = in_finetune; }
+
+void Fast_ICA_Batch::set_a1(double fl_a1) { a1 = fl_a1; }
+
+void Fast_ICA_Batch::set_a2(double fl_a2) { a2 = fl_a2; }
+
+void Fast_ICA_Batch::set_mu(double fl_mu) { mu = fl_mu; }
+
+void Fast_ICA_Batch::set_epsilon(double fl_epsilon) { epsilon = fl_epsilon; }
+
+void Fast_ICA_Batch::set_stabilization(bool in_stabilization) { stabilization = in_stabilization; }
+
+void Fast_ICA_Batch::set_max_num_iterations(int in_maxNumIterations) { maxNumIterations = in_maxNumIterations; }
+
+void Fast_ICA_Batch::set_max_fine_tune(int in_maxFineTune) { maxFineTune = in_maxFineTune; }
+
+void Fast_ICA_Batch::set_num_threads(int in_numThreads)
+{
+  it_assert(in_numThreads >= 1, "Fast_ICA_Batch::set_num_threads(): Number of threads must be positive");
+  numThreads = in_numThreads;
+}
+
+bvec Fast_ICA_Batch::separate(const Array<mat> &mixtures, Array<mat> &A, Array<mat> &W)
+{
+  int nrof_problems = mixtures.size();
+  A.set_size(nrof_problems);
+  W.set_size(nrof_problems);
+  bvec converged(nrof_problems);
+
+  // Random initial guesses in the space of the mixtures, drawn in problem
+  // order from the calling thread
+  Array<mat> guesses(nrof_problems);
+  for (int k = 0; k < nrof_problems; k++) {
+    int nrof_channels = mixtures(k).rows();
+    int nIC = (numOfIC > 0 && numOfIC < nrof_channels) ? numOfIC : nrof_channels;
+    guesses(k) = randu(nrof_channels, nIC) - 0.5;
+  }
+
+  // Scratch buffers of each thread, reused from one problem to the next
+  int nrof_workers = (numThreads < nrof_problems) ? numThreads : nrof_problems;
+  if (nrof_workers < 1) nrof_workers = 1;
+  Array<mat> centered(nrof_workers), whitened(nrof_workers);
+  Array<Fica_Workspace<double> > kernel_ws(nrof_workers);
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(nrof_workers) schedule(dynamic)
+#endif
+  for (int k = 0; k < nrof_problems; k++) {
+#ifdef _OPENMP
+    int t = omp_get_thread_num();
+#else
+    int t = 0;
+#endif
+    mat E, whiteningMatrix, dewhiteningMatrix;
+    vec D, mixedMean;
+
+    remmean(mixtures(k), centered(t), mixedMean, 1);
+    int nIC = guesses(k).cols();
+    if (pcamat(centered(t), nIC, 1, mixtures(k).rows(), E, D, 1) < 1) {
+      A(k).set_size(0, 0);
+      W(k).set_size(0, 0);
+      converged(k) = false;
+      continue;
+    }
+    whitenv(centered(t), E, diag(D), whitened(t), whiteningMatrix, dewhiteningMatrix, 1);
+    if (nIC > whiteningMatrix.rows()) nIC = whiteningMatrix.rows();
+
+    Fica_Mat_Data X(whitened(t), 1, &kernel_ws(t));
+    converged(k) = fpica(X, whiteningMatrix, dewhiteningMatrix, approach, nIC, g, finetune, a1, a2, mu, stabilization, epsilon, maxNumIterations, maxFineTune, FICA_INIT_GUESS, guesses(k), 1.0, 1, A(k), W(k), 0);
+  }
+
+  return converged;
+}
+
+} // namespace itpp
+
+
+static void selcol(const mat &oldMatrix, const vec &maskVector, mat & newMatrix)
+{
+
+  int numTaken = 0;
+
+  for (int i = 0; i < size(maskVector); i++) if (maskVector(i) == 1) numTaken++;
+
+  newMatrix = zeros(oldMatrix.rows(), numTaken);
+
+  numTaken = 0;
+
+  for (int i = 0; i < size(maskVector); i++) {
+
+    if (maskVector(i) == 1) {
+
+      newMatrix.set_col(numTaken, oldMatrix.get_col(i));
+      numTaken++;
+
+    }
+  }
+
+  return;
+
+}
+
+static int pcamat(const mat &vectors, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds, const int numThreads)
+{
+
+  return pcacov(fica_cov(vectors, numThreads), numOfIC, firstEig, lastEig, Es, Ds);
+
+}
 
-mat Fast_ICA::get_separating_matrix() { if (PCAonly) { it_warning("No ICA performed."); return(zeros(1, 1)); } else return W; }
+static int pcacov(const mat &covarianceMatrix, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds)
+{
 
-mat Fast_ICA::get_independent_components() { if (PCAonly) { it_warning("No ICA performed."); return(zeros(1, 1)); } else return icasig; }
+  mat Et;
+  vec Dt;
 
-int Fast_ICA::get_nrof_independent_components() { return numOfIC; }
+  eig_sym(covarianceMatrix, Dt, Et);
 
-mat Fast_ICA::get_principal_eigenvectors() { return VecPr; }
+  return pcasel(Dt, Et, numOfIC, firstEig, lastEig, Es, Ds);
 
-mat Fast_ICA::get_whitening_matrix() { return whiteningMatrix; }
+}
 
-mat Fast_ICA::get_dewhitening_matrix() { return dewhiteningMatrix; }
+// Number of vectors iterated by pcarand()
+static int fica_pca_width(const int vectorSize, const int numOfIC, const int lastEig)
+{
+  int k = (lastEig < numOfIC) ? lastEig : numOfIC;
+  if (k > vectorSize) k = vectorSize;
+  k += FICA_PCA_OVERSAMPLING;
+  return (k < vectorSize) ? k : vectorSize;
+}
 
-mat Fast_ICA::get_white_sig() { return whitesig; }
+// Leading eigenvectors of the covariance of the signals by randomized
+// subspace iteration. The basis Q starts as a count sketch of the centered
+// signals, then every pass over the signals multiplies it by the covariance
+// C, and the Ritz pairs (lambda, u) of C in the span of Q are accepted once
+// the residuals |C u - lambda u| of the wanted ones are below tolerance *
+// lambda_max. The components are then selected as in pcacov(), from the
+// Ritz pairs instead of the full decomposition.
+static int pcarand(Fica_Blocks &signals, const vec &meanValue, const int numSamples, const int numThreads, const double tolerance, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds)
+{
+
+  int vectorSize = signals.channels();
+  int width = fica_pca_width(vectorSize, numOfIC, lastEig);
+  int wanted = width - FICA_PCA_OVERSAMPLING;
+
+  mat Q = orth(fica_count_sketch(signals, meanValue, width));
+  mat Et, V;
+  vec Dt;
+
+  for (int pass = 1; ; pass++) {
+
+    mat Y = fica_cov_mult(signals, meanValue, numSamples, numThreads, Q);
+    mat T = Q.transpose() * Y;
+    eig_sym(0.5 * (T + T.transpose()), Dt, V);
+    Et = Q * V;
+
+    // Dt is sorted in ascending order, and Y * V = C * Et
+    mat R = Y * V;
+    double limit = tolerance * std::max(Dt(Dt.size() - 1), FICA_TOL);
+    bool converged = true;
+    for (int i = Dt.size() - 1; (i >= 0) && (i >= Dt.size() - wanted) && converged; i--) {
+      if (norm(R.get_col(i) - Dt(i) * Et.get_col(i)) > limit) converged = false;
+    }
+    if (converged || (pass == FICA_PCA_MAX_PASSES)) break;
+
+    Q = orth(Y);
+
+  }
+
+  return pcasel(Dt, Et, numOfIC, firstEig, lastEig, Es, Ds);
+
+}
+
+// Selects the eigenvectors Et (eigenvalues Dt) firstEig to lastEig by
+// decreasing eigenvalues, at most numOfIC of them
+static int pcasel(const vec &Dt, const mat &Et, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds)
+{
+
+  double lowerLimitValue = 0.0,
+                           higherLimitValue = 0.0;
+
+  int oldDimension = Dt.size();
+
+  int maxLastEig = 0;
+
+  // Compute rank
+  for (int i = 0; i < Dt.length(); i++) if (Dt(i) > FICA_TOL) maxLastEig++;
+  if (maxLastEig < 1) return 0;
+
+  // Force numOfIC components
+  if (maxLastEig > numOfIC) maxLastEig = numOfIC;
+
+  vec eigenvalues = zeros(size(Dt));
+  vec eigenvalues2 = zeros(size(Dt));
+
+  eigenvalues2 = Dt;
+
+  sort(eigenvalues2);
+
+  vec lowerColumns = zeros(size(Dt));
+
+  for (int i = 0; i < size(Dt); i++) eigenvalues(i) = eigenvalues2(size(Dt) - i - 1);
+
+  if (lastEig > maxLastEig) lastEig = maxLastEig;
+
+  if (lastEig < oldDimension) lowerLimitValue = (eigenvalues(lastEig - 1) + eigenvalues(lastEig)) / 2;
+  else lowerLimitValue = eigenvalues(oldDimension - 1) - 1;
+
+  for (int i = 0; i < size(Dt); i++) if (Dt(i) > lowerLimitValue) lowerColumns(i) = 1;
+
+  if (firstEig > 1) higherLimitValue = (eigenvalues(firstEig - 2) + eigenvalues(firstEig - 1)) / 2;
+  else higherLimitValue = eigenvalues(0) + 1;
+
+  vec higherColumns = zeros(size(Dt));
+  for (int i = 0; i < size(Dt); i++) if (Dt(i) < higherLimitValue) higherColumns(i) = 1;
+
+  vec selectedColumns = zeros(size(Dt));
+  for (int i = 0; i < size(Dt); i++) selectedColumns(i) = (lowerColumns(i) == 1 && higherColumns(i) == 1) ? 1 : 0;
+
+  selcol(Et, selectedColumns, Es);
+
+  int numTaken = 0;
+
+  for (int i = 0; i < size(selectedColumns); i++) if (selectedColumns(i) == 1) numTaken++;
+
+  Ds = zeros(numTaken);
+
+  numTaken = 0;
+
+  for (int i = 0; i < size(Dt); i++)
+    if (selectedColumns(i) == 1) {
+      Ds(numTaken) = Dt(i);
+      numTaken++;
+    }
+
+  return lastEig;
+
+}
+
+
+static void remmean(const mat &inVectors, mat & outVectors, vec & meanValue, const int numThreads)
+{
+
+  int vectorSize = inVectors.rows();
+  int numSamples = inVectors.cols();
+  int numChunks = fica_num_chunks(numSamples, numThreads);
+
+  outVectors.set_size(vectorSize, numSamples, false);
+  meanValue = zeros(vectorSize);
+
+  // Partial row sums per chunk, added up in chunk order
+  mat partialSums(vectorSize, numChunks);
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int c = 0; c < numChunks; c++) {
+    double *acc = partialSums._data() + c * vectorSize;
+    for (int i = 0; i < vectorSize; i++) acc[i] = 0.0;
+    for (int j = fica_chunk_begin(numSamples, numChunks, c); j < fica_chunk_begin(numSamples, numChunks, c + 1); j++) {
+      const double *x = inVectors._data() + j * vectorSize;
+      for (int i = 0; i < vectorSize; i++) acc[i] += x[i];
+    }
+  }
+
+  mat_view partialView(partialSums);
+  for (int c = 0; c < numChunks; c++) meanValue = lazy(meanValue) + partialView.get_col(c);
+  meanValue /= numSamples;
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int c = 0; c < numChunks; c++) {
+    for (int j = fica_chunk_begin(numSamples, numChunks, c); j < fica_chunk_begin(numSamples, numChunks, c + 1); j++) {
+      const double *x = inVectors._data() + j * vectorSize;
+      double *y = outVectors._data() + j * vectorSize;
+      for (int i = 0; i < vectorSize; i++) y[i] = x[i] - meanValue(i);
+    }
+  }
+
+}
+
+static void whitenv(const mat &vectors, const mat &E, const mat &D, mat & newVectors, mat & whiteningMatrix, mat & dewhiteningMatrix, const int numThreads)
+{
+
+  whitening_matrices(E, D, whiteningMatrix, dewhiteningMatrix);
+
+  fica_mult(whiteningMatrix, vectors, newVectors, numThreads);
+
+  return;
+
+}
+
+static void whitening_matrices(const mat &E, const mat &D, mat & whiteningMatrix, mat & dewhiteningMatrix)
+{
+
+  whiteningMatrix = zeros(E.cols(), E.rows());
+  dewhiteningMatrix = zeros(E.rows(), E.cols());
+
+  for (int i = 0; i < D.cols(); i++) {
+    whiteningMatrix.set_row(i, std::pow(std::sqrt(D(i, i)), -1)*E.get_col(i));
+    dewhiteningMatrix.set_col(i, std::sqrt(D(i, i))*E.get_col(i));
+  }
+
+}
+
+static mat orth(const mat &A)
+{
+
+  mat Q;
+  mat U, V;
+  vec S;
+  double eps = 2.2e-16;
+  double tol = 0.0;
+  int mmax = 0;
+  int r = 0;
+
+  svd(A, U, S, V);
+  // Only the first r <= A.cols() columns of U are kept, so U is not truncated
+  if (A.rows() > A.cols()) S = S(0, A.cols() - 1);
+
+  mmax = (A.rows() > A.cols()) ? A.rows() : A.cols();
+
+  tol = mmax * eps * max(S);
+
+  for (int i = 0; i < size(S); i++) if (S(i) > tol) r++;
+
+  Q = mat_view(U, 0, U.rows() - 1, 0, (r > 0) ? r - 1 : size(S) - 1);
+
+  return (Q);
+}
+
+static mat mpower(const mat &A, const double y)
+{
+
+  mat T = zeros(A.rows(), A.cols());
+  mat dd = zeros(A.rows(), A.cols());
+  vec d = zeros(A.rows());
+  vec dOut = zeros(A.rows());
+
+  eig_sym(A, d, T);
+
+  dOut = pow(d, y);
+
+  diag(dOut, dd);
+
+  mat_view Tv(T);
+  for (int i = 0; i < T.cols(); i++) T.set_col(i, T.get_col(i) / norm(Tv.get_col(i)));
+
+  return (T*dd*transpose(T));
+
+}
+
+// Symmetric decorrelation B = B * (B^T * B)^(-1/2). Up to FICA_SMALL_DIM
+// columns, the inverse square root is computed in place without going
+// through LAPACK and without any allocation besides the result.
+static void fica_decorrelate(mat &B)
+{
+
+  int n = B.cols();
+  if (n > FICA_SMALL_DIM) {
+    B = B * mpower(transpose(B) * B , -0.5);
+    return;
+  }
+
+  double M[FICA_SMALL_DIM * FICA_SMALL_DIM];
+  for (int j = 0; j < n; j++)
+    for (int i = 0; i <= j; i++) {
+      double acc = 0.0;
+      const double *bi = B._data() + i * B.rows();
+      const double *bj = B._data() + j * B.rows();
+      for (int k = 0; k < B.rows(); k++) acc += bi[k] * bj[k];
+      M[i + j * n] = M[j + i * n] = acc;
+    }
+
+  fica_inv_sqrt_small(n, M);
+
+  mat BM(B.rows(), n);
+  for (int j = 0; j < n; j++)
+    for (int i = 0; i < B.rows(); i++) {
+      double acc = 0.0;
+      for (int k = 0; k < n; k++) acc += B(i, k) * M[k + j * n];
+      BM(i, j) = acc;
+    }
+  B = BM;
+
+}
+
+// In-place inverse square root of the n x n symmetric matrix M (column-major,
+// n <= FICA_SMALL_DIM): closed form for n <= 2, cyclic Jacobi eigenvalue
+// sweeps otherwise.
+static void fica_inv_sqrt_small(const int n, double *M)
+{
+
+  if (n == 1) {
+    M[0] = 1.0 / std::sqrt(M[0]);
+    return;
+  }
+
+  if (n == 2) {
+    // sqrt(M) = (M + s*I) / t with s = sqrt(det(M)) and t = sqrt(tr(M) + 2*s),
+    // whose inverse is adj(M + s*I) / (s * t)
+    double a = M[0], b = M[1], c = M[3];
+    double s = std::sqrt(a * c - b * b);
+    double t = std::sqrt(a + c + 2 * s);
+    double f = 1.0 / (s * t);
+    M[0] = (c + s) * f;
+    M[1] = M[2] = -b * f;
+    M[3] = (a + s) * f;
+    return;
+  }
+
+  double V[FICA_SMALL_DIM * FICA_SMALL_DIM];
+  for (int j = 0; j < n; j++)
+    for (int i = 0; i < n; i++) V[i + j * n] = (i == j) ? 1.0 : 0.0;
+
+  for (int sweep = 0; sweep < 50; sweep++) {
+
+    double off = 0.0, diagonal = 0.0;
+    for (int j = 0; j < n; j++) {
+      diagonal += M[j + j * n] * M[j + j * n];
+      for (int i = 0; i < j; i++) off += M[i + j * n] * M[i + j * n];
+    }
+    if (off <= 1e-30 * diagonal) break;
+
+    for (int p = 0; p < n - 1; p++)
+      for (int q = p + 1; q < n; q++) {
+        double apq = M[p + q * n];
+        if (apq == 0.0) continue;
+        double theta = (M[q + q * n] - M[p + p * n]) / (2 * apq);
+        double t = ((theta >= 0) ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+        double c = 1.0 / std::sqrt(t * t + 1);
+        double sn = t * c;
+        // M = J^T * M * J and V = V * J for the rotation J in the (p, q) plane
+        for (int k = 0; k < n; k++) {
+          double mkp = M[k + p * n], mkq = M[k + q * n];
+          M[k + p * n] = c * mkp - sn * mkq;
+          M[k + q * n] = sn * mkp + c * mkq;
+        }
+        for (int k = 0; k < n; k++) {
+          double mpk = M[p + k * n], mqk = M[q + k * n];
+          M[p + k * n] = c * mpk - sn * mqk;
+          M[q + k * n] = sn * mpk + c * mqk;
+        }
+        for (int k = 0; k < n; k++) {
+          double vkp = V[k + p * n], vkq = V[k + q * n];
+          V[k + p * n] = c * vkp - sn * vkq;
+          V[k + q * n] = sn * vkp + c * vkq;
+        }
+      }
+
+  }
+
+  double d[FICA_SMALL_DIM];
+  for (int k = 0; k < n; k++) d[k] = 1.0 / std::sqrt(M[k + k * n]);
+
+  // M = V * diag(d) * V^T
+  for (int j = 0; j < n; j++)
+    for (int i = 0; i <= j; i++) {
+      double acc = 0.0;
+      for (int k = 0; k < n; k++) acc += V[i + k * n] * d[k] * V[j + k * n];
+      M[i + j * n] = M[j + i * n] = acc;
+    }
+
+}
+
+// Number of sample chunks used to spread a pass over the data on numThreads
+// threads. Chunks are kept large enough to amortize the thread start-up.
+static int fica_num_chunks(const int numSamples, const int numThreads)
+{
+  int numChunks = numSamples / 1024;
+  if (numChunks > numThreads) numChunks = numThreads;
+  if (numChunks < 1) numChunks = 1;
+  return numChunks;
+}
+
+// First sample of chunk c when numSamples are split into numChunks chunks
+static int fica_chunk_begin(const int numSamples, const int numChunks, const int c)
+{
+  return static_cast<int>((static_cast<double>(numSamples) * c) / numChunks);
+}
+
+// Scatter matrix X * transpose(X), accumulated over chunks of columns
+static mat fica_scatter(const mat &X, const int numThreads)
+{
+
+  int vectorSize = X.rows();
+  int numSamples = X.cols();
+  int numChunks = fica_num_chunks(numSamples, numThreads);
+
+  Array<mat> partialScatter(numChunks);
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int c = 0; c < numChunks; c++) {
+    int tBegin = fica_chunk_begin(numSamples, numChunks, c);
+    int n = fica_chunk_begin(numSamples, numChunks, c + 1) - tBegin;
+    mat &R = partialScatter(c);
+    R.set_size(vectorSize, vectorSize, false);
+#if defined(HAVE_BLAS)
+    double alpha = 1.0, beta = 0.0;
+    char transA = 'n', transB = 't';
+    blas::dgemm_(&transA, &transB, &vectorSize, &vectorSize, &n, &alpha,
+                 X._data() + tBegin * vectorSize, &vectorSize,
+                 X._data() + tBegin * vectorSize, &vectorSize, &beta,
+                 R._data(), &vectorSize);
+#else
+    native_blas::dgemm('n', 't', vectorSize, vectorSize, n, 1.0,
+                       X._data() + tBegin * vectorSize, vectorSize,
+                       X._data() + tBegin * vectorSize, vectorSize, 0.0,
+                       R._data(), vectorSize);
+#endif
+  }
+
+  mat scatter = partialScatter(0);
+  for (int c = 1; c < numChunks; c++) scatter += partialScatter(c);
+
+  return scatter;
+
+}
+
+// Covariance matrix of the rows of X (variables) over its columns
+// (observations), normalized by the number of observations. Same result as
+// cov(transpose(X)) without forming the transpose.
+static mat fica_cov(const mat &X, const int numThreads)
+{
+
+  int vectorSize = X.rows();
+  int numSamples = X.cols();
+
+  vec meanValue = zeros(vectorSize);
+  for (int j = 0; j < numSamples; j++) {
+    const double *x = X._data() + j * vectorSize;
+    for (int i = 0; i < vectorSize; i++) meanValue(i) += x[i];
+  }
+  meanValue /= numSamples;
+
+  mat covarianceMatrix = fica_scatter(X, numThreads);
+
+  covarianceMatrix /= numSamples;
+  covarianceMatrix -= outer_product(meanValue, meanValue);
+
+  return covarianceMatrix;
+
+}
+
+// Mean and covariance of all the samples of a stream, in a single pass.
+// The samples are shifted by the mean of the first chunk before being
+// accumulated, which avoids cancellation for signals with a large offset.
+// Returns the number of samples read.
+static int fica_stream_moments(ICA_Reader &reader, const int chunkSize, const int numThreads, vec &meanValue, mat &covarianceMatrix)
+{
+
+  int vectorSize = reader.channels();
+  int numSamples = 0;
+  mat chunk;
+  vec shift;
+  vec sum1 = zeros(vectorSize);
+  mat sum2 = zeros(vectorSize, vectorSize);
+
+  reader.rewind();
+
+  int n;
+  while ((n = reader.read(chunk, chunkSize)) > 0) {
+
+    if (numSamples == 0) shift = sum(chunk, 2) / n;
+
+    for (int j = 0; j < n; j++) {
+      double *x = chunk._data() + j * vectorSize;
+      for (int i = 0; i < vectorSize; i++) {
+        x[i] -= shift(i);
+        sum1(i) += x[i];
+      }
+    }
+    sum2 += fica_scatter(chunk, numThreads);
+    numSamples += n;
+
+  }
+
+  if (numSamples == 0) {
+    meanValue = zeros(vectorSize);
+    covarianceMatrix = zeros(vectorSize, vectorSize);
+    return 0;
+  }
+
+  vec delta = sum1 / numSamples;
+  meanValue = shift + delta;
+  covarianceMatrix = sum2 / numSamples - outer_product(delta, delta);
+
+  return numSamples;
+
+}
+
+// Mean of all the samples. Returns their number.
+static int fica_stream_mean(Fica_Blocks &signals, vec &meanValue)
+{
+
+  int vectorSize = signals.channels();
+  int numSamples = 0;
+  meanValue = zeros(vectorSize);
+
+  signals.rewind();
+
+  int n;
+  const double *X;
+  while ((X = signals.next(n)) != 0) {
+    for (int j = 0; j < n; j++) {
+      const double *x = X + j * vectorSize;
+      for (int i = 0; i < vectorSize; i++) meanValue(i) += x[i];
+    }
+    numSamples += n;
+  }
+
+  if (numSamples > 0) meanValue /= numSamples;
+
+  return numSamples;
+
+}
+
+// Xc * S, Xc being the centered signals and S a random matrix with a single
+// nonzero of +-1 per row: each centered sample is added to or subtracted
+// from one of the width columns. Its span is close to that of the leading
+// eigenvectors of the covariance, for the cost of one pass of additions.
+static mat fica_count_sketch(Fica_Blocks &signals, const vec &meanValue, const int width)
+{
+
+  int vectorSize = signals.channels();
+  mat sketch = zeros(vectorSize, width);
+  // Sums of the signs of each column, to center the sketch at the end
+  vec signs = zeros(width);
+  uint32_t state = FICA_SAMPLING_SEED ^ 0x9e3779b9u;
+
+  signals.rewind();
+
+  int n;
+  const double *X;
+  while ((X = signals.next(n)) != 0) {
+    for (int j = 0; j < n; j++) {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      int c = static_cast<int>((state >> 1) % static_cast<uint32_t>(width));
+      double *y = sketch._data() + c * vectorSize;
+      const double *x = X + j * vectorSize;
+      if (state & 1) {
+        for (int i = 0; i < vectorSize; i++) y[i] += x[i];
+        signs(c) += 1.0;
+      }
+      else {
+        for (int i = 0; i < vectorSize; i++) y[i] -= x[i];
+        signs(c) -= 1.0;
+      }
+    }
+  }
+
+  sketch -= outer_product(meanValue, signs);
+  return sketch;
+
+}
+
+// C * Q, C being the covariance of the signals, computed in one pass as the
+// sum over the blocks X of Xc * (transpose(Xc) * Q) without forming C. The
+// blocks are centered through the products: transpose(Xc) * Q = transpose(X)
+// * Q - 1 * transpose(mean) * Q and Xc * Z = X * Z - mean * transpose(1) * Z.
+static mat fica_cov_mult(Fica_Blocks &signals, const vec &meanValue, const int numSamples, const int numThreads, const mat &Q)
+{
+
+  int vectorSize = signals.channels();
+  int width = Q.cols();
+  vec meanQ = Q.transpose() * meanValue;
+  mat Z;
+  mat product = zeros(vectorSize, width);
+
+  signals.rewind();
+
+  int n;
+  const double *X;
+  while ((X = signals.next(n)) != 0) {
+
+    int numChunks = fica_num_chunks(n, numThreads);
+    Array<mat> partialProduct(numChunks);
+    Z.set_size(n, width, false);
+
+#ifdef _OPENMP
+    #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+    for (int c = 0; c < numChunks; c++) {
+      int tBegin = fica_chunk_begin(n, numChunks, c);
+      int m = fica_chunk_begin(n, numChunks, c + 1) - tBegin;
+      const double *Xc = X + tBegin * vectorSize;
+      double *Zc = Z._data() + tBegin;
+      fica_gemm('t', 'n', m, width, vectorSize, Xc, vectorSize, Q._data(), vectorSize, 0.0, Zc, n);
+      vec sumZ = zeros(width);
+      for (int k = 0; k < width; k++) {
+        double *z = Zc + k * n;
+        for (int j = 0; j < m; j++) {
+          z[j] -= meanQ(k);
+          sumZ(k) += z[j];
+        }
+      }
+      mat &P = partialProduct(c);
+      P.set_size(vectorSize, width, false);
+      fica_gemm('n', 'n', vectorSize, width, m, Xc, vectorSize, Zc, n, 0.0, P._data(), vectorSize);
+      P -= outer_product(meanValue, sumZ);
+    }
+
+    for (int c = 0; c < numChunks; c++) product += partialProduct(c);
+
+  }
+
+  return product / numSamples;
+
+}
+
+// out = A * X, with the columns of X split over numThreads threads
+static void fica_mult(const mat &A, const mat &X, mat &out, const int numThreads)
+{
+
+  int numSamples = X.cols();
+  int numChunks = fica_num_chunks(numSamples, numThreads);
+
+  if (numChunks == 1) {
+    out = A * X;
+    return;
+  }
+
+  int outRows = A.rows();
+  int innerSize = A.cols();
+  out.set_size(outRows, numSamples, false);
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int c = 0; c < numChunks; c++) {
+    int tBegin = fica_chunk_begin(numSamples, numChunks, c);
+    int n = fica_chunk_begin(numSamples, numChunks, c + 1) - tBegin;
+#if defined(HAVE_BLAS)
+    double alpha = 1.0, beta = 0.0;
+    char trans = 'n';
+    blas::dgemm_(&trans, &trans, &outRows, &n, &innerSize, &alpha,
+                 A._data(), &outRows, X._data() + tBegin * innerSize,
+                 &innerSize, &beta, out._data() + tBegin * outRows, &outRows);
+#else
+    native_blas::dgemm('n', 'n', outRows, n, innerSize, 1.0, A._data(), outRows,
+                       X._data() + tBegin * innerSize, innerSize, 0.0,
+                       out._data() + tBegin * outRows, outRows);
+#endif
+  }
+
+}
+
+// out = whiteningMatrix * (X - meanValue) stored in single precision. The
+// products are formed in double precision one cache-sized block at a time,
+// so that no double precision copy of the whole signal is made.
+static void fica_whiten_float(const mat &X, const vec &meanValue, const mat &whiteningMatrix, Mat<float> &out, const int numThreads)
+{
+
+  int vectorSize = X.rows();
+  int numSamples = X.cols();
+  int Dim = whiteningMatrix.rows();
+  int numChunks = fica_num_chunks(numSamples, numThreads);
+  vec whiteMean = whiteningMatrix * meanValue;
+
+  int blockSize = FICA_BLOCK_ELEMS / (vectorSize + Dim);
+  if (blockSize < 16) blockSize = 16;
+
+  out.set_size(Dim, numSamples, false);
+  Array<mat> blocks(numChunks);
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int c = 0; c < numChunks; c++) {
+    mat &Wb = blocks(c);
+    Wb.set_size(Dim, blockSize, false);
+    int tEnd = fica_chunk_begin(numSamples, numChunks, c + 1);
+    for (int t0 = fica_chunk_begin(numSamples, numChunks, c); t0 < tEnd; t0 += blockSize) {
+      int n = (tEnd - t0 < blockSize) ? tEnd - t0 : blockSize;
+      fica_gemm('n', 'n', Dim, n, vectorSize, whiteningMatrix._data(), Dim,
+                X._data() + t0 * vectorSize, vectorSize, 0.0, Wb._data(), Dim);
+      for (int t = 0; t < n; t++) {
+        const double *w = Wb._data() + t * Dim;
+        float *y = out._data() + (t0 + t) * Dim;
+        for (int i = 0; i < Dim; i++) y[i] = static_cast<float>(w[i] - whiteMean(i));
+      }
+    }
+  }
+
+}
+
+// Merge a block of samples into running moments whose weight is first
+// multiplied by decay. The block is centered on its own mean before its
+// scatter matrix is computed, and the two sets of moments are combined with
+// the pairwise update of Chan et al., which avoids the cancellation of
+// E[xx^T] - mu mu^T when the mean is large.
+static void fica_update_moments(const mat &block, const double decay, const int numThreads, double &weight, vec &meanValue, mat &covarianceMatrix)
+{
+
+  int n = block.cols();
+  vec blockMean = zeros(block.rows());
+  for (int t = 0; t < n; t++)
+    for (int i = 0; i < block.rows(); i++)
+      blockMean(i) += block(i, t);
+  blockMean /= n;
+
+  mat centered(block);
+  for (int t = 0; t < n; t++)
+    for (int i = 0; i < block.rows(); i++)
+      centered(i, t) -= blockMean(i);
+
+  double w0 = decay * weight;
+  double wt = w0 + n;
+  vec delta = blockMean - meanValue;
+
+  meanValue += (n / wt) * delta;
+  covarianceMatrix = (w0 * covarianceMatrix + fica_scatter(centered, numThreads)
+                      + (w0 * n / wt) * outer_product(delta, delta)) / wt;
+  weight = wt;
+
+}
+
+#if !defined(HAVE_BLAS)
+// Reference implementation of the single precision fica_gemm() used
+// without BLAS
+template<class T>
+static void fica_gemm_ref(const char transA, const char transB, const int m, const int n, const int k, const T *A, const int ldA, const T *B, const int ldB, const T beta, T *C, const int ldC)
+{
+  for (int j = 0; j < n; j++) {
+    T *c = C + j * ldC;
+    for (int i = 0; i < m; i++) c[i] = (beta == T(0)) ? T(0) : beta * c[i];
+    for (int l = 0; l < k; l++) {
+      T b = (transB == 'n') ? B[l + j * ldB] : B[j + l * ldB];
+      if (transA == 'n') {
+        const T *a = A + l * ldA;
+        for (int i = 0; i < m; i++) c[i] += a[i] * b;
+      }
+      else {
+        for (int i = 0; i < m; i++) c[i] += A[l + i * ldA] * b;
+      }
+    }
+  }
+}
+#endif
 
-} // namespace itpp
+// C = op(A) * op(B) + beta * C for column-major matrices, op being the
+// identity or the transposition as selected by 'n' or 't'
+static void fica_gemm(const char transA, const char transB, const int m, const int n, const int k, const double *A, const int ldA, const double *B, const int ldB, const double beta, double *C, const int ldC)
+{
+#if defined(HAVE_BLAS)
+  double alpha = 1.0;
+  blas::dgemm_(&transA, &transB, &m, &n, &k, &alpha, A, &ldA, B, &ldB, &beta, C, &ldC);
+#else
+  native_blas::dgemm(transA, transB, m, n, k, 1.0, A, ldA, B, ldB, beta, C, ldC);
+#endif
+}
 
+static void fica_gemm(const char transA, const char transB, const int m, const int n, const int k, const float *A, const int ldA, const float *B, const int ldB, const float beta, float *C, const int ldC)
+{
+#if defined(HAVE_BLAS)
+  float alpha = 1.0f;
+  blas::sgemm_(&transA, &transB, &m, &n, &k, &alpha, A, &ldA, B, &ldB, &beta, C, &ldC);
+#else
+  fica_gemm_ref(transA, transB, m, n, k, A, ldA, B, ldB, beta, C, ldC);
+#endif
+}
 
-static void selcol(const mat oldMatrix, const vec maskVector, mat & newMatrix)
+// B in the precision of the samples
+static const double *fica_cast(const mat &B, mat &)
 {
+  return B._data();
+}
 
-  int numTaken = 0;
+static const float *fica_cast(const mat &B, Mat<float> &out)
+{
+  out.set_size(B.rows(), B.cols(), false);
+  for (int i = 0; i < B.size(); i++) out._data()[i] = static_cast<float>(B._data()[i]);
+  return out._data();
+}
 
-  for (int i = 0; i < size(maskVector); i++) if (maskVector(i) == 1) numTaken++;
+// G += Xb * Y(0:n-1, :). Single precision products are formed one block at a
+// time in Gb and accumulated in double precision, so that the rounding error
+// does not grow with the number of samples.
+static void fica_add_product(const int vectorSize, const int numOfIC, const int n, const double *Xb, const double *Y, const int ldY, mat &, mat &G)
+{
+  fica_gemm('n', 'n', vectorSize, numOfIC, n, Xb, vectorSize, Y, ldY, 1.0, G._data(), vectorSize);
+}
 
-  newMatrix = zeros(oldMatrix.rows(), numTaken);
+static void fica_add_product(const int vectorSize, const int numOfIC, const int n, const float *Xb, const float *Y, const int ldY, Mat<float> &Gb, mat &G)
+{
+  Gb.set_size(vectorSize, numOfIC, false);
+  fica_gemm('n', 'n', vectorSize, numOfIC, n, Xb, vectorSize, Y, ldY, 0.0f, Gb._data(), vectorSize);
+  for (int i = 0; i < G.size(); i++) G._data()[i] += Gb._data()[i];
+}
 
-  numTaken = 0;
+// u <- tanh(u) and u <- exp(u) in place. Double precision samples use the
+// vectorized kernels of vmath.h, over chunks of fica_nonlin_chunk samples.
+static const int fica_nonlin_chunk = 256;
 
-  for (int i = 0; i < size(maskVector); i++) {
+static void fica_tanh(double *u, const int n) { vmath_tanh(u, u, n); }
+static void fica_tanh(float *u, const int n) { for (int k = 0; k < n; k++) u[k] = std::tanh(u[k]); }
+static void fica_exp(double *u, const int n) { vmath_exp(u, u, n); }
+static void fica_exp(float *u, const int n) { for (int k = 0; k < n; k++) u[k] = std::exp(u[k]); }
 
-    if (maskVector(i) == 1) {
+// y <- g(y) in place over n samples, adding the sums of y .* g(y) to beta and
+// of g'(y) to dg
+template<class T>
+static void fica_nonlin_apply(T *y, const int n, const int g, const double a1, const double a2, double &beta, double &dg)
+{
 
-      newMatrix.set_col(numTaken, oldMatrix.get_col(i));
-      numTaken++;
+  switch (g) {
 
+  case FICA_NONLIN_POW3 : {
+    for (int t = 0; t < n; t++) {
+      T u2 = y[t] * y[t];
+      beta += u2 * u2;
+      y[t] *= u2;
+    }
+    break;
+  }
+  case FICA_NONLIN_TANH : {
+    T ta1 = static_cast<T>(a1);
+    T u[fica_nonlin_chunk];
+    for (int t0 = 0; t0 < n; t0 += fica_nonlin_chunk) {
+      int m = (n - t0 < fica_nonlin_chunk) ? n - t0 : fica_nonlin_chunk;
+      for (int k = 0; k < m; k++)
+        u[k] = ta1 * y[t0 + k];
+      fica_tanh(u, m);
+      for (int k = 0; k < m; k++) {
+        T hypTan = u[k];
+        beta += y[t0 + k] * hypTan;
+        dg += 1 - hypTan * hypTan;
+        y[t0 + k] = hypTan;
+      }
+    }
+    break;
+  }
+  case FICA_NONLIN_GAUSS : {
+    T ta2 = static_cast<T>(a2);
+    T u[fica_nonlin_chunk];
+    for (int t0 = 0; t0 < n; t0 += fica_nonlin_chunk) {
+      int m = (n - t0 < fica_nonlin_chunk) ? n - t0 : fica_nonlin_chunk;
+      for (int k = 0; k < m; k++) {
+        T u2 = y[t0 + k] * y[t0 + k];
+        u[k] = -ta2 * u2 / 2;
+      }
+      fica_exp(u, m);
+      for (int k = 0; k < m; k++) {
+        T u2 = y[t0 + k] * y[t0 + k];
+        T ex = u[k];
+        beta += u2 * ex;
+        dg += (1 - ta2 * u2) * ex;
+        y[t0 + k] *= ex;
+      }
+    }
+    break;
+  }
+  case FICA_NONLIN_SKEW : {
+    for (int t = 0; t < n; t++) {
+      T u2 = y[t] * y[t];
+      beta += u2 * y[t];
+      y[t] = u2;
     }
+    break;
   }
 
-  return;
+  } // SWITCH g
 
 }
 
-static int pcamat(const mat vectors, const int numOfIC, int firstEig, int lastEig, mat & Es, vec & Ds)
+// Fused evaluation of G = X * g(transpose(X) * B) over the samples
+// [tBegin, tEnd) of X. Samples are processed in blocks so that the
+// projections Y = transpose(X) * B never exist for the whole signal; Y and Gb
+// are caller-owned scratch buffers reused from one round to the next. Beta
+// receives the column sums of Y .* g(Y) and dG the column sums of the
+// derivative term g'(Y). G, Beta and dG are always accumulated in double
+// precision.
+template<class T>
+static void fica_nonlin_block(const Mat<T> &X, const T *B, const int numOfIC, const int g, const double a1, const double a2, const int tBegin, const int tEnd, Mat<T> &Y, Mat<T> &Gb, mat &G, vec &Beta, vec &dG)
 {
 
-  mat Et;
-  vec Dt;
-  cmat Ec;
-  cvec Dc;
-  double lowerLimitValue = 0.0,
-                           higherLimitValue = 0.0;
-
-  int oldDimension = vectors.rows();
-
-  mat covarianceMatrix = cov(transpose(vectors), 0);
-
-  eig_sym(covarianceMatrix, Dt, Et);
-
-  int maxLastEig = 0;
-
-  // Compute rank
-  for (int i = 0; i < Dt.length(); i++) if (Dt(i) > FICA_TOL) maxLastEig++;
-  if (maxLastEig < 1) return 0;
+  int vectorSize = X.rows();
+  int numSamples = tEnd - tBegin;
+
+  // Keep one block of X and of Y in cache at the same time
+  int blockSize = FICA_BLOCK_ELEMS / (vectorSize + numOfIC);
+  if (blockSize < 16) blockSize = 16;
+  if (blockSize > numSamples) blockSize = numSamples;
+  if (blockSize < 1) blockSize = 1;
+
+  Y.set_size(blockSize, numOfIC, false);
+  G.set_size(vectorSize, numOfIC, false);
+  Beta.set_size(numOfIC, false);
+  dG.set_size(numOfIC, false);
+  G.zeros();
+  Beta.zeros();
+  dG.zeros();
+
+  for (int t0 = tBegin; t0 < tEnd; t0 += blockSize) {
+
+    int n = (tEnd - t0 < blockSize) ? tEnd - t0 : blockSize;
+    const T *Xb = X._data() + t0 * vectorSize;
+
+    // Y(0:n-1, :) = transpose(Xb) * B
+    fica_gemm('t', 'n', n, numOfIC, vectorSize, Xb, vectorSize, B, vectorSize, T(0), Y._data(), blockSize);
+
+    // Y <- g(Y), in place, together with the column sums
+    for (int j = 0; j < numOfIC; j++) {
+      double beta = 0.0, dg = 0.0;
+      fica_nonlin_apply(Y._data() + j * blockSize, n, g, a1, a2, beta, dg);
+      Beta(j) += beta;
+      dG(j) += dg;
+    }
 
-  // Force numOfIC components
-  if (maxLastEig > numOfIC) maxLastEig = numOfIC;
+    // G += Xb * Y(0:n-1, :)
+    fica_add_product(vectorSize, numOfIC, n, Xb, Y._data(), blockSize, Gb, G);
 
-  vec eigenvalues = zeros(size(Dt));
-  vec eigenvalues2 = zeros(size(Dt));
+  }
 
-  eigenvalues2 = Dt;
+}
 
-  sort(eigenvalues2);
+// Fused non-linearity kernel of the symmetric approach, see
+// fica_nonlin_block(). The samples are split into numThreads contiguous
+// chunks evaluated concurrently; the partial results are summed in chunk
+// order so that the outcome does not depend on thread scheduling.
+template<class T>
+static void fica_nonlin_symm(const Mat<T> &X, const mat &B, const int g, const double a1, const double a2, const int numThreads, Fica_Workspace<T> &ws, mat &G, vec &Beta, vec &dG)
+{
 
-  vec lowerColumns = zeros(size(Dt));
+  int numSamples = X.cols();
+  int numChunks = fica_num_chunks(numSamples, numThreads);
+
+  ws.set_size(numChunks);
+
+  Mat<T> Bt;
+  const T *Bp = fica_cast(B, Bt);
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(numThreads) schedule(static)
+#endif
+  for (int c = 0; c < numChunks; c++)
+    fica_nonlin_block(X, Bp, B.cols(), g, a1, a2, fica_chunk_begin(numSamples, numChunks, c), fica_chunk_begin(numSamples, numChunks, c + 1), ws.Y(c), ws.Gb(c), ws.G(c), ws.Beta(c), ws.dG(c));
+
+  G = ws.G(0);
+  Beta = ws.Beta(0);
+  dG = ws.dG(0);
+  for (int c = 1; c < numChunks; c++) {
+    G += ws.G(c);
+    Beta += ws.Beta(c);
+    dG += ws.dG(c);
+  }
 
-  for (int i = 0; i < size(Dt); i++) eigenvalues(i) = eigenvalues2(size(Dt) - i - 1);
+  // Scale the derivative term as in the reference implementation
+  if (g == FICA_NONLIN_POW3) dG = 3.0 * numSamples;
+  else if (g == FICA_NONLIN_TANH) dG *= a1;
 
-  if (lastEig > maxLastEig) lastEig = maxLastEig;
+}
 
-  if (lastEig < oldDimension) lowerLimitValue = (eigenvalues(lastEig - 1) + eigenvalues(lastEig)) / 2;
-  else lowerLimitValue = eigenvalues(oldDimension - 1) - 1;
+void Fica_Sampler::setup(int in_mode, unsigned int seed, double in_growth)
+{
+  mode = in_mode;
+  growth = in_growth;
+  scale = 1.0;
+  // xorshift32 needs a nonzero state
+  state = static_cast<uint32_t>(seed) ^ 0x9e3779b9u;
+  if (state == 0) state = 1;
+}
 
-  for (int i = 0; i < size(Dt); i++) if (Dt(i) > lowerLimitValue) lowerColumns(i) = 1;
+double Fica_Sampler::draw()
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state * (1.0 / 4294967296.0);
+}
 
-  if (firstEig > 1) higherLimitValue = (eigenvalues(firstEig - 2) + eigenvalues(firstEig - 1)) / 2;
-  else higherLimitValue = eigenvalues(0) + 1;
+double Fica_Sampler::next_round(double sampleSize)
+{
+  double fraction = sampleSize * scale;
+  if (fraction >= 1.0) return 1.0;
+  scale *= growth;
+  return fraction;
+}
 
-  vec higherColumns = zeros(size(Dt));
-  for (int i = 0; i < size(Dt); i++) if (Dt(i) < higherLimitValue) higherColumns(i) = 1;
+void Fica_Sampler::select(int n, double fraction)
+{
+  begins.clear();
+  lengths.clear();
+
+  if (mode == FICA_SAMPLING_RANDOM) {
+    // Every sample with probability fraction, in runs of consecutive samples
+    for (int i = 0; i < n; i++) {
+      if (draw() >= fraction) continue;
+      if (!begins.empty() && begins.back() + lengths.back() == i) lengths.back()++;
+      else {
+        begins.push_back(i);
+        lengths.push_back(1);
+      }
+    }
+  }
+  else {
+    // One block of FICA_SAMPLING_BLOCK samples per stratum of the signal,
+    // either at a random position within each stratum or at the same random
+    // offset in all of them
+    double stratum = FICA_SAMPLING_BLOCK / fraction;
+    int numStrata = static_cast<int>(std::ceil(n / stratum));
+    double offset = draw();
+    for (int k = 0; k < numStrata; k++) {
+      int first = static_cast<int>(k * stratum);
+      int last = static_cast<int>((k + 1) * stratum);
+      if (last > n) last = n;
+      int len = (last - first < FICA_SAMPLING_BLOCK) ? last - first : FICA_SAMPLING_BLOCK;
+      if (len <= 0) continue;
+      double u = (mode == FICA_SAMPLING_STRATIFIED) ? draw() : offset;
+      begins.push_back(first + static_cast<int>(u * (last - first - len + 1)));
+      lengths.push_back(len);
+    }
+  }
 
-  vec selectedColumns = zeros(size(Dt));
-  for (int i = 0; i < size(Dt); i++) selectedColumns(i) = (lowerColumns(i) == 1 && higherColumns(i) == 1) ? 1 : 0;
+  if (begins.empty() && n > 0) {
+    begins.push_back(static_cast<int>(draw() * n));
+    lengths.push_back(1);
+  }
+}
 
-  selcol(Et, selectedColumns, Es);
+template<class T>
+int Fica_Sampler::gather(const Mat<T> &X, double fraction, Mat<T> &Xsub)
+{
+  select(X.cols(), fraction);
+
+  int n = 0;
+  for (size_t b = 0; b < lengths.size(); b++) n += lengths[b];
+
+  // Blocks of consecutive samples are contiguous in X
+  int rows = X.rows();
+  Xsub.set_size(rows, n, false);
+  T *dst = Xsub._data();
+  for (size_t b = 0; b < begins.size(); b++) {
+    const T *src = X._data() + begins[b] * rows;
+    int len = lengths[b] * rows;
+    for (int i = 0; i < len; i++) dst[i] = src[i];
+    dst += len;
+  }
 
-  int numTaken = 0;
+  return n;
+}
 
-  for (int i = 0; i < size(selectedColumns); i++) if (selectedColumns(i) == 1) numTaken++;
+int Fica_Mat_Data::nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG)
+{
+  double fraction = (sampleSize < 1.0) ? sampler.next_round(sampleSize) : 1.0;
+  if (fraction >= 1.0) {
+    fica_nonlin_symm(X, B, g, a1, a2, numThreads, ws, G, Beta, dG);
+    return X.cols();
+  }
+  int n = sampler.gather(X, fraction, Xsub);
+  fica_nonlin_symm(Xsub, B, g, a1, a2, numThreads, ws, G, Beta, dG);
+  return n;
+}
 
-  Ds = zeros(numTaken);
+int Fica_Float_Data::nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG)
+{
+  double fraction = (sampleSize < 1.0) ? sampler.next_round(sampleSize) : 1.0;
+  if (fraction >= 1.0) {
+    fica_nonlin_symm(X, B, g, a1, a2, numThreads, ws, G, Beta, dG);
+    return X.cols();
+  }
+  int n = sampler.gather(X, fraction, Xsub);
+  fica_nonlin_symm(Xsub, B, g, a1, a2, numThreads, ws, G, Beta, dG);
+  return n;
+}
 
-  numTaken = 0;
+void Fica_Blocks::rewind()
+{
+  if (X) pos = 0;
+  else reader.rewind();
+}
 
-  for (int i = 0; i < size(Dt); i++)
-    if (selectedColumns(i) == 1) {
-      Ds(numTaken) = Dt(i);
-      numTaken++;
-    }
+const double *Fica_Blocks::next(int &n)
+{
+  if (X) {
+    n = X->cols() - pos;
+    if (n > chunkSize) n = chunkSize;
+    if (n <= 0) return 0;
+    const double *block = X->_data() + pos * X->rows();
+    pos += n;
+    return block;
+  }
+  n = reader.read(chunk, chunkSize);
+  return (n > 0) ? chunk._data() : 0;
+}
 
-  return lastEig;
+int Fica_Mat_Reader::read(mat &chunk, int n)
+{
+  if (n > X.cols() - pos) n = X.cols() - pos;
+  if (n <= 0) {
+    chunk.set_size(X.rows(), 0);
+    return 0;
+  }
+  chunk = X.get_cols(pos, pos + n - 1);
+  pos += n;
+  return n;
+}
 
+Fica_Monitor::Fica_Monitor(Fast_ICA_Stats &in_stats, Fast_ICA_Callback in_callback, void *in_userData)
+    : refinement(false), stats(in_stats), callback(in_callback),
+      userData(in_userData), last(0.0), roundPhase(-1), componentBase(0)
+{
+  stats.reset();
+  timer.start();
 }
 
+void Fica_Monitor::emit(int phase, int component, int round, double minAbsCos, int nonlinearity, double mu, double now)
+{
+  if (!callback) return;
+  Fast_ICA_Event event;
+  event.phase = phase;
+  event.component = component;
+  event.round = round;
+  event.min_abs_cos = minAbsCos;
+  event.nonlinearity = nonlinearity;
+  event.mu = mu;
+  event.time = now;
+  callback(event, userData);
+}
 
-static void remmean(mat inVectors, mat & outVectors, vec & meanValue)
+void Fica_Monitor::mark(int phase)
 {
+  double now = timer.get_time();
+  stats.phase_time(phase) += now - last;
+  last = now;
+  emit(phase, -1, -1, 0.0, 0, 0.0, now);
+}
 
-  outVectors = zeros(inVectors.rows(), inVectors.cols());
-  meanValue = zeros(inVectors.rows());
+void Fica_Monitor::round(int phase, int component, double minAbsCos, int nonlinearity, double mu)
+{
+  double now = timer.get_time();
+  if (roundPhase >= 0) stats.phase_time(roundPhase) += now - last;
+  last = now;
+
+  if (refinement) phase = FICA_PHASE_REFINEMENT;
+  int c = componentBase + ((component < 0) ? 0 : component);
+  if (c >= static_cast<int>(componentRounds.size())) {
+    componentRounds.resize(c + 1, 0);
+    lastNonlinearity.resize(c + 1, 0);
+  }
+  if (componentRounds[c] == 0)
+    lastNonlinearity[c] = nonlinearity;
+  else if (nonlinearity != lastNonlinearity[c]) {
+    switches.push_back(static_cast<int>(trace.size()));
+    switches.push_back(component);
+    switches.push_back(lastNonlinearity[c]);
+    switches.push_back(nonlinearity);
+    lastNonlinearity[c] = nonlinearity;
+  }
 
-  for (int i = 0; i < inVectors.rows(); i++) {
+  emit(phase, component, componentRounds[c], minAbsCos, nonlinearity, mu, now);
 
-    meanValue(i) = mean(inVectors.get_row(i));
+  componentRounds[c]++;
+  stats.phase_rounds(phase)++;
+  trace.push_back(minAbsCos);
+  roundPhase = phase;
+}
 
-    for (int j = 0; j < inVectors.cols(); j++) outVectors(i, j) = inVectors(i, j) - meanValue(i);
+void Fica_Monitor::end_rounds()
+{
+  if (roundPhase < 0) return;
+  double now = timer.get_time();
+  stats.phase_time(roundPhase) += now - last;
+  last = now;
+  roundPhase = -1;
+  // The refinement restarts the components
+  componentBase = static_cast<int>(componentRounds.size());
+}
 
-  }
+void Fica_Monitor::finish()
+{
+  end_rounds();
+  stats.total_time = timer.stop();
+
+  stats.min_abs_cos.set_size(static_cast<int>(trace.size()));
+  for (int i = 0; i < stats.min_abs_cos.size(); i++) stats.min_abs_cos(i) = trace[i];
+  stats.component_rounds.set_size(static_cast<int>(componentRounds.size()));
+  for (int i = 0; i < stats.component_rounds.size(); i++) stats.component_rounds(i) = componentRounds[i];
+  stats.nonlin_switches.set_size(static_cast<int>(switches.size()) / 4, 4);
+  for (int i = 0; i < stats.nonlin_switches.rows(); i++)
+    for (int j = 0; j < 4; j++) stats.nonlin_switches(i, j) = switches[4 * i + j];
+}
 
+Fica_Stream_Data::Fica_Stream_Data(ICA_Reader &in_reader, const vec &meanValue, const mat &in_whiteningMatrix, int in_numSamples, int in_chunkSize, int in_numThreads)
+    : reader(in_reader), whiteningMatrix(in_whiteningMatrix),
+      whiteMean(in_whiteningMatrix * meanValue), numSamples(in_numSamples),
+      chunkSize(in_chunkSize), numThreads(in_numThreads)
+{
 }
 
-static void whitenv(const mat vectors, const mat E, const mat D, mat & newVectors, mat & whiteningMatrix, mat & dewhiteningMatrix)
+int Fica_Stream_Data::nonlin(const mat &B, int g, double a1, double a2, double sampleSize, mat &G, vec &Beta, vec &dG)
 {
+  int used = 0;
+  double fraction = (sampleSize < 1.0) ? sampler.next_round(sampleSize) : 1.0;
+  G = zeros(B.rows(), B.cols());
+  Beta = zeros(B.cols());
+  dG = zeros(B.cols());
+
+  reader.rewind();
+  while (reader.read(chunk, chunkSize) > 0) {
+
+    // whiteningMatrix * (chunk - mean)
+    fica_mult(whiteningMatrix, chunk, whiteChunk, numThreads);
+    for (int j = 0; j < whiteChunk.cols(); j++)
+      for (int i = 0; i < whiteChunk.rows(); i++)
+        whiteChunk(i, j) -= whiteMean(i);
+
+    const mat *Xc = &whiteChunk;
+    if (fraction < 1.0) {
+      sampler.gather(whiteChunk, fraction, subChunk);
+      Xc = &subChunk;
+    }
 
-  whiteningMatrix = zeros(E.cols(), E.rows());
-  dewhiteningMatrix = zeros(E.rows(), E.cols());
+    fica_nonlin_symm(*Xc, B, g, a1, a2, numThreads, ws, Gc, Betac, dGc);
+    G += Gc;
+    Beta += Betac;
+    dG += dGc;
+    used += Xc->cols();
 
-  for (int i = 0; i < D.cols(); i++) {
-    whiteningMatrix.set_row(i, std::pow(std::sqrt(D(i, i)), -1)*E.get_col(i));
-    dewhiteningMatrix.set_col(i, std::sqrt(D(i, i))*E.get_col(i));
   }
 
-  newVectors = whiteningMatrix * vectors;
-
-  return;
+  return used;
+}
 
+// A subsample only gives the estimates to about 1 / sqrt(fraction *
+// numSamples), far above epsilon. Subsampling is therefore dropped for the
+// rest of the run, of the current component in the deflation approach, once
+// the step stops shrinking or the stabilization starts.
+static void fica_end_subsampling(int &usedNlinearity, const double step, double &lastStep, const bool stabilized)
+{
+  if (mod(usedNlinearity, 10) >= 2 && (step >= lastStep || stabilized)) usedNlinearity -= 2;
+  lastStep = step;
 }
 
-static mat orth(const mat A)
+// Deflation approach with up to deflBlock candidate vectors iterated at a
+// time, so that every round makes a single pass over X for all of them. The
+// candidates are orthogonalized in order, against the accepted components
+// and against the candidates before them, so that the first one follows the
+// usual deflation scheme. Only this head candidate is fine-tuned and
+// accepted; the next ones carry on with their coarse iterations in the
+// meantime and wait once converged, which pipelines the search of component
+// k+1 with the fine tuning of component k.
+static bool fpica_defl_blocked(Fica_Data &X, const mat &whiteningMatrix, const mat &dewhiteningMatrix, const int numOfIC, const int gOrig, const int gFine, const int fineTuningEnabled, const int stabilizationEnabled, const double a1, const double a2, const double myyOrig, const double myyK, const double epsilon, const int maxNumIterations, const int maxFinetune, const int failureLimit, const int initialStateMode, const mat &guess, const double sampleSize, const int deflBlock, mat & A, mat & W, Fica_Monitor *mon)
 {
 
-  mat Q;
-  mat U, V;
-  vec S;
-  double eps = 2.2e-16;
-  double tol = 0.0;
-  int mmax = 0;
-  int r = 0;
+  int vectorSize = X.rows();
 
-  svd(A, U, S, V);
-  if (A.rows() > A.cols()) {
+  A = zeros(whiteningMatrix.cols(), numOfIC);
+  mat B = zeros(vectorSize, numOfIC);
+  W = transpose(B) * whiteningMatrix;
 
-    U = U(0, U.rows() - 1, 0, A.cols() - 1);
-    S = S(0, A.cols() - 1);
-  }
+  int accepted = 0;
+  int numFailures = 0;
+  std::vector<Fica_Candidate> active;
 
-  mmax = (A.rows() > A.cols()) ? A.rows() : A.cols();
+  // Columns of the candidates updated in a round, and their kernel outputs
+  mat Wm, G;
+  vec Beta, dG;
+  ivec updated(deflBlock);
 
-  tol = mmax * eps * max(S);
+  while (accepted < numOfIC) {
 
-  for (int i = 0; i < size(S); i++) if (S(i) > tol) r++;
+    // Fill the pipeline
+    while (static_cast<int>(active.size()) < deflBlock && accepted + static_cast<int>(active.size()) < numOfIC) {
+      active.push_back(Fica_Candidate());
+      int c = accepted + static_cast<int>(active.size()) - 1;
+      active.back().init(initialStateMode == 0 ? vec(randu(vectorSize) - 0.5) : vec(whiteningMatrix * guess.get_col(c)), gOrig, myyOrig);
+    }
 
-  Q = U(0, U.rows() - 1, 0, r - 1);
+    int numUpdated = 0;
+    bool headAccepted = false;
 
-  return (Q);
-}
+    for (int j = 0; j < static_cast<int>(active.size()); j++) {
 
-static mat mpower(const mat A, const double y)
-{
+      Fica_Candidate &cand = active[j];
+      vec &w = cand.w;
+      int component = accepted + j;
+      bool head = (j == 0);
 
-  mat T = zeros(A.rows(), A.cols());
-  mat dd = zeros(A.rows(), A.cols());
-  vec d = zeros(A.rows());
-  vec dOut = zeros(A.rows());
+      w = w - B * (transpose(B) * w);
+      for (int l = 0; l < j; l++) w -= dot(active[l].w, w) * active[l].w;
+      w /= norm(w);
 
-  eig_sym(A, d, T);
+      if (cand.notFine) {
+        if (cand.i == maxNumIterations + 1) {
+          // Convergence failure: start this component again
+          numFailures++;
+          if (numFailures > failureLimit) {
+            if (accepted == 0) {
+              A = dewhiteningMatrix * B;
+              W = transpose(B) * whiteningMatrix;
+            }
+            return false;
+          }
+          cand.init(initialStateMode == 0 ? vec(randu(vectorSize) - 0.5) : vec(whiteningMatrix * guess.get_col(component)), gOrig, myyOrig);
+          continue;
+        }
+      }
+      else if (cand.i >= cand.endFinetuning) cand.wOld = w;
 
-  dOut = pow(d, y);
+      double step = std::min(norm(w - cand.wOld), norm(w + cand.wOld));
+      if (step < epsilon) {
 
-  diag(dOut, dd);
+        if (!head) {
+          // Wait for the components before this one
+          cand.settled = true;
+        }
+        else if (fineTuningEnabled && cand.notFine) {
+          cand.notFine = 0;
+          cand.wOld = zeros(vectorSize);
+          cand.wOld2 = zeros(vectorSize);
+          cand.usedNlinearity = gFine;
+          cand.myy = myyK * myyOrig;
+          cand.endFinetuning = maxFinetune + cand.i;
+        }
+        else {
+          numFailures = 0;
+          B.set_col(accepted, w);
+          A.set_col(accepted, dewhiteningMatrix * w);
+          W.set_row(accepted, transpose(whiteningMatrix) * w);
+          headAccepted = true;
+          continue;
+        }
+
+      }
+      else if (stabilizationEnabled) {
+        if (cand.stroke == 0.0 && (norm(w - cand.wOld2) < epsilon || norm(w + cand.wOld2) < epsilon)) {
+          cand.stroke = cand.myy;
+          cand.myy /= 2.0;
+          if (mon) mon->step_halved();
+          if (mod(cand.usedNlinearity, 2) == 0) cand.usedNlinearity++;
+        }
+        else if (cand.stroke != 0.0) {
+          cand.myy = cand.stroke;
+          cand.stroke = 0.0;
+          if (cand.myy == 1 && mod(cand.usedNlinearity, 2) != 0) cand.usedNlinearity--;
+        }
+        else if (cand.notFine && !cand.loong && cand.i > maxNumIterations / 2) {
+          cand.loong = 1;
+          cand.myy /= 2.0;
+          if (mon) mon->step_halved();
+          if (mod(cand.usedNlinearity, 2) == 0) cand.usedNlinearity++;
+        }
+      }
+      if (cand.notFine) fica_end_subsampling(cand.usedNlinearity, step, cand.lastStep, cand.stroke != 0.0 || cand.loong);
 
-  for (int i = 0; i < T.cols(); i++) T.set_col(i, T.get_col(i) / norm(T.get_col(i)));
+      if (mon) mon->round(cand.notFine ? ((cand.stroke != 0.0 || cand.loong) ? FICA_PHASE_STABILIZED : FICA_PHASE_COARSE) : FICA_PHASE_FINETUNE, component, std::fabs(dot(w, cand.wOld)), cand.usedNlinearity, cand.myy);
 
-  return (T*dd*transpose(T));
+      cand.wOld2 = cand.wOld;
+      cand.wOld = w;
+      updated(numUpdated++) = j;
 
-}
+    }
 
-static ivec getSamples(const int max, const double percentage)
-{
+    // One pass over X per group of candidates sharing the same non-linearity
+    // and sampling, which in practice is all of them
+    for (int u = 0; u < numUpdated; u++) {
+
+      if (updated(u) < 0) continue;
+      Fica_Candidate &first = active[updated(u)];
+      int gBase = first.usedNlinearity - mod(first.usedNlinearity, 10);
+      bool sampled = (first.usedNlinearity - gBase >= 2);
+
+      ivec group(numUpdated);
+      int groupSize = 0;
+      for (int v = u; v < numUpdated; v++) {
+        if (updated(v) < 0) continue;
+        int nl = active[updated(v)].usedNlinearity;
+        if (nl - mod(nl, 10) == gBase && (nl - gBase >= 2) == sampled) {
+          group(groupSize++) = updated(v);
+          updated(v) = -1;
+        }
+      }
 
-  vec rd = randu(max);
-  sparse_vec sV;
-  ivec out;
-  int sZ = 0;
+      if (gBase == FICA_NONLIN_POW3 || gBase == FICA_NONLIN_TANH
+          || gBase == FICA_NONLIN_GAUSS || gBase == FICA_NONLIN_SKEW) {
 
-  for (int i = 0; i < max; i++) if (rd(i) < percentage) { sV.add_elem(sZ, i); sZ++; }
+        Wm.set_size(vectorSize, groupSize, false);
+        for (int k = 0; k < groupSize; k++) Wm.set_col(k, active[group(k)].w);
 
-  out = to_ivec(full(sV));
+        int n = X.nonlin(Wm, gBase, a1, a2, sampled ? sampleSize : 1.0, G, Beta, dG);
 
-  return (out);
+        mat_view Gv(G);
+        for (int k = 0; k < groupSize; k++) {
+          Fica_Candidate &cand = active[group(k)];
+          if (mod(cand.usedNlinearity, 2) == 0) cand.w = (Gv.get_col(k) - dG(k) * lazy(cand.w)) / n;
+          // Beta(k) is dot(w, X * g(transpose(X) * w))
+          else cand.w = lazy(cand.w) - cand.myy * (Gv.get_col(k) - Beta(k) * lazy(cand.w)) / (dG(k) - Beta(k));
+        }
 
-}
+      }
 
-static vec sumcol(const mat A)
-{
+      for (int k = 0; k < groupSize; k++) {
+        Fica_Candidate &cand = active[group(k)];
+        cand.w /= norm(cand.w);
+        if (!cand.settled || group(k) == 0) cand.i++;
+      }
+
+    }
 
-  vec out = zeros(A.cols());
+    if (headAccepted) {
+      active.erase(active.begin());
+      accepted++;
+    }
 
-  for (int i = 0; i < A.cols(); i++) { out(i) = sum(A.get_col(i)); }
+  }
 
-  return (out);
+  return true;
 
 }
 
-static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningMatrix, const int approach, const int numOfIC, const int g, const int finetune, const double a1, const double a2, double myy, const int stabilization, const double epsilon, const int maxNumIterations, const int maxFinetune, const int initState, mat guess, double sampleSize, mat & A, mat & W)
+static bool fpica(Fica_Data &X, const mat &whiteningMatrix, const mat &dewhiteningMatrix, const int approach, const int numOfIC, const int g, const int finetune, const double a1, const double a2, double myy, const int stabilization, const double epsilon, const int maxNumIterations, const int maxFinetune, const int initState, mat guess, double sampleSize, const int deflBlock, mat & A, mat & W, Fica_Monitor *mon)
 {
 
   int vectorSize = X.rows();
@@ -503,6 +2507,11 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
     mat BOld = zeros(B.rows(), B.cols());
     mat BOld2 = zeros(B.rows(), B.cols());
+    double lastStep = 2.0;
+
+    // Outputs of the fused non-linearity kernel
+    mat G;
+    vec Beta, dG;
 
     for (int round = 0; round < maxNumIterations; round++) {
 
@@ -518,7 +2527,7 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
         return false;
       }
 
-      B = B * mpower(transpose(B) * B , -0.5);
+      fica_decorrelate(B);
 
       minAbsCos = min(abs(diag(transpose(B) * BOld)));
       minAbsCos2 = min(abs(diag(transpose(B) * BOld2)));
@@ -549,6 +2558,7 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
           stroke = myy;
           myy /= 2;
+          if (mon) mon->step_halved();
           if (mod(usedNlinearity, 2) == 0) usedNlinearity += 1 ;
 
         }
@@ -563,145 +2573,40 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
           loong = 1;
           myy /= 2;
+          if (mon) mon->step_halved();
           if (mod(usedNlinearity, 2) == 0) usedNlinearity += 1;
 
         }
 
       } // stabilizationEnabled
 
-      BOld2 = BOld;
-      BOld = B;
+      if (notFine) fica_end_subsampling(usedNlinearity, 1 - minAbsCos, lastStep, stroke != 0 || loong);
 
-      switch (usedNlinearity) {
+      if (mon) mon->round(notFine ? ((stroke != 0 || loong) ? FICA_PHASE_STABILIZED : FICA_PHASE_COARSE) : FICA_PHASE_FINETUNE, -1, minAbsCos, usedNlinearity, myy);
 
-        // pow3
-      case FICA_NONLIN_POW3 : {
-        B = (X * pow(transpose(X) * B, 3)) / numSamples - 3 * B;
-        break;
-      }
-      case(FICA_NONLIN_POW3+1) : {
-        mat Y = transpose(X) * B;
-        mat Gpow3 = pow(Y, 3);
-        vec Beta = sumcol(pow(Y, 4));
-        mat D = diag(pow(Beta - 3 * numSamples , -1));
-        B = B + myy * B * (transpose(Y) * Gpow3 - diag(Beta)) * D;
-        break;
-      }
-      case(FICA_NONLIN_POW3+2) : {
-        mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-        B = (Xsub * pow(transpose(Xsub) * B, 3)) / Xsub.cols() - 3 * B;
-        break;
-      }
-      case(FICA_NONLIN_POW3+3) : {
-        mat Ysub = transpose(X.get_cols(getSamples(numSamples, sampleSize))) * B;
-        mat Gpow3 = pow(Ysub, 3);
-        vec Beta = sumcol(pow(Ysub, 4));
-        mat D = diag(pow(Beta - 3 * Ysub.rows() , -1));
-        B = B + myy * B * (transpose(Ysub) * Gpow3 - diag(Beta)) * D;
-        break;
-      }
+      BOld2 = BOld;
+      BOld = B;
 
-      // TANH
-      case FICA_NONLIN_TANH : {
-        mat hypTan = tanh(a1 * transpose(X) * B);
-        B = (X * hypTan) / numSamples - elem_mult(reshape(repeat(sumcol(1 - pow(hypTan, 2)), B.rows()), B.rows(), B.cols()), B) / numSamples * a1;
-        break;
-      }
-      case(FICA_NONLIN_TANH+1) : {
-        mat Y = transpose(X) * B;
-        mat hypTan = tanh(a1 * Y);
-        vec Beta = sumcol(elem_mult(Y, hypTan));
-        vec Beta2 = sumcol(1 - pow(hypTan, 2));
-        mat D = diag(pow(Beta - a1 * Beta2 , -1));
-        B = B + myy * B * (transpose(Y) * hypTan - diag(Beta)) * D;
-        break;
-      }
-      case(FICA_NONLIN_TANH+2) : {
-        mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-        mat hypTan = tanh(a1 * transpose(Xsub) * B);
-        B = (Xsub * hypTan) / Xsub.cols() -  elem_mult(reshape(repeat(sumcol(1 - pow(hypTan, 2)), B.rows()), B.rows(), B.cols()), B) / Xsub.cols() * a1;
-        break;
-      }
-      case(FICA_NONLIN_TANH+3) : {
-        mat Ysub = transpose(X.get_cols(getSamples(numSamples, sampleSize))) * B;
-        mat hypTan = tanh(a1 * Ysub);
-        vec Beta = sumcol(elem_mult(Ysub, hypTan));
-        vec Beta2 = sumcol(1 - pow(hypTan, 2));
-        mat D = diag(pow(Beta - a1 * Beta2 , -1));
-        B = B + myy * B * (transpose(Ysub) * hypTan - diag(Beta)) * D;
-        break;
-      }
+      // Units digit of usedNlinearity: +1 for the stabilized update,
+      // +2 for subsampling
+      int gBase = usedNlinearity - mod(usedNlinearity, 10);
+      if (gBase != FICA_NONLIN_POW3 && gBase != FICA_NONLIN_TANH
+          && gBase != FICA_NONLIN_GAUSS && gBase != FICA_NONLIN_SKEW)
+        continue;
 
-      // GAUSS
-      case FICA_NONLIN_GAUSS : {
-        mat U = transpose(X) * B;
-        mat Usquared = pow(U, 2);
-        mat ex = exp(-a2 * Usquared / 2);
-        mat gauss = elem_mult(U, ex);
-        mat dGauss = elem_mult(1 - a2 * Usquared, ex);
-        B = (X * gauss) / numSamples - elem_mult(reshape(repeat(sumcol(dGauss), B.rows()), B.rows(), B.cols()), B) / numSamples;
-        break;
-      }
-      case(FICA_NONLIN_GAUSS+1) : {
-        mat Y = transpose(X) * B;
-        mat ex = exp(-a2 * pow(Y, 2) / 2);
-        mat gauss = elem_mult(Y, ex);
-        vec Beta = sumcol(elem_mult(Y, gauss));
-        vec Beta2 = sumcol(elem_mult(1 - a2 * pow(Y, 2), ex));
-        mat D = diag(pow(Beta - Beta2 , -1));
-        B = B + myy * B * (transpose(Y) * gauss - diag(Beta)) * D;
-        break;
-      }
-      case(FICA_NONLIN_GAUSS+2) : {
-        mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-        mat U = transpose(Xsub) * B;
-        mat Usquared = pow(U, 2);
-        mat ex = exp(-a2 * Usquared / 2);
-        mat gauss = elem_mult(U, ex);
-        mat dGauss = elem_mult(1 - a2 * Usquared, ex);
-        B = (Xsub * gauss) / Xsub.cols() - elem_mult(reshape(repeat(sumcol(dGauss), B.rows()), B.rows(), B.cols()), B) / Xsub.cols();
-        break;
-      }
-      case(FICA_NONLIN_GAUSS+3) : {
-        mat Ysub = transpose(X.get_cols(getSamples(numSamples, sampleSize))) * B;
-        mat ex = exp(-a2 * pow(Ysub, 2) / 2);
-        mat gauss = elem_mult(Ysub, ex);
-        vec Beta = sumcol(elem_mult(Ysub, gauss));
-        vec Beta2 = sumcol(elem_mult(1 - a2 * pow(Ysub, 2), ex));
-        mat D = diag(pow(Beta - Beta2 , -1));
-        B = B + myy * B * (transpose(Ysub) * gauss - diag(Beta)) * D;
-        break;
-      }
+      int n = X.nonlin(B, gBase, a1, a2, (usedNlinearity - gBase >= 2) ? sampleSize : 1.0, G, Beta, dG);
 
-      // SKEW
-      case FICA_NONLIN_SKEW : {
-        B = (X * (pow(transpose(X) * B, 2))) / numSamples;
-        break;
-      }
-      case(FICA_NONLIN_SKEW+1) : {
-        mat Y = transpose(X) * B;
-        mat Gskew = pow(Y, 2);
-        vec Beta = sumcol(elem_mult(Y, Gskew));
-        mat D = diag(pow(Beta , -1));
-        B = B + myy * B * (transpose(Y) * Gskew - diag(Beta)) * D;
-        break;
+      if (mod(usedNlinearity, 2) == 0) {
+        // B = (X * g(Y) - B * diag(dG)) / numSamples
+        for (int j = 0; j < B.cols(); j++)
+          for (int i = 0; i < B.rows(); i++)
+            B(i, j) = (G(i, j) - dG(j) * B(i, j)) / n;
       }
-      case(FICA_NONLIN_SKEW+2) : {
-        mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-        B = (Xsub * (pow(transpose(Xsub) * B, 2))) / Xsub.cols();
-        break;
+      else {
+        // transpose(Y) * g(Y) is computed as transpose(B) * G
+        mat D = diag(pow(Beta - dG , -1));
+        B = B + myy * B * (transpose(B) * G - diag(Beta)) * D;
       }
-      case(FICA_NONLIN_SKEW+3) : {
-        mat Ysub = transpose(X.get_cols(getSamples(numSamples, sampleSize))) * B;
-        mat Gskew = pow(Ysub, 2);
-        vec Beta = sumcol(elem_mult(Ysub, Gskew));
-        mat D = diag(pow(Beta , -1));
-        B = B + myy * B * (transpose(Ysub) * Gskew - diag(Beta)) * D;
-        break;
-      }
-
-
-      } // SWITCH usedNlinearity
 
     } // FOR maxIterations
 
@@ -711,6 +2616,12 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
   } // IF FICA_APPROACH_SYMM APPROACH
 
   // DEFLATION
+  else if (deflBlock > 1) {
+
+    return fpica_defl_blocked(X, whiteningMatrix, dewhiteningMatrix, numOfIC, gOrig, gFine, fineTuningEnabled, stabilizationEnabled, a1, a2, myyOrig, myyK, epsilon, maxNumIterations, maxFinetune, failureLimit, initialStateMode, guess, sampleSize, deflBlock, A, W, mon);
+
+  }
+
   else {
 
     // FC 01/12/05
@@ -721,6 +2632,10 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
     int round = 1;
     int numFailures = 0;
 
+    // Outputs of the fused non-linearity kernel
+    mat G;
+    vec Beta, dG;
+
     while (round <= numOfIC) {
 
       myy = myyOrig;
@@ -738,7 +2653,7 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
         w = randu(vectorSize) - 0.5;
 
-      else w = whiteningMatrix * guess.get_col(round);
+      else w = whiteningMatrix * guess.get_col(round - 1);
 
       w = w - B * transpose(B) * w;
 
@@ -746,6 +2661,7 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
       vec wOld = zeros(vectorSize);
       vec wOld2 = zeros(vectorSize);
+      double lastStep = 2.0;
 
       int i = 1;
       int gabba = 1;
@@ -785,7 +2701,8 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
         else if (i >= endFinetuning) wOld = w;
 
-        if (norm(w - wOld) < epsilon || norm(w + wOld) < epsilon) {
+        double step = std::min(norm(w - wOld), norm(w + wOld));
+        if (step < epsilon) {
 
           if (fineTuningEnabled && notFine) {
 
@@ -821,6 +2738,7 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
             stroke = myy;
             myy /= 2.0 ;
+            if (mon) mon->step_halved();
 
             if (mod(usedNlinearity, 2) == 0) {
 
@@ -845,6 +2763,7 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
             loong = 1;
             myy /= 2.0;
+            if (mon) mon->step_halved();
 
             if (mod(usedNlinearity, 2) == 0) {
 
@@ -856,134 +2775,26 @@ static bool fpica(const mat X, const mat whiteningMatrix, const mat dewhiteningM
 
         } // IF stabilization
 
+        if (notFine) fica_end_subsampling(usedNlinearity, step, lastStep, stroke != 0.0 || loong);
+
+        if (mon) mon->round(notFine ? ((stroke != 0.0 || loong) ? FICA_PHASE_STABILIZED : FICA_PHASE_COARSE) : FICA_PHASE_FINETUNE, round - 1, std::fabs(dot(w, wOld)), usedNlinearity, myy);
 
         wOld2 = wOld;
         wOld = w;
 
-        switch (usedNlinearity) {
-
-          // pow3
-        case FICA_NONLIN_POW3 : {
-          w = (X * pow(transpose(X) * w, 3)) / numSamples - 3 * w;
-          break;
-        }
-        case(FICA_NONLIN_POW3+1) : {
-          vec Y = transpose(X) * w;
-          vec Gpow3 = X * pow(Y, 3) / numSamples;
-          double Beta = dot(w, Gpow3);
-          w = w - myy * (Gpow3 - Beta * w) / (3 - Beta);
-          break;
-        }
-        case(FICA_NONLIN_POW3+2) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          w = (Xsub * pow(transpose(Xsub) * w, 3)) / Xsub.cols() - 3 * w;
-          break;
-        }
-        case(FICA_NONLIN_POW3+3) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          vec Gpow3 = Xsub * pow(transpose(Xsub) * w, 3) / (Xsub.cols());
-          double Beta = dot(w, Gpow3);
-          w = w - myy * (Gpow3 - Beta * w) / (3 - Beta);
-          break;
-        }
+        // Same fused kernel as the symmetric approach, on a single column
+        int gBase = usedNlinearity - mod(usedNlinearity, 10);
+        if (gBase == FICA_NONLIN_POW3 || gBase == FICA_NONLIN_TANH
+            || gBase == FICA_NONLIN_GAUSS || gBase == FICA_NONLIN_SKEW) {
 
-        // TANH
-        case FICA_NONLIN_TANH : {
-          vec hypTan = tanh(a1 * transpose(X) * w);
-          w = (X * hypTan - a1 * sum(1 - pow(hypTan, 2)) * w) / numSamples;
-          break;
-        }
-        case(FICA_NONLIN_TANH+1) : {
-          vec Y = transpose(X) * w;
-          vec hypTan = tanh(a1 * Y);
-          double Beta = dot(w, X * hypTan);
-          w = w - myy * ((X * hypTan - Beta * w) / (a1 * sum(1 - pow(hypTan, 2)) - Beta));
-          break;
-        }
-        case(FICA_NONLIN_TANH+2) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          vec hypTan = tanh(a1 * transpose(Xsub) * w);
-          w = (Xsub * hypTan - a1 * sum(1 - pow(hypTan, 2)) * w) / Xsub.cols();
-          break;
-        }
-        case(FICA_NONLIN_TANH+3) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          vec hypTan = tanh(a1 * transpose(Xsub) * w);
-          double Beta = dot(w, Xsub * hypTan);
-          w = w - myy * ((Xsub * hypTan - Beta * w) / (a1 * sum(1 - pow(hypTan, 2)) - Beta));
-          break;
-        }
+          int n = X.nonlin(mat(w), gBase, a1, a2, (usedNlinearity - gBase >= 2) ? sampleSize : 1.0, G, Beta, dG);
 
-        // GAUSS
-        case FICA_NONLIN_GAUSS : {
-          vec u = transpose(X) * w;
-          vec Usquared = pow(u, 2);
-          vec ex = exp(-a2 * Usquared / 2);
-          vec gauss = elem_mult(u, ex);
-          vec dGauss = elem_mult(1 - a2 * Usquared, ex);
-          w = (X * gauss - sum(dGauss) * w) / numSamples;
-          break;
-        }
-        case(FICA_NONLIN_GAUSS+1) : {
-          vec u = transpose(X) * w;
-          vec Usquared = pow(u, 2);
-
-          vec ex = exp(-a2 * Usquared / 2);
-          vec gauss = elem_mult(u, ex);
-          vec dGauss = elem_mult(1 - a2 * Usquared, ex);
-          double Beta = dot(w, X * gauss);
-          w = w - myy * ((X * gauss - Beta * w) / (sum(dGauss) - Beta));
-          break;
-        }
-        case(FICA_NONLIN_GAUSS+2) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          vec u = transpose(Xsub) * w;
-          vec Usquared = pow(u, 2);
-          vec ex = exp(-a2 * Usquared / 2);
-          vec gauss = elem_mult(u, ex);
-          vec dGauss = elem_mult(1 - a2 * Usquared, ex);
-          w = (Xsub * gauss - sum(dGauss) * w) / Xsub.cols();
-          break;
-        }
-        case(FICA_NONLIN_GAUSS+3) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          vec u = transpose(Xsub) * w;
-          vec Usquared = pow(u, 2);
-          vec ex = exp(-a2 * Usquared / 2);
-          vec gauss = elem_mult(u, ex);
-          vec dGauss = elem_mult(1 - a2 * Usquared, ex);
-          double Beta = dot(w, Xsub * gauss);
-          w = w - myy * ((Xsub * gauss - Beta * w) / (sum(dGauss) - Beta));
-          break;
-        }
+          if (mod(usedNlinearity, 2) == 0) w = (mat_view(G).get_col(0) - dG(0) * lazy(w)) / n;
+          // Beta(0) is dot(w, X * g(transpose(X) * w))
+          else w = lazy(w) - myy * (mat_view(G).get_col(0) - Beta(0) * lazy(w)) / (dG(0) - Beta(0));
 
-        // SKEW
-        case FICA_NONLIN_SKEW : {
-          w = (X * (pow(transpose(X) * w, 2))) / numSamples;
-          break;
-        }
-        case(FICA_NONLIN_SKEW+1) : {
-          vec Y = transpose(X) * w;
-          vec Gskew = X * pow(Y, 2) / numSamples;
-          double Beta = dot(w, Gskew);
-          w = w - myy * (Gskew - Beta * w / (-Beta));
-          break;
-        }
-        case(FICA_NONLIN_SKEW+2) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          w = (Xsub * (pow(transpose(Xsub) * w, 2))) / Xsub.cols();
-          break;
-        }
-        case(FICA_NONLIN_SKEW+3) : {
-          mat Xsub = X.get_cols(getSamples(numSamples, sampleSize));
-          vec Gskew = Xsub * pow(transpose(Xsub) * w, 2) / Xsub.cols();
-          double Beta = dot(w, Gskew);
-          w = w - myy * (Gskew - Beta * w) / (-Beta);
-          break;
         }
 
-        } // SWITCH nonLinearity
-
         w /= norm(w);
         i++;
 
@@ -63,8 +63,14 @@
 #define FASTICA_H
 
 #include <itpp/base/mat.h>
+#include <itpp/base/array.h>
 #include <itpp/itexports.h>
 
+//! Defined when the compiler supports rvalue references
+#ifdef ITPP_HAVE_RVALUE_REFS
+#  define FICA_HAVE_RVALUE_REFS
+#endif
+
 //! Use deflation approach : compute IC one-by-one in a Gram-Schmidt-like fashion
 #define FICA_APPROACH_DEFL 2
 //! Use symmetric approach : compute all ICs at a time
@@ -87,13 +93,143 @@
 //! Eigenvalues of the covariance matrix lower than FICA_TOL are discarded for analysis
 #define FICA_TOL 1e-9
 
+//! Number of doubles of one sample block processed at a time by the fixed-point iterations
+#define FICA_BLOCK_ELEMS 32768
+
+//! Default number of samples read at a time in streaming mode
+#define FICA_CHUNK_SIZE 65536
+
+//! Subsampling of Fast_ICA: every sample drawn independently
+#define FICA_SAMPLING_RANDOM 0
+//! Subsampling of Fast_ICA: one block of samples at a random position in each stratum of the signal
+#define FICA_SAMPLING_STRATIFIED 1
+//! Subsampling of Fast_ICA: blocks of samples at a regular stride, with a random offset per round
+#define FICA_SAMPLING_STRIDED 2
+//! Number of consecutive samples of a block in stratified and strided subsampling
+#define FICA_SAMPLING_BLOCK 64
+//! Default seed of the subsampling of Fast_ICA
+#define FICA_SAMPLING_SEED 1
+
+//! PCA of Fast_ICA: eigenvalue decomposition of the full covariance matrix
+#define FICA_PCA_FULL 0
+//! PCA of Fast_ICA: leading eigenvectors only, by randomized subspace iteration on the signals
+#define FICA_PCA_RANDOMIZED 1
+//! Default relative residual of the eigenvectors computed by the randomized PCA
+#define FICA_PCA_TOL 1e-6
+//! Number of eigenvectors computed by the randomized PCA in excess of the needed ones
+#define FICA_PCA_OVERSAMPLING 10
+//! Maximum number of passes over the signals of the randomized PCA
+#define FICA_PCA_MAX_PASSES 20
+
+//! Phase of Fast_ICA::separate(): centering and covariance
+#define FICA_PHASE_MOMENTS 0
+//! Phase of Fast_ICA::separate(): eigenvalue decomposition of the covariance
+#define FICA_PHASE_PCA 1
+//! Phase of Fast_ICA::separate(): whitening of the signals
+#define FICA_PHASE_WHITENING 2
+//! Phase of Fast_ICA::separate(): fixed-point rounds before fine tuning
+#define FICA_PHASE_COARSE 3
+//! Phase of Fast_ICA::separate(): fixed-point rounds with a step size halved by stabilization
+#define FICA_PHASE_STABILIZED 4
+//! Phase of Fast_ICA::separate(): fine tuning rounds
+#define FICA_PHASE_FINETUNE 5
+//! Phase of Fast_ICA::separate(): double precision refinement rounds
+#define FICA_PHASE_REFINEMENT 6
+//! Phase of Fast_ICA::separate(): computation of the ICs
+#define FICA_PHASE_OUTPUT 7
+//! Number of phases of Fast_ICA::separate()
+#define FICA_NROF_PHASES 8
+
+//! Largest number of ICs for which the symmetric decorrelation is computed without LAPACK
+#define FICA_SMALL_DIM 8
+
+//! Default per-sample forgetting factor of Online_Fast_ICA
+#define FICA_ONLINE_FORGETTING 0.9999
+//! Default number of recent samples used by Online_Fast_ICA::update()
+#define FICA_ONLINE_WINDOW 8192
+//! Default maximum number of fixed-point iterations per Online_Fast_ICA::update()
+#define FICA_ONLINE_ITERATIONS 5
+
 namespace itpp
 {
 
+class ICA_Reader;
+class ICA_Writer;
+
 /*!
   \addtogroup fastica
 */
 
+/*!
+  \ingroup fastica
+  \brief Convergence and timing report of Fast_ICA::separate()
+*/
+class ITPP_EXPORT Fast_ICA_Stats
+{
+public:
+  //! Clear the report
+  Fast_ICA_Stats() { reset(); }
+  //! Clear the report
+  void reset();
+
+  //! Wall time in seconds spent in each phase, indexed by FICA_PHASE_*
+  vec phase_time;
+  //! Number of fixed-point rounds run in each phase, indexed by FICA_PHASE_*
+  ivec phase_rounds;
+  //! Number of rounds used by each IC in the deflation approach, or by all of them in the symmetric approach. The double precision refinement appends its own entries
+  ivec component_rounds;
+  //! Convergence measure of every round: minimum over the ICs of |cos| of the angle with the previous round
+  vec min_abs_cos;
+  //! One row per change of non-linearity: round index in min_abs_cos, IC (-1 for all), old and new non-linearity
+  imat nonlin_switches;
+  //! Number of times stabilization halved the step size
+  int nrof_step_halvings;
+  /*!
+    \brief Estimated bytes of the signal-sized buffers of separate()
+
+    Computed from the dimensions of the centered, whitened, single precision
+    and separated signals (or of their chunks when streaming), as they are
+    created. It is a sum over these buffers, not the peak memory use. The
+    input signals, the small per-iteration matrices and the workspaces of
+    the parallel loops are not counted.
+  */
+  double bytes_estimated;
+  //! Total wall time of separate() in seconds
+  double total_time;
+};
+
+/*!
+  \ingroup fastica
+  \brief Progress event reported by Fast_ICA::separate() to its callback
+
+  An event is sent at the end of each of the phases FICA_PHASE_MOMENTS,
+  FICA_PHASE_PCA, FICA_PHASE_WHITENING and FICA_PHASE_OUTPUT, with \c round
+  set to -1, and at every fixed-point round.
+*/
+struct Fast_ICA_Event
+{
+  //! FICA_PHASE_* of the event
+  int phase;
+  //! IC in the deflation approach, -1 in the symmetric approach
+  int component;
+  //! Round of the component, from 0, or -1 for the end of a phase
+  int round;
+  //! Convergence measure of the round
+  double min_abs_cos;
+  //! Non-linearity used by the round, including the stabilization and sampling variants
+  int nonlinearity;
+  //! Step size used by the round
+  double mu;
+  //! Wall time in seconds since the start of separate()
+  double time;
+};
+
+//! Callback receiving the progress events of Fast_ICA::separate(), together with user data
+typedef void (*Fast_ICA_Callback)(const Fast_ICA_Event &event, void *user_data);
+
+//! Tag selecting the constructor of Fast_ICA which borrows the mixed signals
+struct Fast_ICA_Borrow {};
+
 //---------------------- FastICA --------------------------------------
 
 /*!
@@ -114,6 +250,20 @@ fastica.set_approach( FICA_APPROACH_DEFL );
 fastica.separate();
 mat ICs = fastica.get_independent_components();
 \endcode
+
+Signals too large to be held in memory can be separated in streaming mode,
+by constructing the object from an ICA_Reader. The mean and covariance are
+then accumulated in a first pass over the data and every fixed-point
+iteration makes a further pass, so that only one chunk of samples is held at
+a time. The separated signals are written chunk by chunk with
+write_independent_components():
+\code
+ICA_Raw_Reader mixtures("mixtures.bin", 32);
+Fast_ICA fastica(mixtures);
+fastica.separate();
+ICA_Raw_Writer ICs("ICs.bin");
+fastica.write_independent_components(ICs);
+\endcode
 */
 class ITPP_EXPORT Fast_ICA
 {
@@ -127,7 +277,45 @@ public:
 
     \param ma_mixed_sig (Input) Mixed signals to separate
   */
-  Fast_ICA(mat ma_mixed_sig);
+  Fast_ICA(const mat &ma_mixed_sig);
+
+#ifdef FICA_HAVE_RVALUE_REFS
+  /*!
+    \brief Constructor taking over the mixed signals
+
+    \param ma_mixed_sig (Input) Mixed signals to separate, left unspecified
+  */
+  Fast_ICA(mat &&ma_mixed_sig);
+#endif
+
+  /*!
+    \brief Borrowing constructor
+
+    Construct a Fast_ICA object separating the mixed signals \c ma_mixed_sig
+    without copying them, as in <tt>Fast_ICA ica(X, Fast_ICA_Borrow());</tt>.
+    The object refers to \c ma_mixed_sig, which must therefore outlive it and
+    stay unchanged until the last call to separate(). A temporary matrix is
+    rejected at compile time where the compiler supports rvalue references.
+
+    \param ma_mixed_sig (Input) Mixed signals to separate
+  */
+  Fast_ICA(const mat &ma_mixed_sig, Fast_ICA_Borrow);
+#ifdef FICA_HAVE_RVALUE_REFS
+  //! A temporary cannot be borrowed
+  Fast_ICA(mat &&ma_mixed_sig, Fast_ICA_Borrow) = delete;
+#endif
+
+  /*!
+    \brief Streaming constructor
+
+    Construct a Fast_ICA object reading the mixed signals to separate chunk
+    by chunk from \c reader, which must remain valid during the lifetime of
+    the object. The reader is rewound and read through once to compute the
+    mean and covariance, and once more per fixed-point iteration.
+
+    \param reader (Input) Source of the mixed signals to separate
+  */
+  Fast_ICA(ICA_Reader &reader);
 
   /*!
     \brief Explicit launch of main FastICA function
@@ -213,11 +401,51 @@ public:
     \brief Set sample size
 
     Set the percentage of samples to take into account at every iteration.
+    As a subsample cannot reach the precision \f$\epsilon\f$, all the samples
+    are used from the iteration at which the step stops shrinking or the
+    stabilization starts on, for the rest of the run in the symmetric
+    approach and of the current component in the deflation approach.
 
     \param fl_sampleSize (Input) Percentage of data to take into account at every iteration
   */
   void set_sample_size(double fl_sampleSize);
 
+  /*!
+    \brief Set subsampling scheme (default = FICA_SAMPLING_RANDOM)
+
+    Set how the samples are chosen at every iteration when the sample size
+    is lower than one. FICA_SAMPLING_RANDOM keeps every sample with a
+    probability equal to the sample size. FICA_SAMPLING_STRATIFIED and
+    FICA_SAMPLING_STRIDED keep blocks of FICA_SAMPLING_BLOCK consecutive
+    samples, which are cheaper to gather, at a random position in each
+    stratum of the signal or at a regular stride respectively.
+
+    \param in_sampling (Input) FICA_SAMPLING_RANDOM, FICA_SAMPLING_STRATIFIED or FICA_SAMPLING_STRIDED
+  */
+  void set_sampling(int in_sampling);
+
+  /*!
+    \brief Set seed of the subsampling (default = FICA_SAMPLING_SEED)
+
+    The samples are drawn by a generator owned by each separation, so that
+    subsampled runs are reproducible and do not depend on the global random
+    generator nor on the number of threads.
+
+    \param in_seed (Input) Seed of the subsampling
+  */
+  void set_sampling_seed(unsigned int in_seed);
+
+  /*!
+    \brief Set growth factor of the sample size (default = 1)
+
+    Mini-batch schedule: the fraction of samples used is multiplied by
+    \c in_growth after every subsampled iteration, until all samples are
+    used. Early iterations are then cheap, and the last ones accurate.
+
+    \param in_growth (Input) Growth factor of the sample size, at least 1
+  */
+  void set_sample_growth(double in_growth);
+
   /*!
     \brief Set stabilization mode true or off
 
@@ -279,8 +507,121 @@ public:
 
     \param ma_initGuess (Input) Initial guess matrix
   */
-  void set_init_guess(mat ma_initGuess);
+  void set_init_guess(const mat &ma_initGuess);
+
+#ifdef FICA_HAVE_RVALUE_REFS
+  //! Set initial guess matrix, taking over \c ma_initGuess
+  void set_init_guess(mat &&ma_initGuess);
+#endif
+
+  /*!
+    \brief Set number of threads (default = 1)
+
+    Set the number of threads used for centering, whitening and the
+    fixed-point iterations. The samples are split into contiguous chunks whose
+    partial results are always summed in the same order, so that a given
+    number of threads gives reproducible results. Has no effect if IT++ is
+    built without OpenMP support.
+
+    \param in_numThreads (Input) Number of threads
+  */
+  void set_num_threads(int in_numThreads);
+
+  /*!
+    \brief Set number of ICs searched at a time by the deflation approach (default = 1)
+
+    With a block of more than one, the deflation approach iterates up to
+    \c in_deflBlock candidate vectors together, with a single pass over the
+    signals per round for all of them. The candidates are orthogonalized in
+    order, so that the ICs are still accepted one by one as in the plain
+    deflation approach, and the next candidates progress while the current
+    one is being fine-tuned.
+
+    \param in_deflBlock (Input) Number of candidate vectors iterated at a time
+  */
+  void set_deflation_block(int in_deflBlock);
 
+  /*!
+    \brief Run the fixed-point iterations in single precision (default = false)
+
+    Store the whitened signals as floats and run the fixed-point iterations
+    on them, which halves the memory traffic of every iteration. The mean,
+    covariance and whitening matrix are still computed in double precision,
+    and the non-linearity sums are accumulated in double precision. The
+    whitened signals are then not available from get_white_sig(). Has no
+    effect in streaming mode.
+
+    \param in_singlePrecision (Input) True = single precision, false = double precision (default)
+  */
+  void set_single_precision(bool in_singlePrecision);
+
+  /*!
+    \brief Set the PCA method (default = FICA_PCA_FULL)
+
+    With FICA_PCA_RANDOMIZED, only the leading min(numOfIC, lastEig)
+    eigenvectors of the covariance matrix are computed, by randomized
+    subspace iteration on the centered signals, without forming the
+    covariance matrix. Each iteration is one pass over the signals that
+    costs about 2 * (min(numOfIC, lastEig) + FICA_PCA_OVERSAMPLING) / channels
+    of the covariance computation, so this pays off when few components are
+    kept out of many channels. The full decomposition is used when most of
+    the eigenvectors are needed anyway.
+
+    \param in_pcaMethod (Input) FICA_PCA_FULL or FICA_PCA_RANDOMIZED
+  */
+  void set_pca_method(int in_pcaMethod);
+
+  /*!
+    \brief Set the tolerance of the randomized PCA (default = FICA_PCA_TOL)
+
+    The iterations of FICA_PCA_RANDOMIZED stop when the residual
+    |C u - lambda u| of every needed eigenvector u of the covariance matrix
+    C is at most this tolerance times the largest eigenvalue, or after
+    FICA_PCA_MAX_PASSES passes over the signals.
+
+    \param in_pcaTolerance (Input) Relative residual of the eigenvectors
+  */
+  void set_pca_tolerance(double in_pcaTolerance);
+
+  /*!
+    \brief Set number of double precision refinement iterations (default = 0)
+
+    In single precision mode, run at most this number of further fixed-point
+    iterations in double precision, starting from the single precision
+    solution. The signals are whitened on the fly for these iterations.
+
+    \param in_refinementIterations (Input) Maximum number of refinement iterations
+  */
+  void set_refinement_iterations(int in_refinementIterations);
+
+  /*!
+    \brief Set chunk size (default = FICA_CHUNK_SIZE)
+
+    Set the number of samples read at a time in streaming mode, and written
+    at a time by write_independent_components().
+
+    \param in_chunkSize (Input) Number of samples per chunk
+  */
+  void set_chunk_size(int in_chunkSize);
+
+
+  /*!
+    \brief Set a progress callback (default = none)
+
+    The callback is called from the thread calling separate(), see
+    Fast_ICA_Event.
+
+    \param callback (Input) Function to call, or 0 to disable the callback
+    \param user_data (Input) Pointer passed back to \c callback
+  */
+  void set_callback(Fast_ICA_Callback callback, void *user_data = 0);
+
+  /*!
+    \brief Get the convergence and timing report of the last call to separate()
+
+    \return Report of the last separation
+  */
+  const Fast_ICA_Stats &get_stats() const;
 
   /*!
     \brief Get mixing matrix
@@ -289,7 +630,7 @@ public:
 
     \return Mixing matrix
   */
-  mat get_mixing_matrix();
+  const mat &get_mixing_matrix() const;
 
   /*!
     \brief Get separating matrix
@@ -298,7 +639,7 @@ public:
 
     \return Separating matrix
   */
-  mat get_separating_matrix();
+  const mat &get_separating_matrix() const;
 
   /*!
     \brief Get separated signals
@@ -307,7 +648,19 @@ public:
 
     \return ICs
   */
-  mat get_independent_components();
+  const mat &get_independent_components() const;
+
+  /*!
+    \brief Write separated signals
+
+    Write the separated signals (Independent Components) chunk by chunk.
+    This is the only way to obtain them in streaming mode, where they are
+    computed with one more pass over the input.
+
+    \param writer (Output) Destination of the ICs
+    \return true on success and false otherwise
+  */
+  bool write_independent_components(ICA_Writer &writer);
 
   /*!
     \brief Get number of independent components
@@ -316,7 +669,16 @@ public:
 
     \return Number of ICs
   */
-  int get_nrof_independent_components();
+  int get_nrof_independent_components() const;
+
+  /*!
+    \brief Get number of threads
+
+    Return the number of threads set by set_num_threads().
+
+    \return Number of threads
+  */
+  int get_num_threads() const;
 
   /*!
     \brief Get nrIC first columns of the de-whitening matrix
@@ -325,7 +687,7 @@ public:
 
     \return Principal eigenvectors
   */
-  mat get_principal_eigenvectors();
+  const mat &get_principal_eigenvectors() const;
 
   /*!
     \brief Get the whitening matrix
@@ -334,7 +696,7 @@ public:
 
     \return Whitening matrix
   */
-  mat get_whitening_matrix();
+  const mat &get_whitening_matrix() const;
 
   /*!
     \brief Get the de-whitening matrix
@@ -343,7 +705,7 @@ public:
 
     \return Dewhitening matrix
   */
-  mat get_dewhitening_matrix();
+  const mat &get_dewhitening_matrix() const;
 
   /*!
     \brief Get whitened signals
@@ -352,14 +714,35 @@ public:
 
     \return Whitened signals
   */
-  mat get_white_sig();
+  const mat &get_white_sig() const;
 
 private:
 
+  //! Set default values for a signal with \c nrof_channels channels
+  void init(int nrof_channels);
+
   int approach, numOfIC, g, initState;
   bool finetune, stabilization, PCAonly;
   double a1, a2, mu, epsilon, sampleSize;
+  int sampling;
+  unsigned int samplingSeed;
+  double sampleGrowth;
   int maxNumIterations, maxFineTune;
+  int numThreads;
+  int chunkSize;
+  bool singlePrecision;
+  int refinementIterations;
+  int pcaMethod;
+  double pcaTolerance;
+
+  int deflBlock;
+  Fast_ICA_Callback callback;
+  void *callbackData;
+  Fast_ICA_Stats stats;
+
+  ICA_Reader *reader;
+  const mat *borrowedSig;
+  int numSamples;
 
   int firstEig, lastEig;
 
@@ -367,6 +750,9 @@ private:
 
   mat mixedSig, A, W, icasig;
 
+  // Returned with a warning when no ICA was performed
+  mat noResult;
+
   mat whiteningMatrix;
   mat dewhiteningMatrix;
   mat whitesig;
@@ -376,6 +762,288 @@ private:
 
 }; // class Fast_ICA
 
+//---------------------- Online FastICA --------------------------------------
+
+/*!
+\brief Online (incremental) Fast ICA over a sliding window
+\ingroup fastica
+
+Incremental variant of Fast_ICA for real-time separation, where the samples
+arrive block by block. push_samples() updates a running mean and covariance
+with exponential forgetting and keeps the most recent samples in a window of
+fixed size. update() then recomputes the whitening from the running
+covariance and runs a bounded number of symmetric fixed-point iterations over
+the window, starting from the separating matrix of the previous update. The
+cost of an update thus depends on the window size and the iteration bound
+only, not on the number of samples seen so far, and the order of the
+components is kept from one update to the next as long as the mixing varies
+slowly.
+
+Example:
+\code
+Online_Fast_ICA ica(2);
+ica.set_non_linearity(FICA_NONLIN_TANH);
+mat block, ICs;
+while (get_next_block(block)) {
+  ica.push_samples(block);
+  ica.update();
+  ica.separate_samples(block, ICs);
+}
+\endcode
+*/
+class ITPP_EXPORT Online_Fast_ICA
+{
+
+public:
+
+  /*!
+    \brief Constructor
+
+    \param nrof_channels (Input) Number of mixed signals, i.e. rows of the blocks
+    \param nrof_ics (Input) Number of ICs to compute, or 0 for as many as channels
+  */
+  Online_Fast_ICA(int nrof_channels, int nrof_ics = 0);
+
+  /*!
+    \brief Set non-linearity (default = FICA_NONLIN_POW3)
+
+    \param in_g (Input) Non-linearity. Can be selected from FICA_NONLIN_POW3, FICA_NONLIN_TANH, FICA_NONLIN_GAUSS or FICA_NONLIN_SKEW
+  */
+  void set_non_linearity(int in_g);
+
+  /*!
+    \brief Set \f$a_1\f$ parameter (default = 1)
+
+    \param fl_a1 (Input) Parameter \f$a_1\f$ from reference paper
+  */
+  void set_a1(double fl_a1);
+
+  /*!
+    \brief Set \f$a_2\f$ parameter (default = 1)
+
+    \param fl_a2 (Input) Parameter \f$a_2\f$ from reference paper
+  */
+  void set_a2(double fl_a2);
+
+  /*!
+    \brief Set convergence parameter \f$\epsilon\f$ (default = 0.0001)
+
+    \param fl_epsilon (Input) \f$\epsilon\f$ is convergence precision
+  */
+  void set_epsilon(double fl_epsilon);
+
+  /*!
+    \brief Set forgetting factor (default = FICA_ONLINE_FORGETTING)
+
+    The running statistics are weighted by \c lambda to the power of the age
+    of the samples, so that \f$1/(1-\lambda)\f$ is the effective memory in
+    samples. The forgetting is applied once per block pushed. A value of 1
+    gives the plain mean and covariance of all the samples pushed.
+
+    \param lambda (Input) Per-sample forgetting factor, in ]0, 1]
+  */
+  void set_forgetting_factor(double lambda);
+
+  /*!
+    \brief Set window size (default = FICA_ONLINE_WINDOW)
+
+    Set the number of most recent samples the fixed-point iterations run on.
+    Samples already pushed are discarded.
+
+    \param in_windowSize (Input) Number of samples of the window
+  */
+  void set_window_size(int in_windowSize);
+
+  /*!
+    \brief Set maximum number of iterations per update (default = FICA_ONLINE_ITERATIONS)
+
+    \param in_maxIterations (Input) Maximum number of fixed-point iterations run by update()
+  */
+  void set_max_iterations(int in_maxIterations);
+
+  /*!
+    \brief Set number of threads (default = 1)
+
+    \param in_numThreads (Input) Number of threads, see Fast_ICA::set_num_threads()
+  */
+  void set_num_threads(int in_numThreads);
+
+  /*!
+    \brief Add a block of samples
+
+    Update the running mean and covariance and append the samples to the
+    window.
+
+    \param block (Input) Mixed signals, one row per channel and one column per sample
+  */
+  void push_samples(const mat &block);
+
+  /*!
+    \brief Update the separation
+
+    Run at most the maximum number of iterations over the window, warm
+    started from the previous separating matrix.
+
+    \return true if the iterations converged and false otherwise
+  */
+  bool update();
+
+  /*!
+    \brief Forget all samples and the current separation
+  */
+  void reset();
+
+  /*!
+    \brief Separate a block of samples with the current separating matrix
+
+    \param block (Input) Mixed signals, one row per channel and one column per sample
+    \param out (Output) ICs, one row per component
+  */
+  void separate_samples(const mat &block, mat &out) const;
+
+  /*!
+    \brief Get mixing matrix
+
+    \return Mixing matrix of the last update
+  */
+  const mat &get_mixing_matrix() const;
+
+  /*!
+    \brief Get separating matrix
+
+    \return Separating matrix of the last update
+  */
+  const mat &get_separating_matrix() const;
+
+  /*!
+    \brief Get the whitening matrix
+
+    \return Whitening matrix of the last update
+  */
+  const mat &get_whitening_matrix() const;
+
+  /*!
+    \brief Get number of iterations of the last update
+
+    \return Number of fixed-point iterations run by the last update()
+  */
+  int get_nrof_iterations() const;
+
+private:
+
+  int nrof_channels, numOfIC;
+  int g;
+  double a1, a2;
+  double epsilon;
+  double lambda;
+  int windowSize, maxIterations, numThreads;
+
+  // Running statistics and total weight of the samples pushed
+  vec meanValue;
+  mat covarianceMatrix;
+  double weight;
+
+  // Circular buffer of the most recent samples
+  mat window;
+  int windowPos, windowFill;
+
+  int lastIterations;
+
+  mat A, W;
+  mat whiteningMatrix;
+  mat dewhiteningMatrix;
+  mat whiteWindow;
+
+}; // class Online_Fast_ICA
+
+//---------------------- Batch FastICA --------------------------------------
+
+/*!
+\brief Fast ICA of many independent small mixtures
+\ingroup fastica
+
+Separates a set of independent mixtures, e.g. short windows of a few channels
+recorded by many sensors, with the same parameters. The problems are
+dispatched over the threads, and each thread reuses its scratch buffers from
+one problem to the next. The random initial guesses are drawn from the
+calling thread before the dispatch, so that the results do not depend on the
+number of threads.
+
+Example:
+\code
+Array<mat> mixtures(nrof_windows), A, W;
+// ... fill the mixtures
+Fast_ICA_Batch ica;
+ica.set_non_linearity(FICA_NONLIN_TANH);
+ica.set_num_threads(8);
+bvec converged = ica.separate(mixtures, A, W);
+\endcode
+*/
+class ITPP_EXPORT Fast_ICA_Batch
+{
+
+public:
+
+  //! Constructor, with the same defaults as Fast_ICA
+  Fast_ICA_Batch();
+
+  //! Set approach : FICA_APPROACH_DEFL or FICA_APPROACH_SYMM (default)
+  void set_approach(int in_approach);
+
+  //! Set number of ICs to compute per problem, or 0 for as many as channels (default)
+  void set_nrof_independent_components(int in_nrIC);
+
+  //! Set non-linearity, see Fast_ICA::set_non_linearity()
+  void set_non_linearity(int in_g);
+
+  //! Set fine tuning true or false
+  void set_fine_tune(bool in_finetune);
+
+  //! Set parameter \f$a_1\f$ from reference paper
+  void set_a1(double fl_a1);
+
+  //! Set parameter \f$a_2\f$ from reference paper
+  void set_a2(double fl_a2);
+
+  //! Set parameter \f$\mu\f$ from reference paper
+  void set_mu(double fl_mu);
+
+  //! Set convergence precision \f$\epsilon\f$
+  void set_epsilon(double fl_epsilon);
+
+  //! Set stabilization mode true or false
+  void set_stabilization(bool in_stabilization);
+
+  //! Set maximum number of iterations per problem
+  void set_max_num_iterations(int in_maxNumIterations);
+
+  //! Set maximum number of iterations for fine tuning per problem
+  void set_max_fine_tune(int in_maxFineTune);
+
+  //! Set number of threads the problems are dispatched on (default = 1)
+  void set_num_threads(int in_numThreads);
+
+  /*!
+    \brief Separate all the mixtures
+
+    \param mixtures (Input) Mixed signals of each problem, one row per channel
+    \param A (Output) Mixing matrix of each problem
+    \param W (Output) Separating matrix of each problem
+    \return Convergence flag of each problem. Problems without any principal
+    component get empty matrices and a false flag
+  */
+  bvec separate(const Array<mat> &mixtures, Array<mat> &A, Array<mat> &W);
+
+private:
+
+  int approach, numOfIC, g;
+  bool finetune, stabilization;
+  double a1, a2, mu, epsilon;
+  int maxNumIterations, maxFineTune;
+  int numThreads;
+
+}; // class Fast_ICA_Batch
+
 } // namespace itpp
 
 
@@ -0,0 +1,116 @@
+/*!
+ * \file
+ * \brief Chunked sample readers and writers for streaming FastICA
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/signal/fastica_io.h>
+#include <itpp/base/matfunc.h>
+#include <itpp/base/itassert.h>
+
+
+namespace itpp
+{
+
+// ---------------------- ICA_SND_Reader ----------------------------------
+
+ICA_SND_Reader::ICA_SND_Reader(const char *fname)
+{
+  it_assert(file.open(fname), "ICA_SND_Reader: Cannot open file " << fname);
+  nrof_channels = file.get_description().get_num_channels();
+}
+
+int ICA_SND_Reader::channels() const { return nrof_channels; }
+
+void ICA_SND_Reader::rewind() { file.seek_read(0); }
+
+int ICA_SND_Reader::read(mat &chunk, int n)
+{
+  std::streamoff left = file.num_samples() - file.tell_read();
+  if (left < n) n = static_cast<int>(left);
+  if (n <= 0) {
+    chunk.set_size(nrof_channels, 0);
+    return 0;
+  }
+  // SND_In_File stores the channels columnwise
+  chunk = transpose(file.read(n));
+  it_assert(chunk.cols() == n, "ICA_SND_Reader::read(): Read error");
+  return n;
+}
+
+// ---------------------- ICA_SND_Writer ----------------------------------
+
+ICA_SND_Writer::ICA_SND_Writer(const char *fname, const Audio_Stream_Description &d)
+{
+  it_assert(file.open(fname, d), "ICA_SND_Writer: Cannot create file " << fname);
+}
+
+bool ICA_SND_Writer::write(const mat &chunk)
+{
+  return file.write(transpose(chunk));
+}
+
+// ---------------------- ICA_Raw_Reader ----------------------------------
+
+ICA_Raw_Reader::ICA_Raw_Reader(const std::string &fname, int in_nrof_channels)
+    : file(fname.c_str(), std::ios::in | std::ios::binary),
+      nrof_channels(in_nrof_channels)
+{
+  it_assert(file.is_open(), "ICA_Raw_Reader: Cannot open file " << fname);
+  it_assert(nrof_channels > 0, "ICA_Raw_Reader: Number of channels must be positive");
+}
+
+void ICA_Raw_Reader::rewind()
+{
+  file.clear();
+  file.seekg(0, std::ios::beg);
+}
+
+int ICA_Raw_Reader::read(mat &chunk, int n)
+{
+  // The interleaved samples map directly onto the column-major chunk
+  chunk.set_size(nrof_channels, n, false);
+  file.read(reinterpret_cast<char *>(chunk._data()),
+            static_cast<std::streamsize>(sizeof(double)) * nrof_channels * n);
+  int nread = static_cast<int>(file.gcount() / (sizeof(double) * nrof_channels));
+  if (nread < n) chunk.set_size(nrof_channels, nread, true);
+  return nread;
+}
+
+// ---------------------- ICA_Raw_Writer ----------------------------------
+
+ICA_Raw_Writer::ICA_Raw_Writer(const std::string &fname)
+    : file(fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc)
+{
+  it_assert(file.is_open(), "ICA_Raw_Writer: Cannot create file " << fname);
+}
+
+bool ICA_Raw_Writer::write(const mat &chunk)
+{
+  file.write(reinterpret_cast<const char *>(chunk._data()),
+             static_cast<std::streamsize>(sizeof(double)) * chunk.size());
+  return !file.fail();
+}
+
+} // namespace itpp
@@ -0,0 +1,165 @@
+/*!
+ * \file
+ * \brief Chunked sample readers and writers for streaming FastICA
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef FASTICA_IO_H
+#define FASTICA_IO_H
+
+#include <itpp/base/mat.h>
+#include <itpp/srccode/audiofile.h>
+#include <itpp/itexports.h>
+#include <fstream>
+#include <string>
+
+namespace itpp
+{
+
+/*!
+  \ingroup fastica
+  \brief Abstract reader of multichannel signals, one chunk at a time
+
+  Interface used by Fast_ICA in streaming mode. A chunk is a matrix with one
+  row per channel and one column per sample, i.e. the same layout as the
+  mixed signals given to Fast_ICA(mat). The reader is rewound and read
+  through once per pass over the data.
+*/
+class ITPP_EXPORT ICA_Reader
+{
+public:
+  //! Destructor
+  virtual ~ICA_Reader() {}
+  //! Number of channels, i.e. number of rows of each chunk
+  virtual int channels() const = 0;
+  //! Go back to the first sample
+  virtual void rewind() = 0;
+  /*!
+    \brief Read the next chunk
+
+    Read at most \c n samples starting at the current position into \c chunk,
+    which is resized to channels() x (number of samples read).
+
+    \return Number of samples read, 0 at the end of the signal
+  */
+  virtual int read(mat &chunk, int n) = 0;
+};
+
+/*!
+  \ingroup fastica
+  \brief Abstract writer of multichannel signals, one chunk at a time
+
+  Interface used by Fast_ICA::write_independent_components(). Chunks have
+  one row per channel and one column per sample.
+*/
+class ITPP_EXPORT ICA_Writer
+{
+public:
+  //! Destructor
+  virtual ~ICA_Writer() {}
+  //! Append the samples of \c chunk. Returns false on error
+  virtual bool write(const mat &chunk) = 0;
+};
+
+/*!
+  \ingroup fastica
+  \brief ICA_Reader over the channels of an SND (.au) audio file
+*/
+class ITPP_EXPORT ICA_SND_Reader : public ICA_Reader
+{
+public:
+  //! Open the audio file \c fname
+  ICA_SND_Reader(const char *fname);
+  //! Number of channels of the audio stream
+  virtual int channels() const;
+  //! Go back to the first sample
+  virtual void rewind();
+  //! Read the next chunk of at most \c n samples
+  virtual int read(mat &chunk, int n);
+private:
+  SND_In_File file;
+  int nrof_channels;
+};
+
+/*!
+  \ingroup fastica
+  \brief ICA_Writer to an SND (.au) audio file
+
+  The audio stream description must have as many channels as the chunks
+  written, i.e. the number of independent components.
+*/
+class ITPP_EXPORT ICA_SND_Writer : public ICA_Writer
+{
+public:
+  //! Create the audio file \c fname described by \c d
+  ICA_SND_Writer(const char *fname, const Audio_Stream_Description &d);
+  //! Append the samples of \c chunk
+  virtual bool write(const mat &chunk);
+private:
+  SND_Out_File file;
+};
+
+/*!
+  \ingroup fastica
+  \brief ICA_Reader over a raw binary file of interleaved doubles
+
+  The file holds samples one after the other, each sample being the values
+  of all \c nrof_channels channels stored as native doubles.
+*/
+class ITPP_EXPORT ICA_Raw_Reader : public ICA_Reader
+{
+public:
+  //! Open the raw file \c fname holding \c nrof_channels interleaved channels
+  ICA_Raw_Reader(const std::string &fname, int nrof_channels);
+  //! Number of channels
+  virtual int channels() const { return nrof_channels; }
+  //! Go back to the first sample
+  virtual void rewind();
+  //! Read the next chunk of at most \c n samples
+  virtual int read(mat &chunk, int n);
+private:
+  std::ifstream file;
+  int nrof_channels;
+};
+
+/*!
+  \ingroup fastica
+  \brief ICA_Writer to a raw binary file of interleaved doubles
+
+  Counterpart of ICA_Raw_Reader.
+*/
+class ITPP_EXPORT ICA_Raw_Writer : public ICA_Writer
+{
+public:
+  //! Create the raw file \c fname
+  ICA_Raw_Writer(const std::string &fname);
+  //! Append the samples of \c chunk
+  virtual bool write(const mat &chunk);
+private:
+  std::ofstream file;
+};
+
+} // namespace itpp
+
+#endif // #ifndef FASTICA_IO_H
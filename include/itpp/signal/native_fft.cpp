@@ -0,0 +1,635 @@
+/*!
+ * \file
+ * \brief Built-in FFT used when no FFT library is available
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <itpp/signal/native_fft.h>
+#include <itpp/base/math/misc.h>
+#include <itpp/base/math/vmath.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+// The kernels of native_fft_kernels.h are compiled for each instruction
+// set as those of vmath.cpp, and chosen with vmath_isa()
+#if defined(__GNUC__) && defined(__x86_64__)
+#  define NF_X86
+// The packs are inlined, never passed between functions
+#  pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#if defined(__GNUC__)
+#  define NF_INLINE inline __attribute__((always_inline))
+#  define NF_UNROLL _Pragma("GCC unroll 8")
+#elif defined(_MSC_VER)
+#  define NF_INLINE __forceinline
+#  define NF_UNROLL
+#else
+#  define NF_INLINE inline
+#  define NF_UNROLL
+#endif
+
+//! \cond
+
+namespace itpp
+{
+
+namespace native_fft
+{
+
+// Largest prime factor computed with a pass of its own radix. Lengths with
+// larger prime factors use Bluestein's algorithm.
+static const int nf_max_radix = 31;
+
+// Pass of radix r on sequences of stride s (see native_fft_kernels.h). The
+// twiddle factors w^(p * k) are stored at twr[(k - 1) * m + p] and twi[(k
+// - 1) * m + p]. For the radices above 5, rot holds cos(2 pi j / r) and
+// then sin(2 pi j / r) for 0 <= j < r.
+struct Nf_Pass
+{
+  int radix, s, m;
+  const double *twr, *twi, *rot;
+};
+
+// ----------------------------------------------------------------------
+// Kernels of each instruction set
+// ----------------------------------------------------------------------
+
+typedef void (*Nf_Pass_Kernel)(const Nf_Pass &, const double *, const double *,
+                               double *, double *);
+
+namespace nf_generic
+{
+typedef double Pack;
+typedef double Half;
+#include <itpp/signal/native_fft_kernels.h>
+}
+
+#if defined(NF_X86)
+typedef double nf_v2 __attribute__((vector_size(16)));
+typedef double nf_v4 __attribute__((vector_size(32)));
+typedef double nf_v8 __attribute__((vector_size(64)));
+
+namespace nf_sse2
+{
+typedef nf_v2 Pack;
+typedef double Half;
+#include <itpp/signal/native_fft_kernels.h>
+}
+
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx2,fma")
+#endif
+namespace nf_avx2
+{
+typedef nf_v4 Pack;
+typedef nf_v2 Half;
+#include <itpp/signal/native_fft_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#  pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+#  pragma GCC push_options
+#  pragma GCC target("avx512f")
+#endif
+namespace nf_avx512
+{
+typedef nf_v8 Pack;
+typedef nf_v4 Half;
+#include <itpp/signal/native_fft_kernels.h>
+}
+#if defined(__clang__)
+#  pragma clang attribute pop
+#else
+#  pragma GCC pop_options
+#endif
+#endif // NF_X86
+
+static Nf_Pass_Kernel nf_pass_kernel()
+{
+  switch (vmath_isa()) {
+#if defined(NF_X86)
+  case VMATH_AVX512:
+    return nf_avx512::nf_pass;
+  case VMATH_AVX2:
+    return nf_avx2::nf_pass;
+  case VMATH_SSE2:
+    return nf_sse2::nf_pass;
+#endif
+  default:
+    return nf_generic::nf_pass;
+  }
+}
+
+// ----------------------------------------------------------------------
+// Plans
+// ----------------------------------------------------------------------
+
+// Twiddle factors of the transforms of n points. A plan is never modified
+// once in the cache, so that it can be used by several threads at a time.
+struct Plan
+{
+  int n;
+  std::vector<Nf_Pass> passes;
+  // Twiddle factors and rotations of the passes
+  std::vector<double> tw;
+  // exp(-pi i k / n) for 0 <= k < n, used by the real transforms of 2n
+  // points: real parts followed by the imaginary parts
+  std::vector<double> rtw;
+  // Bluestein's algorithm: transform of sub->n points, exp(-pi i k^2 / n)
+  // for 0 <= k < n and transform of the conjugate chirp divided by sub->n
+  const Plan *sub;
+  std::vector<double> chirp;
+  std::vector<double> filter;
+};
+
+static bool nf_forward(const Plan &pl, double *xr, double *xi, double *yr,
+                       double *yi, double *work);
+
+// Points transformed together by Context::fft_many(), short sequences being
+// interleaved up to this size
+static const int nf_batch_points = 512;
+
+// Doubles of work space needed by nf_forward() besides the data
+static int nf_work_size(const Plan &pl)
+{
+  return pl.sub ? 4 * pl.sub->n : 0;
+}
+
+// Smallest 5-smooth number not less than n
+static int nf_smooth_size(int n)
+{
+  int best = 2 * n;
+  for (long f5 = 1; f5 < best; f5 *= 5)
+    for (long f35 = f5; f35 < best; f35 *= 3) {
+      long f = f35;
+      while (f < n)
+        f *= 2;
+      if (f < best)
+        best = int(f);
+    }
+  return best;
+}
+
+static Plan *nf_find(std::map<int, Plan *> &plans, int n);
+
+static Plan *nf_create(std::map<int, Plan *> &plans, int n)
+{
+  Plan *pl = new Plan;
+  pl->n = n;
+  pl->sub = 0;
+
+  pl->rtw.resize(2 * n);
+  for (int k = 0; k < n; k++) {
+    double a = -pi * k / n;
+    pl->rtw[k] = std::cos(a);
+    pl->rtw[n + k] = std::sin(a);
+  }
+
+  // Radix 4 first, so that the kernels work on packs from the second pass
+  std::vector<int> radices;
+  int k = n;
+  while (k % 4 == 0) {
+    radices.push_back(4);
+    k /= 4;
+  }
+  if (k % 2 == 0) {
+    radices.push_back(2);
+    k /= 2;
+  }
+  for (int r = 3; r <= nf_max_radix; r += 2) {
+    while (k % r == 0) {
+      radices.push_back(r);
+      k /= r;
+    }
+  }
+
+  if (k == 1) {
+    // Offsets of the tables in pl->tw, turned into pointers at the end
+    std::vector<int> offsets;
+    int s = 1;
+    int len = n;
+    for (std::size_t i = 0; i < radices.size(); i++) {
+      int r = radices[i];
+      int m = len / r;
+      Nf_Pass ps = {r, s, m, 0, 0, 0};
+      pl->passes.push_back(ps);
+      offsets.push_back(int(pl->tw.size()));
+      std::size_t t0 = pl->tw.size();
+      pl->tw.resize(t0 + 2 * (r - 1) * m);
+      for (int j = 1; j < r; j++)
+        for (int p = 0; p < m; p++) {
+          double a = -2 * pi * double((long(j) * p) % len) / len;
+          pl->tw[t0 + (j - 1) * m + p] = std::cos(a);
+          pl->tw[t0 + (r - 1) * m + (j - 1) * m + p] = std::sin(a);
+        }
+      if (r > 5) {
+        std::size_t r0 = pl->tw.size();
+        pl->tw.resize(r0 + 2 * r);
+        for (int j = 0; j < r; j++) {
+          pl->tw[r0 + j] = std::cos(2 * pi * j / r);
+          pl->tw[r0 + r + j] = std::sin(2 * pi * j / r);
+        }
+      }
+      s *= r;
+      len = m;
+    }
+    for (std::size_t i = 0; i < pl->passes.size(); i++) {
+      Nf_Pass &ps = pl->passes[i];
+      const double *t = &pl->tw[0] + offsets[i];
+      ps.twr = t;
+      ps.twi = t + (ps.radix - 1) * ps.m;
+      ps.rot = t + 2 * (ps.radix - 1) * ps.m;
+    }
+  }
+  else {
+    int m = nf_smooth_size(2 * n - 1);
+    const Plan *sub = nf_find(plans, m);
+    pl->sub = sub;
+    pl->chirp.resize(2 * n);
+    long k2 = 0;
+    for (int i = 0; i < n; i++) {
+      // k2 = i^2 mod 2n, so that the angle stays accurate
+      double a = -pi * double(k2) / n;
+      pl->chirp[i] = std::cos(a);
+      pl->chirp[n + i] = std::sin(a);
+      k2 += 2 * i + 1;
+      if (k2 >= 2 * long(n))
+        k2 -= 2 * long(n);
+    }
+    std::vector<double> w(4 * m + nf_work_size(*sub), 0.0);
+    double *br = &w[0], *bi = br + m;
+    for (int i = 0; i < n; i++) {
+      br[i] = pl->chirp[i] / m;
+      bi[i] = -pl->chirp[n + i] / m;
+      if (i > 0) {
+        br[m - i] = br[i];
+        bi[m - i] = bi[i];
+      }
+    }
+    bool in_y = nf_forward(*sub, br, bi, br + 2 * m, br + 3 * m, br + 4 * m);
+    const double *fr = in_y ? br + 2 * m : br;
+    pl->filter.assign(fr, fr + 2 * m);
+  }
+  return pl;
+}
+
+// Plan of n points, created if needed; the caller holds the cache lock
+static Plan *nf_find(std::map<int, Plan *> &plans, int n)
+{
+  std::map<int, Plan *>::iterator i = plans.find(n);
+  if (i != plans.end())
+    return i->second;
+  Plan *pl = nf_create(plans, n);
+  plans[n] = pl;
+  return pl;
+}
+
+// Process-wide cache of the plans, deleted at exit
+class Nf_Cache
+{
+public:
+#ifdef _OPENMP
+  Nf_Cache() { omp_init_lock(&lck); }
+  ~Nf_Cache() { clear(); omp_destroy_lock(&lck); }
+  const Plan *get(int n) {
+    omp_set_lock(&lck);
+    const Plan *pl = nf_find(plans, n);
+    omp_unset_lock(&lck);
+    return pl;
+  }
+#else
+  Nf_Cache() {}
+  ~Nf_Cache() { clear(); }
+  const Plan *get(int n) { return nf_find(plans, n); }
+#endif
+private:
+  Nf_Cache(const Nf_Cache &);
+  Nf_Cache &operator=(const Nf_Cache &);
+  void clear() {
+    for (std::map<int, Plan *>::iterator i = plans.begin(); i != plans.end(); ++i)
+      delete i->second;
+  }
+  std::map<int, Plan *> plans;
+#ifdef _OPENMP
+  omp_lock_t lck;
+#endif
+};
+
+static const Plan *nf_get_plan(int n)
+{
+  static Nf_Cache cache;
+  return cache.get(n);
+}
+
+// ----------------------------------------------------------------------
+// Transforms
+// ----------------------------------------------------------------------
+
+// Forward transform of the n points of xr and xi, yr and yi being used as
+// scratch space and work holding nf_work_size() doubles. Returns true if
+// the result is in yr and yi, false if it is in xr and xi.
+static bool nf_forward(const Plan &pl, double *xr, double *xi, double *yr,
+                       double *yi, double *work)
+{
+  if (!pl.sub) {
+    Nf_Pass_Kernel pass = nf_pass_kernel();
+    for (std::size_t i = 0; i < pl.passes.size(); i++) {
+      pass(pl.passes[i], xr, xi, yr, yi);
+      std::swap(xr, yr);
+      std::swap(xi, yi);
+    }
+    return (pl.passes.size() % 2) != 0;
+  }
+
+  // Bluestein: X = c * (conj(c) (*) (c * x)), (*) being the circular
+  // convolution of m points computed with two transforms
+  const int n = pl.n, m = pl.sub->n;
+  const double *cr = &pl.chirp[0], *ci = cr + n;
+  const double *fr = &pl.filter[0], *fi = fr + m;
+  double *ar = work, *ai = work + m, *br = work + 2 * m, *bi = work + 3 * m;
+  for (int i = 0; i < n; i++) {
+    ar[i] = xr[i] * cr[i] - xi[i] * ci[i];
+    ai[i] = xr[i] * ci[i] + xi[i] * cr[i];
+  }
+  std::memset(ar + n, 0, (m - n) * sizeof(double));
+  std::memset(ai + n, 0, (m - n) * sizeof(double));
+  if (nf_forward(*pl.sub, ar, ai, br, bi, 0)) {
+    std::swap(ar, br);
+    std::swap(ai, bi);
+  }
+  // The inverse transform is the conjugate of the forward transform of the
+  // conjugate
+  for (int i = 0; i < m; i++) {
+    double re = ar[i] * fr[i] - ai[i] * fi[i];
+    double im = ar[i] * fi[i] + ai[i] * fr[i];
+    ar[i] = re;
+    ai[i] = -im;
+  }
+  if (nf_forward(*pl.sub, ar, ai, br, bi, 0)) {
+    std::swap(ar, br);
+    std::swap(ai, bi);
+  }
+  for (int i = 0; i < n; i++) {
+    xr[i] = ar[i] * cr[i] + ai[i] * ci[i];
+    xi[i] = ar[i] * ci[i] - ai[i] * cr[i];
+  }
+  return false;
+}
+
+// Forward transforms of b sequences of pl.n points interleaved in xr and
+// xi, the point i of the sequence v being at v + b * i. A pass over the b
+// sequences is the pass of stride b * s, so that the kernels are vectorized
+// across the sequences. pl must not use Bluestein's algorithm.
+static bool nf_forward_many(const Plan &pl, int b, double *xr, double *xi,
+                            double *yr, double *yi)
+{
+  Nf_Pass_Kernel pass = nf_pass_kernel();
+  for (std::size_t i = 0; i < pl.passes.size(); i++) {
+    Nf_Pass ps = pl.passes[i];
+    ps.s *= b;
+    pass(ps, xr, xi, yr, yi);
+    std::swap(xr, yr);
+    std::swap(xi, yi);
+  }
+  return (pl.passes.size() % 2) != 0;
+}
+
+Context::Context() : _plan(0) {}
+
+void Context::reset()
+{
+  _plan = 0;
+  std::vector<double>().swap(_work);
+}
+
+const Plan *Context::plan(int n)
+{
+  if (!_plan || (_plan->n != n)) {
+    _plan = nf_get_plan(n);
+    std::size_t size = 4 * std::size_t(n) + nf_work_size(*_plan);
+    if (_work.size() < size)
+      _work.resize(size);
+  }
+  return _plan;
+}
+
+double *Context::work(std::size_t size)
+{
+  if (_work.size() < size)
+    _work.resize(size);
+  return &_work[0];
+}
+
+void Context::fft(int n, const std::complex<double> *in,
+                  std::complex<double> *out, int sign)
+{
+  const Plan &pl = *plan(n);
+  double *xr = &_work[0], *xi = xr + n, *yr = xr + 2 * n, *yi = xr + 3 * n;
+  // The backward transform is the conjugate of the forward transform of
+  // the conjugate
+  double c = (sign > 0) ? -1.0 : 1.0;
+  for (int i = 0; i < n; i++) {
+    xr[i] = in[i].real();
+    xi[i] = c * in[i].imag();
+  }
+  if (nf_forward(pl, xr, xi, yr, yi, xr + 4 * n)) {
+    xr = yr;
+    xi = yi;
+  }
+  for (int i = 0; i < n; i++)
+    out[i] = std::complex<double>(xr[i], c * xi[i]);
+}
+
+void Context::fft_many(int n, int howmany, const std::complex<double> *in,
+                       int istride, int idist, std::complex<double> *out,
+                       int ostride, int odist, int sign)
+{
+  const Plan &pl = *plan(n);
+  if (pl.sub || (howmany == 1)) {
+    // One sequence at a time, copied after the work space of fft()
+    std::size_t w = 4 * std::size_t(n) + nf_work_size(pl);
+    std::complex<double> *v =
+      reinterpret_cast<std::complex<double> *>(work(w + 2 * n) + w);
+    for (int t = 0; t < howmany; t++) {
+      const std::complex<double> *x = in + std::ptrdiff_t(t) * idist;
+      std::complex<double> *y = out + std::ptrdiff_t(t) * odist;
+      for (int i = 0; i < n; i++)
+        v[i] = x[std::ptrdiff_t(i) * istride];
+      fft(n, v, v, sign);
+      for (int i = 0; i < n; i++)
+        y[std::ptrdiff_t(i) * ostride] = v[i];
+    }
+    return;
+  }
+
+  // Sequences per group, a multiple of the widest pack when possible
+  int b = std::max(nf_batch_points / n, 1);
+  if (b > 8)
+    b -= b % 8;
+  b = std::min(b, howmany);
+  double *xr = work(4 * std::size_t(n) * b);
+  const double c = (sign > 0) ? -1.0 : 1.0;
+  for (int t0 = 0; t0 < howmany; t0 += b) {
+    const int g = std::min(b, howmany - t0);
+    double *gr = xr, *gi = xr + g * n, *yr = xr + 2 * g * n, *yi = xr + 3 * g * n;
+    for (int v = 0; v < g; v++) {
+      const std::complex<double> *x = in + std::ptrdiff_t(t0 + v) * idist;
+      for (int i = 0; i < n; i++) {
+        gr[v + g * i] = x[std::ptrdiff_t(i) * istride].real();
+        gi[v + g * i] = c * x[std::ptrdiff_t(i) * istride].imag();
+      }
+    }
+    if (nf_forward_many(pl, g, gr, gi, yr, yi)) {
+      gr = yr;
+      gi = yi;
+    }
+    for (int v = 0; v < g; v++) {
+      std::complex<double> *y = out + std::ptrdiff_t(t0 + v) * odist;
+      for (int i = 0; i < n; i++)
+        y[std::ptrdiff_t(i) * ostride] = std::complex<double>(gr[v + g * i],
+                                                              c * gi[v + g * i]);
+    }
+  }
+}
+
+// The real transforms of even lengths n = 2h go through a complex transform
+// of h points: Z = fft(x[2j] + i x[2j + 1]) and X[k] = E[k] + w^k O[k],
+// where w = exp(-2 pi i / n), E[k] = (Z[k] + conj(Z[h - k])) / 2 is the
+// transform of the even points and O[k] = (Z[k] - conj(Z[h - k])) / 2i that
+// of the odd points.
+void Context::fft_real(int n, const double *in, std::complex<double> *out)
+{
+  if (n % 2) {
+    const Plan &pl = *plan(n);
+    double *xr = &_work[0], *xi = xr + n, *yr = xr + 2 * n, *yi = xr + 3 * n;
+    for (int i = 0; i < n; i++) {
+      xr[i] = in[i];
+      xi[i] = 0.0;
+    }
+    if (nf_forward(pl, xr, xi, yr, yi, xr + 4 * n)) {
+      xr = yr;
+      xi = yi;
+    }
+    for (int i = 0; i < n; i++)
+      out[i] = std::complex<double>(xr[i], xi[i]);
+    return;
+  }
+
+  const int h = n / 2;
+  const Plan &pl = *plan(h);
+  double *zr = &_work[0], *zi = zr + h, *yr = zr + 2 * h, *yi = zr + 3 * h;
+  for (int j = 0; j < h; j++) {
+    zr[j] = in[2 * j];
+    zi[j] = in[2 * j + 1];
+  }
+  if (nf_forward(pl, zr, zi, yr, yi, zr + 4 * h)) {
+    zr = yr;
+    zi = yi;
+  }
+  const double *wr = &pl.rtw[0], *wi = wr + h;
+  for (int k = 0; k <= h / 2; k++) {
+    int l = (k == 0) ? 0 : h - k;
+    // E and O of k, and their values for h - k
+    double er = 0.5 * (zr[k] + zr[l]), ei = 0.5 * (zi[k] - zi[l]);
+    double or_ = 0.5 * (zi[k] + zi[l]), oi = -0.5 * (zr[k] - zr[l]);
+    double tr = or_ * wr[k] - oi * wi[k], ti = or_ * wi[k] + oi * wr[k];
+    out[k] = std::complex<double>(er + tr, ei + ti);
+    if (k == 0)
+      out[h] = std::complex<double>(er - tr, ei - ti);
+    else {
+      // E[h - k] = conj(E[k]), O[h - k] = conj(O[k]), w^(h - k) = -conj(w^k)
+      out[l] = std::complex<double>(er - tr, ti - ei);
+    }
+  }
+  for (int k = 1; k < h; k++)
+    out[n - k] = std::conj(out[k]);
+}
+
+void Context::ifft_real(int n, const std::complex<double> *in, double *out)
+{
+  if (n % 2) {
+    const Plan &pl = *plan(n);
+    double *xr = &_work[0], *xi = xr + n, *yr = xr + 2 * n, *yi = xr + 3 * n;
+    // Conjugate of the Hermitian spectrum
+    xr[0] = in[0].real();
+    xi[0] = -in[0].imag();
+    for (int k = 1; k <= n / 2; k++) {
+      xr[k] = xr[n - k] = in[k].real();
+      xi[k] = -in[k].imag();
+      xi[n - k] = in[k].imag();
+    }
+    if (nf_forward(pl, xr, xi, yr, yi, xr + 4 * n))
+      xr = yr;
+    for (int i = 0; i < n; i++)
+      out[i] = xr[i];
+    return;
+  }
+
+  // Z[k] = E[k] + i O[k], E[k] = X[k] + X[k + h] and O[k] = (X[k] - X[k +
+  // h]) / w^k, scaled by 2 so that the result is scaled by n
+  const int h = n / 2;
+  const Plan &pl = *plan(h);
+  double *zr = &_work[0], *zi = zr + h, *yr = zr + 2 * h, *yi = zr + 3 * h;
+  const double *wr = &pl.rtw[0], *wi = wr + h;
+  for (int k = 0; k < h; k++) {
+    // X[k + h] = conj(X[h - k])
+    double ar = in[k].real(), ai = in[k].imag();
+    double br = in[h - k].real(), bi = -in[h - k].imag();
+    double dr = ar - br, di = ai - bi;
+    double or_ = dr * wr[k] + di * wi[k], oi = di * wr[k] - dr * wi[k];
+    // Conjugated for the backward transform
+    zr[k] = ar + br - oi;
+    zi[k] = -(ai + bi + or_);
+  }
+  if (nf_forward(pl, zr, zi, yr, yi, zr + 4 * h)) {
+    zr = yr;
+    zi = yi;
+  }
+  for (int j = 0; j < h; j++) {
+    out[2 * j] = zr[j];
+    out[2 * j + 1] = -zi[j];
+  }
+}
+
+} // namespace native_fft
+
+} // namespace itpp
+
+//! \endcond
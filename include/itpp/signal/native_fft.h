@@ -0,0 +1,96 @@
+/*!
+ * \file
+ * \brief Built-in FFT used when no FFT library is available
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef NATIVE_FFT_H
+#define NATIVE_FFT_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+//! \cond
+
+// Mixed-radix FFT of any length. Lengths whose prime factors are at most
+// 31 are computed with Stockham passes of radix 2, 3, 4, 5 and, for larger
+// factors, of a generic odd radix. Other lengths use Bluestein's algorithm
+// with a 5-smooth length. The passes are vectorized with the kernels of the
+// instruction set chosen by vmath_isa().
+//
+// The twiddle factors of each length are computed once and kept in a
+// process-wide cache, which is only locked when a Context changes of
+// length. The transforms themselves need no lock: each thread (or each
+// context of transforms.cpp) owns a Context holding its work space.
+
+namespace itpp
+{
+
+namespace native_fft
+{
+
+struct Plan;
+
+class Context
+{
+public:
+  Context();
+
+  // Forward (sign = -1) or backward (sign = +1) transform of n points,
+  // in and out may be equal. The backward transform is not scaled.
+  void fft(int n, const std::complex<double> *in, std::complex<double> *out,
+           int sign);
+  // Forward transform of n real points, out receiving all the n points
+  void fft_real(int n, const double *in, std::complex<double> *out);
+  // Backward transform of a Hermitian spectrum, of which only the points 0
+  // to n / 2 are read. The result is not scaled.
+  void ifft_real(int n, const std::complex<double> *in, double *out);
+
+  // howmany transforms of n points, the point i of the transform t being
+  // in[t * idist + i * istride] and out[t * odist + i * ostride]. The
+  // transforms are computed together, so that the passes are vectorized
+  // across them. in and out may be equal if they have the same layout.
+  void fft_many(int n, int howmany, const std::complex<double> *in,
+                int istride, int idist, std::complex<double> *out,
+                int ostride, int odist, int sign);
+
+  // Releases the work space
+  void reset();
+
+private:
+  const Plan *plan(int n);
+  double *work(std::size_t size);
+
+  const Plan *_plan;
+  std::vector<double> _work;
+};
+
+} // namespace native_fft
+
+} // namespace itpp
+
+//! \endcond
+
+#endif // #ifndef NATIVE_FFT_H
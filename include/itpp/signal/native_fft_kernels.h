@@ -0,0 +1,304 @@
+/*!
+ * \file
+ * \brief Kernels of the built-in FFT
+ *
+ * -------------------------------------------------------------------------
+ *
+ * Copyright (C) 1995-2010  (see AUTHORS file for a list of contributors)
+ *
+ * This file is part of IT++ - a C++ library of mathematical, signal
+ * processing, speech processing, and communications classes and functions.
+ *
+ * IT++ is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * IT++ is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with IT++.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------
+ */
+
+// No include guard: this file is included by native_fft.cpp once for each
+// instruction set, in a namespace defining the types Pack and Half of the
+// packs of doubles, Half having half the width of Pack (or being double).
+//
+// A pass of radix r reads r sequences of s * m points and writes m
+// sequences of s * r points:
+//   y[q + s * (r * p + k)] = w^(p * k) * sum_j x[q + s * (p + j * m)] z^(j * k)
+// where z = exp(-2 pi i / r), w = exp(-2 pi i / (r * m)), 0 <= q < s and
+// 0 <= p < m. The loop on q is vectorized with the widest pack dividing s.
+// The first pass, where s = 1, is vectorized on p instead.
+
+// ----------------------------------------------------------------------
+// Pack operations
+// ----------------------------------------------------------------------
+
+template<class V>
+NF_INLINE V nf_load(const double *p)
+{
+  V v;
+  std::memcpy(&v, p, sizeof(V));
+  return v;
+}
+
+template<class V>
+NF_INLINE void nf_store(double *p, V v)
+{
+  std::memcpy(p, &v, sizeof(V));
+}
+
+// c - 0 folds to a broadcast of c, unlike c + 0 which differs for -0
+template<class V>
+NF_INLINE V nf_set(double c)
+{
+  return c - V();
+}
+
+// ----------------------------------------------------------------------
+// Butterflies
+// ----------------------------------------------------------------------
+
+// In-place transform of the R points (ar[j], ai[j]) for R = 2, 3, 4 and 5,
+// or of the r points for R = 0, r being odd
+template<class V, int R> struct Nf_Butterfly;
+
+template<class V> struct Nf_Butterfly<V, 2>
+{
+  static NF_INLINE void apply(int, const double *, V *ar, V *ai) {
+    V tr = ar[0] - ar[1], ti = ai[0] - ai[1];
+    ar[0] += ar[1];
+    ai[0] += ai[1];
+    ar[1] = tr;
+    ai[1] = ti;
+  }
+};
+
+template<class V> struct Nf_Butterfly<V, 3>
+{
+  static NF_INLINE void apply(int, const double *, V *ar, V *ai) {
+    const V c = nf_set<V>(-0.5);
+    const V sn = nf_set<V>(0.86602540378443864676);
+    V tr = ar[1] + ar[2], ti = ai[1] + ai[2];
+    V ur = ar[0] + c * tr, ui = ai[0] + c * ti;
+    V vr = sn * (ar[1] - ar[2]), vi = sn * (ai[1] - ai[2]);
+    ar[0] += tr;
+    ai[0] += ti;
+    ar[1] = ur + vi;
+    ai[1] = ui - vr;
+    ar[2] = ur - vi;
+    ai[2] = ui + vr;
+  }
+};
+
+template<class V> struct Nf_Butterfly<V, 4>
+{
+  static NF_INLINE void apply(int, const double *, V *ar, V *ai) {
+    V t0r = ar[0] + ar[2], t0i = ai[0] + ai[2];
+    V t1r = ar[0] - ar[2], t1i = ai[0] - ai[2];
+    V t2r = ar[1] + ar[3], t2i = ai[1] + ai[3];
+    V t3r = ar[1] - ar[3], t3i = ai[1] - ai[3];
+    ar[0] = t0r + t2r;
+    ai[0] = t0i + t2i;
+    ar[1] = t1r + t3i;
+    ai[1] = t1i - t3r;
+    ar[2] = t0r - t2r;
+    ai[2] = t0i - t2i;
+    ar[3] = t1r - t3i;
+    ai[3] = t1i + t3r;
+  }
+};
+
+template<class V> struct Nf_Butterfly<V, 5>
+{
+  static NF_INLINE void apply(int, const double *, V *ar, V *ai) {
+    const V c1 = nf_set<V>(0.30901699437494742410);
+    const V c2 = nf_set<V>(-0.80901699437494742410);
+    const V s1 = nf_set<V>(0.95105651629515357212);
+    const V s2 = nf_set<V>(0.58778525229247312917);
+    V t1r = ar[1] + ar[4], t1i = ai[1] + ai[4];
+    V t2r = ar[2] + ar[3], t2i = ai[2] + ai[3];
+    V t3r = ar[1] - ar[4], t3i = ai[1] - ai[4];
+    V t4r = ar[2] - ar[3], t4i = ai[2] - ai[3];
+    V u1r = ar[0] + c1 * t1r + c2 * t2r, u1i = ai[0] + c1 * t1i + c2 * t2i;
+    V u2r = ar[0] + c2 * t1r + c1 * t2r, u2i = ai[0] + c2 * t1i + c1 * t2i;
+    V v1r = s1 * t3r + s2 * t4r, v1i = s1 * t3i + s2 * t4i;
+    V v2r = s2 * t3r - s1 * t4r, v2i = s2 * t3i - s1 * t4i;
+    ar[0] += t1r + t2r;
+    ai[0] += t1i + t2i;
+    ar[1] = u1r + v1i;
+    ai[1] = u1i - v1r;
+    ar[2] = u2r + v2i;
+    ai[2] = u2i - v2r;
+    ar[3] = u2r - v2i;
+    ai[3] = u2i + v2r;
+    ar[4] = u1r - v1i;
+    ai[4] = u1i + v1r;
+  }
+};
+
+// Odd radix r up to nf_max_radix. For 0 < k <= h = (r - 1) / 2 the outputs
+// k and r - k are u -/+ i v, where u = x_0 + sum_j cos(2 pi j k / r) (x_j +
+// x_(r-j)) and v = sum_j sin(2 pi j k / r) (x_j - x_(r-j)).
+template<class V> struct Nf_Butterfly<V, 0>
+{
+  static NF_INLINE void apply(int r, const double *rot, V *ar, V *ai) {
+    const int h = (r - 1) / 2;
+    const double *cs = rot;
+    const double *sn = rot + r;
+    V tr[nf_max_radix / 2], ti[nf_max_radix / 2];
+    V dr[nf_max_radix / 2], di[nf_max_radix / 2];
+    V b0r = ar[0], b0i = ai[0];
+    for (int j = 1; j <= h; j++) {
+      tr[j - 1] = ar[j] + ar[r - j];
+      ti[j - 1] = ai[j] + ai[r - j];
+      dr[j - 1] = ar[j] - ar[r - j];
+      di[j - 1] = ai[j] - ai[r - j];
+      b0r += tr[j - 1];
+      b0i += ti[j - 1];
+    }
+    for (int k = 1; k <= h; k++) {
+      V ur = ar[0], ui = ai[0];
+      V vr = nf_set<V>(0.0), vi = nf_set<V>(0.0);
+      int jk = 0;
+      for (int j = 1; j <= h; j++) {
+        jk += k;
+        if (jk >= r)
+          jk -= r;
+        V c = nf_set<V>(cs[jk]), sj = nf_set<V>(sn[jk]);
+        ur += c * tr[j - 1];
+        ui += c * ti[j - 1];
+        vr += sj * dr[j - 1];
+        vi += sj * di[j - 1];
+      }
+      ar[k] = ur + vi;
+      ai[k] = ui - vr;
+      ar[r - k] = ur - vi;
+      ai[r - k] = ui + vr;
+    }
+    ar[0] = b0r;
+    ai[0] = b0i;
+  }
+};
+
+// ----------------------------------------------------------------------
+// Passes
+// ----------------------------------------------------------------------
+
+// Pass vectorized on q, s being a multiple of the width of V
+template<class V, int R>
+static void nf_pass_q(const Nf_Pass &ps, const double *xr, const double *xi,
+                      double *yr, double *yi)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const int n = R ? R : nf_max_radix;
+  const int r = R ? R : ps.radix;
+  const int s = ps.s, m = ps.m, sm = s * m;
+  V ar[n], ai[n], wr[n], wi[n];
+  for (int p = 0; p < m; p++) {
+    NF_UNROLL
+    for (int k = 1; k < r; k++) {
+      wr[k] = nf_set<V>(ps.twr[(k - 1) * m + p]);
+      wi[k] = nf_set<V>(ps.twi[(k - 1) * m + p]);
+    }
+    for (int q = 0; q < s; q += w) {
+      const int i = q + s * p;
+      const int o = q + r * s * p;
+      NF_UNROLL
+      for (int j = 0; j < r; j++) {
+        ar[j] = nf_load<V>(xr + i + j * sm);
+        ai[j] = nf_load<V>(xi + i + j * sm);
+      }
+      Nf_Butterfly<V, R>::apply(r, ps.rot, ar, ai);
+      nf_store(yr + o, ar[0]);
+      nf_store(yi + o, ai[0]);
+      NF_UNROLL
+      for (int k = 1; k < r; k++) {
+        nf_store(yr + o + k * s, ar[k] * wr[k] - ai[k] * wi[k]);
+        nf_store(yi + o + k * s, ar[k] * wi[k] + ai[k] * wr[k]);
+      }
+    }
+  }
+}
+
+// Pass of stride s = 1 vectorized on p, m being a multiple of the width of
+// V. The outputs of consecutive butterflies are interleaved through a
+// buffer.
+template<class V, int R>
+static void nf_pass_p(const Nf_Pass &ps, const double *xr, const double *xi,
+                      double *yr, double *yi)
+{
+  const int w = sizeof(V) / sizeof(double);
+  const int n = R ? R : nf_max_radix;
+  const int r = R ? R : ps.radix;
+  const int m = ps.m;
+  V ar[n], ai[n];
+  double br[n][w], bi[n][w];
+  for (int p = 0; p < m; p += w) {
+    NF_UNROLL
+    for (int j = 0; j < r; j++) {
+      ar[j] = nf_load<V>(xr + p + j * m);
+      ai[j] = nf_load<V>(xi + p + j * m);
+    }
+    Nf_Butterfly<V, R>::apply(r, ps.rot, ar, ai);
+    nf_store(br[0], ar[0]);
+    nf_store(bi[0], ai[0]);
+    NF_UNROLL
+    for (int k = 1; k < r; k++) {
+      V wr = nf_load<V>(ps.twr + (k - 1) * m + p);
+      V wi = nf_load<V>(ps.twi + (k - 1) * m + p);
+      nf_store(br[k], ar[k] * wr - ai[k] * wi);
+      nf_store(bi[k], ar[k] * wi + ai[k] * wr);
+    }
+    NF_UNROLL
+    for (int l = 0; l < w; l++)
+      NF_UNROLL
+      for (int k = 0; k < r; k++) {
+        yr[r * (p + l) + k] = br[k][l];
+        yi[r * (p + l) + k] = bi[k][l];
+      }
+  }
+}
+
+template<int R>
+static void nf_pass_r(const Nf_Pass &ps, const double *xr, const double *xi,
+                      double *yr, double *yi)
+{
+  const int wp = sizeof(Pack) / sizeof(double);
+  const int wh = sizeof(Half) / sizeof(double);
+  if (ps.s % wp == 0)
+    nf_pass_q<Pack, R>(ps, xr, xi, yr, yi);
+  else if (ps.s % wh == 0)
+    nf_pass_q<Half, R>(ps, xr, xi, yr, yi);
+  else if ((ps.s == 1) && (ps.m % wp == 0))
+    nf_pass_p<Pack, R>(ps, xr, xi, yr, yi);
+  else
+    nf_pass_q<double, R>(ps, xr, xi, yr, yi);
+}
+
+static void nf_pass(const Nf_Pass &ps, const double *xr, const double *xi,
+                    double *yr, double *yi)
+{
+  switch (ps.radix) {
+  case 2:
+    nf_pass_r<2>(ps, xr, xi, yr, yi);
+    break;
+  case 3:
+    nf_pass_r<3>(ps, xr, xi, yr, yi);
+    break;
+  case 4:
+    nf_pass_r<4>(ps, xr, xi, yr, yi);
+    break;
+  case 5:
+    nf_pass_r<5>(ps, xr, xi, yr, yi);
+    break;
+  default:
+    nf_pass_r<0>(ps, xr, xi, yr, yi);
+  }
+}
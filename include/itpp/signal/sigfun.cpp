@@ -264,62 +264,44 @@ mat cov(const mat &X, bool is_zero_mean)
   return R;
 }
 
-vec spectrum(const vec &v, int nfft, int noverlap)
+// Welch estimate with the window w of energy w_energy, the frames being
+// transformed in one batch
+static vec welch_spectrum(const vec &v, const vec &w, double w_energy,
+                          int noverlap)
 {
-  it_assert_debug(pow2i(levels2bits(nfft)) == nfft,
-                  "nfft must be a power of two in spectrum()!");
-
-  vec P(nfft / 2 + 1), w(nfft), wd(nfft);
-
-  P = 0.0;
-  w = hanning(nfft);
-  double w_energy = nfft == 1 ? 1 : (nfft + 1) * .375; // Hanning energy
+  int nfft = w.size();
+  vec P;
 
   if (nfft > v.size()) {
     P = sqr(abs(fft(to_cvec(elem_mult(zero_pad(v, nfft), w)))(0, nfft / 2)));
     P /= w_energy;
   }
   else {
-    int k = (v.size() - noverlap) / (nfft - noverlap), idx = 0;
-    for (int i = 0; i < k; i++) {
-      wd = elem_mult(v(idx, idx + nfft - 1), w);
-      P += sqr(abs(fft(to_cvec(wd))(0, nfft / 2)));
-      idx += nfft - noverlap;
-    }
-    P /= k * w_energy;
+    cmat S = stft(v, w, nfft - noverlap);
+    P = sum(sqr(S), 2);
+    P /= S.cols() * w_energy;
   }
 
   P.set_size(nfft / 2 + 1, true);
   return P;
 }
 
+vec spectrum(const vec &v, int nfft, int noverlap)
+{
+  it_assert_debug(pow2i(levels2bits(nfft)) == nfft,
+                  "nfft must be a power of two in spectrum()!");
+
+  double w_energy = nfft == 1 ? 1 : (nfft + 1) * .375; // Hanning energy
+  return welch_spectrum(v, hanning(nfft), w_energy, noverlap);
+}
+
 vec spectrum(const vec &v, const vec &w, int noverlap)
 {
   int nfft = w.size();
   it_assert_debug(pow2i(levels2bits(nfft)) == nfft,
                   "The window size must be a power of two in spectrum()!");
 
-  vec P(nfft / 2 + 1), wd(nfft);
-
-  P = 0.0;
-  double w_energy = energy(w);
-
-  if (nfft > v.size()) {
-    P = sqr(abs(fft(to_cvec(elem_mult(zero_pad(v, nfft), w)))(0, nfft / 2)));
-    P /= w_energy;
-  }
-  else {
-    int k = (v.size() - noverlap) / (nfft - noverlap), idx = 0;
-    for (int i = 0; i < k; i++) {
-      wd = elem_mult(v(idx, idx + nfft - 1), w);
-      P += sqr(abs(fft(to_cvec(wd))(0, nfft / 2)));
-      idx += nfft - noverlap;
-    }
-    P /= k * w_energy;
-  }
-
-  P.set_size(nfft / 2 + 1, true);
-  return P;
+  return welch_spectrum(v, w, energy(w), noverlap);
 }
 
 vec filter_spectrum(const vec &a, int nfft)
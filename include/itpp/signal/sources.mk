@@ -1,5 +1,10 @@
+noinst_h_signal_sources = \
+	$(top_srcdir)/itpp/signal/native_fft.h \
+	$(top_srcdir)/itpp/signal/native_fft_kernels.h
+
 h_signal_sources = \
 	$(top_srcdir)/itpp/signal/fastica.h \
+	$(top_srcdir)/itpp/signal/fastica_io.h \
 	$(top_srcdir)/itpp/signal/filter_design.h \
 	$(top_srcdir)/itpp/signal/filter.h \
 	$(top_srcdir)/itpp/signal/freq_filt.h \
@@ -12,9 +17,11 @@ h_signal_sources = \
 
 cpp_signal_sources = \
 	$(top_srcdir)/itpp/signal/fastica.cpp \
+	$(top_srcdir)/itpp/signal/fastica_io.cpp \
 	$(top_srcdir)/itpp/signal/filter_design.cpp \
 	$(top_srcdir)/itpp/signal/filter.cpp \
 	$(top_srcdir)/itpp/signal/freq_filt.cpp \
+	$(top_srcdir)/itpp/signal/native_fft.cpp \
 	$(top_srcdir)/itpp/signal/poly.cpp \
 	$(top_srcdir)/itpp/signal/resampling.cpp \
 	$(top_srcdir)/itpp/signal/sigfun.cpp \
@@ -57,9 +57,14 @@ namespace acml
 
 #  include <itpp/fftw3.h>
 
+#else
+
+#  include <itpp/signal/native_fft.h>
+
 #endif
 
 #include <itpp/signal/transforms.h>
+#include <algorithm>
 
 //! \cond
 
@@ -167,6 +172,32 @@ struct IDCT_Traits {
 
 //generic transforms implementation based on transform type and specific FFT library
 template<typename TransformTraits> class Transform;
+
+//batch of complex transforms of n points: point i of transform t is in[t * idist + i * istride]
+//and out[t * odist + i * ostride]
+struct Batch {
+  int n, howmany;
+  const std::complex<double> *in;
+  int istride, idist;
+  std::complex<double> *out;
+  int ostride, odist;
+};
+
+//generic batch implementation: vectors are gathered and transformed one by one with the cached context
+template<typename TransformTraits>
+void compute_batch(Transform<TransformTraits> &t, const Batch &b)
+{
+  cvec x(b.n), y;
+  for(int k = 0; k < b.howmany; ++k) {
+    const std::complex<double> *in = b.in + std::ptrdiff_t(k) * b.idist;
+    for(int i = 0; i < b.n; ++i)
+      x(i) = in[std::ptrdiff_t(i) * b.istride];
+    t.compute_transform(x, y);
+    std::complex<double> *out = b.out + std::ptrdiff_t(k) * b.odist;
+    for(int i = 0; i < b.n; ++i)
+      out[std::ptrdiff_t(i) * b.ostride] = y(i);
+  }
+}
 //FFT library initializer based on mutithreading model
 template<MultithreadingTag> inline void init_fft_library();
 
@@ -516,139 +547,184 @@ Mutex& get_library_lock()
   static Mutex FFTW3LibraryLock;
   return FFTW3LibraryLock;
 }
+
+//number of plans kept by each transform context
+static const int plans_per_context = 8;
+//planning flags, set by set_fft_planning()
+static unsigned planning_flags = FFTW_ESTIMATE;
+
+//Each transform context keeps the plans of the last plans_per_context transform lengths it was used with, so that a thread
+//alternating between a few lengths does not replan. The direction and the real/complex type of the transform are given by the
+//context type. The global library lock is only taken to create and destroy plans. Plans are computed on scratch arrays, so that
+//measured planning does not overwrite the data, and are executed on the IT++ vectors, which are at least as aligned.
+class Plan_Cache
+{
+  struct Entry {
+    int length;
+    fftw_plan plan;
+  };
+  //most recently used plan first
+  Entry _e[plans_per_context];
+  int _n;
+  //disable copy-construction and assignment
+  Plan_Cache(const Plan_Cache&);
+  Plan_Cache& operator=(const Plan_Cache&);
+public:
+  Plan_Cache(): _n(0) {}
+  //plan for the given length, created with create() if it is not in the cache
+  fftw_plan get(int length, fftw_plan(*create)(int)) {
+    int i = 0;
+    while(i < _n && _e[i].length != length) ++i;
+    Entry e;
+    if(i < _n) {
+      e = _e[i];
+    }
+    else {
+      Lock l(get_library_lock()); //apply global library lock on plan changes
+      e.length = length;
+      e.plan = create(length);
+      if(_n == plans_per_context) {
+        //evict the least recently used plan
+        fftw_destroy_plan(_e[--i].plan);
+      }
+      else
+        ++_n;
+    }
+    for(; i > 0; --i)
+      _e[i] = _e[i - 1];
+    _e[0] = e;
+    return e.plan;
+  }
+  //destroy all the plans. Called after main() exits, when the library lock may not exist anymore.
+  void clear() {
+    for(int i = 0; i < _n; ++i)
+      fftw_destroy_plan(_e[i].plan);
+    _n = 0;
+  }
+};
+
+//scratch arrays used to create the plans
+template<typename T> class Scratch
+{
+  T* _p;
+  //disable copy-construction and assignment
+  Scratch(const Scratch&);
+  Scratch& operator=(const Scratch&);
+public:
+  explicit Scratch(int n): _p(static_cast<T*>(fftw_malloc(n * sizeof(T)))) {}
+  ~Scratch() {fftw_free(_p);}
+  T* get() {return _p;}
+};
+
 //---------------------------------------------------------------------------
 // FFT/IFFT based on FFTW
 //---------------------------------------------------------------------------
-inline void destroy_plan(fftw_plan p)
-{
-  if(p != NULL) fftw_destroy_plan(p);  // destroy the plan
-}
-
 template<> class Transform<FFTCplx_Traits>
 {
-  fftw_plan _p;
-  int _transform_length;
+  Plan_Cache _plans;
+  static fftw_plan create_plan(int n) {
+    Scratch<fftw_complex> in(n), out(n);
+    // creation of plan guarantees not to return NULL
+    return fftw_plan_dft_1d(n, in.get(), out.get(), FFTW_FORWARD, planning_flags);
+  }
 public:
-  Transform(): _p(NULL), _transform_length(0) {}
+  Transform() {}
 
   void compute_transform(const cvec &in, cvec &out) {
     out.set_size(in.size(), false);
-    if(_transform_length != in.size()) {
-      Lock l(get_library_lock()); //apply global library lock on plan changes
-
-      _transform_length = in.size();
-      destroy_plan(_p); // destroy the previous plan
-      // create a new plan (creation of plan guarantees not to return NULL)
-      _p = fftw_plan_dft_1d(_transform_length, (fftw_complex *)in._data(),
-                            (fftw_complex *)out._data(),
-                            FFTW_FORWARD, FFTW_ESTIMATE);
-    }
+    fftw_plan p = _plans.get(in.size(), create_plan);
     //compute FFT using the GURU FFTW interface
-    fftw_execute_dft(_p, (fftw_complex *)in._data(),
+    fftw_execute_dft(p, (fftw_complex *)in._data(),
                      (fftw_complex *)out._data());
   }
 
-  void reset() {destroy_plan(_p); *this = Transform();}
+  void reset() {_plans.clear();}
 };
 
 template<> class Transform<IFFTCplx_Traits>
 {
-  fftw_plan _p;
-  int _transform_length;
+  Plan_Cache _plans;
+  static fftw_plan create_plan(int n) {
+    Scratch<fftw_complex> in(n), out(n);
+    // creation of plan guarantees not to return NULL
+    return fftw_plan_dft_1d(n, in.get(), out.get(), FFTW_BACKWARD, planning_flags);
+  }
 public:
-  Transform(): _p(NULL), _transform_length(0) {}
+  Transform() {}
 
   void compute_transform(const cvec &in, cvec &out) {
     out.set_size(in.size(), false);
-    if(_transform_length != in.size()) {
-      Lock l(get_library_lock()); //apply global library lock on plan changes
-
-      _transform_length = in.size();
-      destroy_plan(_p); // destroy the previous plan
-
-      // create a new plan (creation of plan guarantees not to return NULL)
-      _p = fftw_plan_dft_1d(_transform_length, (fftw_complex *)in._data(),
-                            (fftw_complex *)out._data(),
-                            FFTW_BACKWARD, FFTW_ESTIMATE);
-    }
+    fftw_plan p = _plans.get(in.size(), create_plan);
     //compute FFT using the GURU FFTW interface
-    fftw_execute_dft(_p, (fftw_complex *)in._data(),
+    fftw_execute_dft(p, (fftw_complex *)in._data(),
                      (fftw_complex *)out._data());
     // scale output
-    double inv_N = 1.0 / _transform_length;
+    double inv_N = 1.0 / in.size();
     out *= inv_N;
 
   }
 
-  void reset() {destroy_plan(_p); *this = Transform();}
+  void reset() {_plans.clear();}
 };
 
 template<> class Transform<FFTReal_Traits>
 {
-  fftw_plan _p;
-  int _transform_length;
+  Plan_Cache _plans;
+  static fftw_plan create_plan(int n) {
+    Scratch<double> in(n);
+    Scratch<fftw_complex> out(n);
+    // creation of plan guarantees not to return NULL
+    return fftw_plan_dft_r2c_1d(n, in.get(), out.get(), planning_flags);
+  }
 public:
-  Transform(): _p(NULL), _transform_length(0) {}
+  Transform() {}
 
   void compute_transform(const vec &in, cvec &out) {
-    out.set_size(in.size(), false);
-    if(_transform_length != in.size()) {
-      Lock l(get_library_lock()); //apply global library lock on plan changes
-
-      _transform_length = in.size();
-      destroy_plan(_p); // destroy the previous plan
-
-      // create a new plan (creation of plan guarantees not to return NULL)
-      _p = fftw_plan_dft_r2c_1d(_transform_length, (double *)in._data(),
-                                (fftw_complex *)out._data(),
-                                FFTW_ESTIMATE);
-    }
+    int n = in.size();
+    out.set_size(n, false);
+    fftw_plan p = _plans.get(n, create_plan);
     //compute FFT using the GURU FFTW interface
-    fftw_execute_dft_r2c(_p, (double *)in._data(),
+    fftw_execute_dft_r2c(p, (double *)in._data(),
                          (fftw_complex *)out._data());
     // Real FFT does not compute the 2nd half of the FFT points because it
     // is redundant to the 1st half. However, we want all of the data so we
     // fill it in. This is consistent with Matlab's functionality
-    int offset = ceil_i(_transform_length / 2.0);
-    int n_elem = _transform_length - offset;
+    int offset = ceil_i(n / 2.0);
+    int n_elem = n - offset;
     for(int i = 0; i < n_elem; ++i) {
       out(offset + i) = std::conj(out(n_elem - i));
     }
   }
 
-  void reset() {destroy_plan(_p); *this = Transform();}
+  void reset() {_plans.clear();}
 };
 
 template<> class Transform<IFFTReal_Traits>
 {
-  fftw_plan _p;
-  int _transform_length;
+  Plan_Cache _plans;
+  static fftw_plan create_plan(int n) {
+    Scratch<fftw_complex> in(n);
+    Scratch<double> out(n);
+    // creation of plan guarantees not to return NULL
+    return fftw_plan_dft_c2r_1d(n, in.get(), out.get(),
+                                planning_flags | FFTW_PRESERVE_INPUT);
+  }
 public:
-  Transform(): _p(NULL), _transform_length(0) {}
+  Transform() {}
 
   void compute_transform(const cvec &in, vec &out) {
     out.set_size(in.size(), false);
-    if(_transform_length != in.size()) {
-      Lock l(get_library_lock()); //apply global library lock on plan changes
-
-      _transform_length = in.size();
-      destroy_plan(_p); // destroy the previous plan
-
-      // create a new plan (creation of plan guarantees not to return NULL)
-      _p = fftw_plan_dft_c2r_1d(_transform_length, (fftw_complex *)in._data(),
-                                (double *)out._data(),
-                                FFTW_ESTIMATE | FFTW_PRESERVE_INPUT);
-    }
+    fftw_plan p = _plans.get(in.size(), create_plan);
     //compute FFT using the GURU FFTW interface
-    fftw_execute_dft_c2r(_p, (fftw_complex *)in._data(),
+    fftw_execute_dft_c2r(p, (fftw_complex *)in._data(),
                          (double *)out._data());
     // scale output
-    double inv_N = 1.0 / _transform_length;
+    double inv_N = 1.0 / in.size();
     out *= inv_N;
 
   }
 
-  void reset() {destroy_plan(_p); *this = Transform();}
+  void reset() {_plans.clear();}
 };
 
 //---------------------------------------------------------------------------
@@ -656,41 +732,40 @@ public:
 //---------------------------------------------------------------------------
 template<> class Transform<DCT_Traits>
 {
-  fftw_plan _p;
-  int _transform_length;
+  Plan_Cache _plans;
+  static fftw_plan create_plan(int n) {
+    Scratch<double> in(n), out(n);
+    // creation of plan guarantees not to return NULL
+    return fftw_plan_r2r_1d(n, in.get(), out.get(), FFTW_REDFT10, planning_flags);
+  }
 public:
-  Transform(): _p(NULL), _transform_length(0) {}
+  Transform() {}
 
   void compute_transform(const vec &in, vec &out) {
-    out.set_size(in.size(), false);
-    if(_transform_length != in.size()) {
-      Lock l(get_library_lock()); //apply global library lock on plan changes
-
-      _transform_length = in.size();
-      destroy_plan(_p); // destroy the previous plan
-
-      // create a new plan (creation of plan guarantees not to return NULL)
-      _p = fftw_plan_r2r_1d(_transform_length, (double *)in._data(),
-                            (double *)out._data(),
-                            FFTW_REDFT10, FFTW_ESTIMATE);
-    }
+    int n = in.size();
+    out.set_size(n, false);
+    fftw_plan p = _plans.get(n, create_plan);
     // compute FFT using the GURU FFTW interface
-    fftw_execute_r2r(_p, (double *)in._data(), (double *)out._data());
+    fftw_execute_r2r(p, (double *)in._data(), (double *)out._data());
 
     // Scale to matlab definition format
-    out /= std::sqrt(2.0 * _transform_length);
+    out /= std::sqrt(2.0 * n);
     out(0) /= std::sqrt(2.0);
   }
 
-  void reset() {destroy_plan(_p); *this = Transform();}
+  void reset() {_plans.clear();}
 };
 
 template<> class Transform<IDCT_Traits>
 {
-  fftw_plan _p;
-  int _transform_length;
+  Plan_Cache _plans;
+  static fftw_plan create_plan(int n) {
+    Scratch<double> inout(n);
+    // in-place plan; creation of plan guarantees not to return NULL
+    return fftw_plan_r2r_1d(n, inout.get(), inout.get(), FFTW_REDFT01, planning_flags);
+  }
 public:
-  Transform(): _p(NULL), _transform_length(0) {}
+  Transform() {}
 
   void compute_transform(const vec &in, vec &out) {
     out = in;
@@ -699,30 +774,154 @@ public:
     out(0) *= std::sqrt(2.0);
     out /= std::sqrt(2.0 * in.size());
 
-    if(_transform_length != in.size()) {
-      Lock l(get_library_lock()); //apply global library lock on plan changes
+    fftw_plan p = _plans.get(in.size(), create_plan);
+    // compute FFT using the GURU FFTW interface
+    fftw_execute_r2r(p, (double *)out._data(), (double *)out._data());
+  }
 
-      _transform_length = in.size();
-      destroy_plan(_p); // destroy the previous plan
+  void reset() {_plans.clear();}
+};
 
-      // create a new plan (creation of plan guarantees not to return NULL)
-      _p = fftw_plan_r2r_1d(_transform_length, (double *)in._data(),
-                            (double *)out._data(),
-                            FFTW_REDFT01, FFTW_ESTIMATE);
+void set_fft_planning(FFT_Planning effort)
+{
+  Lock l(get_library_lock());
+  planning_flags = (effort == FFT_MEASURE) ? FFTW_MEASURE : FFTW_ESTIMATE;
+}
+
+bool import_fft_wisdom(const std::string &filename)
+{
+  FILE *f = fopen(filename.c_str(), "r");
+  if(f == NULL)
+    return false;
+  int ok;
+  {
+    Lock l(get_library_lock());
+    ok = fftw_import_wisdom_from_file(f);
+  }
+  fclose(f);
+  return ok != 0;
+}
+
+bool export_fft_wisdom(const std::string &filename)
+{
+  FILE *f = fopen(filename.c_str(), "w");
+  if(f == NULL)
+    return false;
+  {
+    Lock l(get_library_lock());
+    fftw_export_wisdom_to_file(f);
+  }
+  return fclose(f) == 0;
+}
+
+#endif // defined(HAVE_FFTW3)
+
+#if !defined(HAVE_FFT_MKL) && !defined(HAVE_FFT_ACML) && !defined(HAVE_FFTW3)
+//implementations based on the built-in FFT
+
+//Built-in FFT notes:
+//Each context owns a native_fft::Context holding its work space. The twiddle factors are shared between all the contexts through
+//the plan cache of native_fft.cpp, which has its own lock taken only when a context changes of transform length, so that no
+//global library lock is needed.
+
+template<> inline void init_fft_library<SingleThreaded>() {} //no actions required.
+template<> inline void init_fft_library<OmpThreaded>() {}
+
+//---------------------------------------------------------------------------
+// FFT/IFFT based on the built-in FFT
+//---------------------------------------------------------------------------
+template<> class Transform<FFTCplx_Traits>
+{
+  native_fft::Context _c;
+public:
+  Transform() {}
+
+  void compute_transform(const cvec &in, cvec &out) {
+    out.set_size(in.size(), false);
+    _c.fft(in.size(), in._data(), out._data(), -1);
+  }
+
+  void compute_batch(const Batch &b) {
+    _c.fft_many(b.n, b.howmany, b.in, b.istride, b.idist, b.out, b.ostride, b.odist, -1);
+  }
+
+  void reset() {_c.reset();}
+};
+
+template<> class Transform<IFFTCplx_Traits>
+{
+  native_fft::Context _c;
+public:
+  Transform() {}
+
+  void compute_transform(const cvec &in, cvec &out) {
+    out.set_size(in.size(), false);
+    _c.fft(in.size(), in._data(), out._data(), 1);
+    // scale output
+    double inv_N = 1.0 / in.size();
+    out *= inv_N;
+  }
+
+  void compute_batch(const Batch &b) {
+    _c.fft_many(b.n, b.howmany, b.in, b.istride, b.idist, b.out, b.ostride, b.odist, 1);
+    // scale output
+    double inv_N = 1.0 / b.n;
+    for(int k = 0; k < b.howmany; ++k) {
+      std::complex<double> *out = b.out + std::ptrdiff_t(k) * b.odist;
+      for(int i = 0; i < b.n; ++i)
+        out[std::ptrdiff_t(i) * b.ostride] *= inv_N;
     }
-    // compute FFT using the GURU FFTW interface
-    fftw_execute_r2r(_p, (double *)out._data(), (double *)out._data());
   }
 
-  void reset() {destroy_plan(_p); *this = Transform();}
+  void reset() {_c.reset();}
 };
 
-#endif // defined(HAVE_FFTW3)
+template<> class Transform<FFTReal_Traits>
+{
+  native_fft::Context _c;
+public:
+  Transform() {}
+
+  void compute_transform(const vec &in, cvec &out) {
+    out.set_size(in.size(), false);
+    _c.fft_real(in.size(), in._data(), out._data());
+  }
 
-#if defined(HAVE_FFT_MKL) || defined(HAVE_FFT_ACML)
+  void reset() {_c.reset();}
+};
+
+template<> class Transform<IFFTReal_Traits>
+{
+  native_fft::Context _c;
+public:
+  Transform() {}
+
+  void compute_transform(const cvec &in, vec &out) {
+    out.set_size(in.size(), false);
+    _c.ifft_real(in.size(), in._data(), out._data());
+    // scale output
+    double inv_N = 1.0 / in.size();
+    out *= inv_N;
+  }
+
+  void reset() {_c.reset();}
+};
+
+//batches of complex transforms are vectorized across the transforms
+inline void compute_batch(Transform<FFTCplx_Traits> &t, const Batch &b) {t.compute_batch(b);}
+inline void compute_batch(Transform<IFFTCplx_Traits> &t, const Batch &b) {t.compute_batch(b);}
+
+#endif // built-in FFT
+
+#if !defined(HAVE_FFTW3)
+
+//planning and wisdom only apply to FFTW
+void set_fft_planning(FFT_Planning) {}
+bool import_fft_wisdom(const std::string &) {return false;}
+bool export_fft_wisdom(const std::string &) {return false;}
 
 //---------------------------------------------------------------------------
-// DCT/IDCT based on MKL or ACML
+// DCT/IDCT based on MKL, ACML or the built-in FFT
 //---------------------------------------------------------------------------
 
 //use FFT on real values to perform DCT
@@ -785,7 +984,6 @@ public:
 
 #endif
 
-#if defined(HAVE_FFT)
 //lock-protected transform to serialize accesses to the context from several threads
 template<typename TransformTraits> class Locked_Transform : private Transform<TransformTraits>
 {
@@ -796,6 +994,7 @@ public:
   //release context
   void release_context() {Lock l(_m); Base::reset();}
   void run_transform(const typename TransformTraits::InType& in, typename TransformTraits::OutType& out) {Lock l(_m); Base::compute_transform(in, out);}
+  void run_batch(const Batch &b) {Lock l(_m); compute_batch(static_cast<Base&>(*this), b);}
 };
 
 //Typical multithreaded application creates several threads upon entry to parallel region and join them upon exit from it.
@@ -841,6 +1040,9 @@ public:
   void run_transform(int id, const typename TransformTraits::InType& in, typename TransformTraits::OutType& out) {
     _transforms[id - 1].run_transform(in, out);
   }
+  void run_batch(int id, const Batch &b) {
+    _transforms[id - 1].run_batch(b);
+  }
   //provider destructor. releases context resources.
   //destructor is called after the main() exits, so there is no need to protect context release with mutex
   ~Transform_Provider() {
@@ -964,44 +1166,212 @@ void idct(const vec &in, vec &out)
   get_transform_provider<IDCT_Traits>().run_transform(context_id, in, out);
 }
 
-bool have_fourier_transforms() {return true;}
-bool have_cosine_transforms() {return true;}
-#else
+//batches smaller than this number of points per thread are not split between threads
+static const int batch_points_per_thread = 1 << 14;
 
-void fft(const cvec &in, cvec &out)
+static void fft_batch_chunk(const Batch &b)
 {
-  it_error("FFT library is needed to use fft() function");
+  static int context_id = 0;
+  #pragma omp threadprivate(context_id)
+
+  if(context_id == 0) {
+    //first-time transform call
+    #pragma omp critical
+    {
+      //serialize access to  transform provider to get the id
+      context_id = get_transform_provider<FFTCplx_Traits>().get_context_id();
+    }
+  }
+  get_transform_provider<FFTCplx_Traits>().run_batch(context_id, b);
 }
 
-void ifft(const cvec &in, cvec &out)
+static void ifft_batch_chunk(const Batch &b)
+{
+  static int context_id = 0;
+  #pragma omp threadprivate(context_id)
+
+  if(context_id == 0) {
+    //first-time transform call
+    #pragma omp critical
+    {
+      //serialize access to  transform provider to get the id
+      context_id = get_transform_provider<IFFTCplx_Traits>().get_context_id();
+    }
+  }
+  get_transform_provider<IFFTCplx_Traits>().run_batch(context_id, b);
+}
+
+//runs the batch, split in contiguous chunks of transforms between the threads of a new parallel
+//region unless the caller is already running in one
+static void run_batch(const Batch &b, bool inverse)
 {
-  it_error("FFT library is needed to use ifft() function");
+  int threads = 1;
+#ifdef _OPENMP
+  if(!omp_in_parallel())
+    threads = std::min(omp_get_max_threads(),
+                       int(double(b.n) * b.howmany / batch_points_per_thread));
+  threads = std::max(1, std::min(threads, b.howmany));
+#endif
+  #pragma omp parallel for num_threads(threads)
+  for(int t = 0; t < threads; ++t) {
+    int first = int(double(b.howmany) * t / threads);
+    int last = int(double(b.howmany) * (t + 1) / threads);
+    Batch c = b;
+    c.howmany = last - first;
+    c.in += std::ptrdiff_t(first) * b.idist;
+    c.out += std::ptrdiff_t(first) * b.odist;
+    if(inverse)
+      ifft_batch_chunk(c);
+    else
+      fft_batch_chunk(c);
+  }
 }
 
-void fft_real(const vec &in, cvec &out)
+//the columns (dim = 1) or rows (dim = 2) of a rows x cols matrix: point i of vector t is at
+//t * dist + i * stride
+static void matrix_layout(int rows, int cols, int dim, int &n, int &howmany, int &stride, int &dist)
 {
-  it_error("FFT library is needed to use fft_real() function");
+  if(dim == 1) {
+    n = rows;
+    howmany = cols;
+    stride = 1;
+    dist = rows;
+  }
+  else {
+    n = cols;
+    howmany = rows;
+    stride = rows;
+    dist = 1;
+  }
 }
 
-void ifft_real(const cvec &in, vec & out)
+static Batch matrix_batch(int rows, int cols, int dim, const std::complex<double> *in,
+                          std::complex<double> *out)
 {
-  it_error("FFT library is needed to use ifft_real() function");
+  Batch b;
+  matrix_layout(rows, cols, dim, b.n, b.howmany, b.istride, b.idist);
+  b.ostride = b.istride;
+  b.odist = b.idist;
+  b.in = in;
+  b.out = out;
+  return b;
 }
 
-void dct(const vec &in, vec &out)
+//transforms of the real vectors x_t(i) = x[t * xdist + i * xstride] * w[i] (w being optional),
+//two at a time: Z = fft(x_2u + i x_2u+1) gives X_2u(k) = (Z(k) + conj(Z(n - k))) / 2 and
+//X_2u+1(k) = (Z(k) - conj(Z(n - k))) / 2i. The bins 0 to nbins - 1 of X_t are stored at
+//X[t * Xdist + k * Xstride]
+static void fft_real_many(int n, int howmany, const double *x, int xstride, int xdist,
+                          const double *w, int nbins, std::complex<double> *X,
+                          int Xstride, int Xdist)
 {
-  it_error("FFT library is needed to use dct() function");
+  int pairs = (howmany + 1) / 2;
+  cmat z(n, pairs);
+  for(int u = 0; u < pairs; ++u) {
+    const double *x0 = x + std::ptrdiff_t(2 * u) * xdist;
+    const double *x1 = x0 + xdist;
+    bool odd = (2 * u + 1 < howmany);
+    for(int i = 0; i < n; ++i) {
+      double a = x0[std::ptrdiff_t(i) * xstride];
+      double b = odd ? x1[std::ptrdiff_t(i) * xstride] : 0.0;
+      if(w) {
+        a *= w[i];
+        b *= w[i];
+      }
+      z(i, u) = std::complex<double>(a, b);
+    }
+  }
+  run_batch(matrix_batch(n, pairs, 1, z._data(), z._data()), false);
+  for(int u = 0; u < pairs; ++u) {
+    std::complex<double> *X0 = X + std::ptrdiff_t(2 * u) * Xdist;
+    std::complex<double> *X1 = X0 + Xdist;
+    bool odd = (2 * u + 1 < howmany);
+    for(int k = 0; k < nbins; ++k) {
+      std::complex<double> a = z(k, u), c = std::conj(z(k == 0 ? 0 : n - k, u));
+      X0[std::ptrdiff_t(k) * Xstride] = 0.5 * (a + c);
+      if(odd)
+        X1[std::ptrdiff_t(k) * Xstride] = std::complex<double>(0.0, -0.5) * (a - c);
+    }
+  }
 }
 
-void idct(const vec &in, vec &out)
+void fft_batch(const cmat &in, cmat &out, int dim)
 {
-  it_error("FFT library is needed to use idct() function");
+  it_assert((dim == 1) || (dim == 2), "fft_batch(): dimension need to be 1 or 2");
+  it_assert(in.size() > 0, "fft_batch(): zero-sized input detected");
+  out.set_size(in.rows(), in.cols(), false);
+  run_batch(matrix_batch(in.rows(), in.cols(), dim, in._data(), out._data()), false);
 }
 
-bool have_fourier_transforms() {return false;}
-bool have_cosine_transforms() {return false;}
+void ifft_batch(const cmat &in, cmat &out, int dim)
+{
+  it_assert((dim == 1) || (dim == 2), "ifft_batch(): dimension need to be 1 or 2");
+  it_assert(in.size() > 0, "ifft_batch(): zero-sized input detected");
+  out.set_size(in.rows(), in.cols(), false);
+  run_batch(matrix_batch(in.rows(), in.cols(), dim, in._data(), out._data()), true);
+}
 
-#endif // defined(HAVE_FFT)
+void fft_real_batch(const mat &in, cmat &out, int dim)
+{
+  it_assert((dim == 1) || (dim == 2), "fft_real_batch(): dimension need to be 1 or 2");
+  it_assert(in.size() > 0, "fft_real_batch(): zero-sized input detected");
+  int n, howmany, stride, dist;
+  matrix_layout(in.rows(), in.cols(), dim, n, howmany, stride, dist);
+  out.set_size(in.rows(), in.cols(), false);
+  fft_real_many(n, howmany, in._data(), stride, dist, 0, n, out._data(), stride, dist);
+}
+
+//inverse of pairs of Hermitian spectra: Z = X_2u + i X_2u+1 is built from the bins 0 to n / 2,
+//x_2u and x_2u+1 being the real and imaginary parts of ifft(Z)
+void ifft_real_batch(const cmat &in, mat &out, int dim)
+{
+  it_assert((dim == 1) || (dim == 2), "ifft_real_batch(): dimension need to be 1 or 2");
+  it_assert(in.size() > 0, "ifft_real_batch(): zero-sized input detected");
+  int n, howmany, stride, dist;
+  matrix_layout(in.rows(), in.cols(), dim, n, howmany, stride, dist);
+  int pairs = (howmany + 1) / 2;
+  const std::complex<double> i1(0.0, 1.0);
+  cmat z(n, pairs);
+  for(int u = 0; u < pairs; ++u) {
+    const std::complex<double> *X0 = in._data() + std::ptrdiff_t(2 * u) * dist;
+    const std::complex<double> *X1 = X0 + dist;
+    bool odd = (2 * u + 1 < howmany);
+    for(int k = 0; k <= n / 2; ++k) {
+      std::complex<double> a = X0[std::ptrdiff_t(k) * stride];
+      std::complex<double> b = odd ? X1[std::ptrdiff_t(k) * stride] : std::complex<double>(0.0);
+      z(k, u) = a + i1 * b;
+      if((k > 0) && (2 * k != n))
+        z(n - k, u) = std::conj(a) + i1 * std::conj(b);
+    }
+  }
+  run_batch(matrix_batch(n, pairs, 1, z._data(), z._data()), true);
+  out.set_size(in.rows(), in.cols(), false);
+  for(int u = 0; u < pairs; ++u) {
+    double *x0 = out._data() + std::ptrdiff_t(2 * u) * dist;
+    double *x1 = x0 + dist;
+    bool odd = (2 * u + 1 < howmany);
+    for(int i = 0; i < n; ++i) {
+      x0[std::ptrdiff_t(i) * stride] = z(i, u).real();
+      if(odd)
+        x1[std::ptrdiff_t(i) * stride] = z(i, u).imag();
+    }
+  }
+}
+
+cmat stft(const vec &x, const vec &window, int hop)
+{
+  int nfft = window.size();
+  it_assert(nfft > 0, "stft(): zero-sized window detected");
+  it_assert(hop > 0, "stft(): hop size need to be positive");
+  it_assert(x.size() >= nfft, "stft(): signal shorter than the window");
+  int frames = (x.size() - nfft) / hop + 1, nbins = nfft / 2 + 1;
+  cmat out(nbins, frames);
+  fft_real_many(nfft, frames, x._data(), 1, hop, window._data(), nbins, out._data(), 1, nbins);
+  return out;
+}
+
+bool have_fourier_transforms() {return true;}
+bool have_cosine_transforms() {return true;}
 
 
 cvec fft(const cvec &in)
@@ -1068,6 +1438,34 @@ vec ifft_real(const cvec &in, const int N)
   return out;
 }
 
+cmat fft_batch(const cmat &in, int dim)
+{
+  cmat out;
+  fft_batch(in, out, dim);
+  return out;
+}
+
+cmat ifft_batch(const cmat &in, int dim)
+{
+  cmat out;
+  ifft_batch(in, out, dim);
+  return out;
+}
+
+cmat fft_real_batch(const mat &in, int dim)
+{
+  cmat out;
+  fft_real_batch(in, out, dim);
+  return out;
+}
+
+mat ifft_real_batch(const cmat &in, int dim)
+{
+  mat out;
+  ifft_real_batch(in, out, dim);
+  return out;
+}
+
 vec dct(const vec &in)
 {
   vec out;
@@ -34,6 +34,7 @@
 #include <itpp/base/mat.h>
 #include <itpp/base/matfunc.h>
 #include <itpp/itexports.h>
+#include <string>
 
 
 namespace itpp
@@ -62,11 +63,19 @@ namespace itpp
   - MKL (version 8.0.0 or higher)
   - ACML (version 2.5.3 or higher).
 
+  Without any of them, a built-in mixed-radix FFT is used. It handles
+  lengths whose prime factors are at most 31 directly and other lengths
+  with Bluestein's algorithm. Its twiddle factors are computed on the
+  first call with a given length and shared by all threads.
+
   \note FFTW-based implementation is the fastest for powers of two.
   Furthermore, the second time you call the routine with the same size,
   the calculation is much faster due to many things were calculated and
   stored the first time the routine was called.
 
+  Each thread keeps the FFTW plans of the last few lengths it transformed,
+  so that alternating between several lengths does not recompute them.
+
   \note Achieving maximum runtime efficiency with the FFTW library on some
   computer architectures requires that data are stored in the memory with
   a special alignment (to 16-byte boundaries). The IT++ memory management
@@ -142,6 +151,79 @@ Underlying implementation assumes Hermitian symmetry of the input subvector/padd
 unpredictable and depending on the implementation (MKL/ACML/FFTW) if this requirement is not  met.
 */
 ITPP_EXPORT vec ifft_real(const cvec &in, const int N);
+
+/*!
+\brief Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+
+All the transforms share the plan of their length. Large batches are split
+between the OpenMP threads, unless the caller already runs in a parallel
+region. \a in and \a out may be the same matrix.
+*/
+ITPP_EXPORT void fft_batch(const cmat &in, cmat &out, int dim = 1);
+//! Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+ITPP_EXPORT cmat fft_batch(const cmat &in, int dim = 1);
+//! Inverse Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+ITPP_EXPORT void ifft_batch(const cmat &in, cmat &out, int dim = 1);
+//! Inverse Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+ITPP_EXPORT cmat ifft_batch(const cmat &in, int dim = 1);
+/*!
+\brief Real Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+
+The full spectra are returned, as with fft_real(). Two real vectors are
+transformed with each complex transform.
+*/
+ITPP_EXPORT void fft_real_batch(const mat &in, cmat &out, int dim = 1);
+//! Real Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+ITPP_EXPORT cmat fft_real_batch(const mat &in, int dim = 1);
+/*!
+\brief Inverse Real Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+
+Only the points 0 to N/2 of each spectrum are read, the others being
+assumed Hermitian symmetric.
+*/
+ITPP_EXPORT void ifft_real_batch(const cmat &in, mat &out, int dim = 1);
+//! Inverse Real Fast Fourier Transforms of the columns (dim = 1) or rows (dim = 2) of a matrix
+ITPP_EXPORT mat ifft_real_batch(const cmat &in, int dim = 1);
+
+/*!
+\brief Short-time Fourier transform of a real signal
+
+Column \c t of the result holds the points 0 to N/2 of the transform of
+\code elem_mult(x(t * hop, t * hop + N - 1), window) \endcode
+where N is the length of the window. There are (length(x) - N) / hop + 1
+frames, the signal being at least as long as the window.
+*/
+ITPP_EXPORT cmat stft(const vec &x, const vec &window, int hop);
+
+//! Effort spent by the FFT library on the plan of a new transform length
+enum FFT_Planning {
+  FFT_ESTIMATE, //!< Heuristic plans, quick to compute (default)
+  FFT_MEASURE   //!< Plans chosen by timing several algorithms, much slower to compute
+};
+
+/*!
+\brief Set the planning effort of the transforms of new lengths
+
+Only FFTW plans transforms; with the other libraries this function has no
+effect. Plans already computed are kept. Measured plans are best saved with
+export_fft_wisdom() and loaded with import_fft_wisdom() at startup, so that
+later runs skip the measurements.
+*/
+ITPP_EXPORT void set_fft_planning(FFT_Planning effort);
+/*!
+\brief Load FFTW wisdom from a file
+
+Returns false if the file cannot be read or if the library is not built
+with FFTW.
+*/
+ITPP_EXPORT bool import_fft_wisdom(const std::string &filename);
+/*!
+\brief Save the FFTW wisdom accumulated by the planned transforms to a file
+
+Returns false if the file cannot be written or if the library is not built
+with FFTW.
+*/
+ITPP_EXPORT bool export_fft_wisdom(const std::string &filename);
 //!@}
 
 
@@ -168,6 +250,8 @@ ITPP_EXPORT vec ifft_real(const cvec &in, const int N);
   - MKL (version 10.0.0 or higher)
   - ACML (version 4.4.0 or higher).
 
+  Without any of them, the transforms use the built-in FFT (see \ref fft).
+
   \note FFTW-based implementation is the fastest for powers of two.
   Furthermore, the second time you call the routine with the same size,
   the calculation is much faster due to many things were calculated and